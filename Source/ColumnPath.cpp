@@ -0,0 +1,59 @@
+#include "ColumnPath.h"
+
+ColumnPath::ColumnPath(float minFrequency, float maxFrequency, float smoothingOctaves, bool usePeakHold, bool keepHistory)
+{
+    layout.minFrequency = minFrequency;
+    layout.maxFrequency = maxFrequency;
+    layout.smoothingOctaves = smoothingOctaves;
+    layout.usePeakHold = usePeakHold;
+    layout.keepHistory = keepHistory;
+}
+
+void ColumnPath::update(SpectrumAnalyzer::Subscription& subscription, int numColumns)
+{
+    layout.numColumns = numColumns;
+    
+    if (subscription.isActive())
+        subscription.setColumnLayout(layout);
+}
+
+const SpectrumAnalyzer::SpectrumColumns* ColumnPath::findColumns(const SpectrumAnalyzer::Subscription& subscription,
+                                                                 const SpectrumAnalyzer::SpectrumFrame& frame) const
+{
+    // Frames published before the latest resize carry the old layout - callers fall back to the full spectrum
+    const int slot = subscription.getColumnSlot();
+    if (slot < 0)
+        return nullptr;
+    
+    const auto& columns = frame.columns[static_cast<size_t>(slot)];
+    if (columns.layout != layout || columns.inputMax.empty())
+        return nullptr;
+    
+    return &columns;
+}
+
+juce::Path ColumnPath::createPath(const std::vector<float>& columnValues, juce::Rectangle<float> area, float minDB, float maxDB)
+{
+    juce::Path path;
+    
+    if (columnValues.empty())
+        return path;
+    
+    // Columns are already log-spaced across the width, so x is just the column centre
+    const float columnWidth = area.getWidth() / static_cast<float>(columnValues.size());
+    const float yScale = area.getHeight() / (maxDB - minDB);
+    
+    path.preallocateSpace(static_cast<int>(columnValues.size()) * 3);
+    for (size_t column = 0; column < columnValues.size(); ++column)
+    {
+        const float x = area.getX() + (static_cast<float>(column) + 0.5f) * columnWidth;
+        const float y = area.getBottom() - (juce::jlimit(minDB, maxDB, columnValues[column]) - minDB) * yScale;
+        
+        if (column == 0)
+            path.startNewSubPath(x, y);
+        else
+            path.lineTo(x, y);
+    }
+    
+    return path;
+}
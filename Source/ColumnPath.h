@@ -0,0 +1,30 @@
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+#include "SpectrumAnalyzer.h"
+
+/**
+    Pixel-column spectrum shared by the displays. Holds the ColumnLayout a display asks the analysis worker
+    for, finds that reduction in a published frame and turns a row of column values into a path
+*/
+class ColumnPath
+{
+public:
+    ColumnPath(float minFrequency, float maxFrequency, float smoothingOctaves = 0.0f,
+               bool usePeakHold = true, bool keepHistory = false);
+    
+    /** Sets the column count (usually the width in pixels) and passes the layout on while subscribed */
+    void update(SpectrumAnalyzer::Subscription& subscription, int numColumns);
+    
+    const SpectrumAnalyzer::ColumnLayout& getLayout() const noexcept { return layout; }
+    
+    /** The frame's reduction for this layout, or nullptr if it was published before the latest resize */
+    const SpectrumAnalyzer::SpectrumColumns* findColumns(const SpectrumAnalyzer::Subscription& subscription,
+                                                         const SpectrumAnalyzer::SpectrumFrame& frame) const;
+    
+    /** One point per column across area, magnitudes clamped to [minDB, maxDB] from the bottom to the top */
+    static juce::Path createPath(const std::vector<float>& columnValues, juce::Rectangle<float> area, float minDB, float maxDB);
+    
+private:
+    SpectrumAnalyzer::ColumnLayout layout;
+};
@@ -0,0 +1,122 @@
+#include "BiquadResponse.h"
+#include "EQBand.h"
+#include <cmath>
+
+namespace DynamicEQ {
+
+BiquadCoefficients BiquadCoefficients::forFilter(FilterType type, float frequency, float gainDB, float q, double sampleRate)
+{
+    const double nyquistLimit = 0.49 * sampleRate;
+    const double cutoff = juce::jlimit(1.0, nyquistLimit, static_cast<double>(frequency));
+    const double A = std::pow(10.0, static_cast<double>(gainDB) / 40.0);
+    double g = std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+    double k = 1.0 / juce::jmax(0.01, static_cast<double>(q));
+
+    // Analog prototype H(s) = (n2 s^2 + n1 s + n0) / (s^2 + k s + 1), as in Simper's SVF mixing
+    double n2 = 1.0, n1 = k, n0 = 1.0;
+
+    switch (type)
+    {
+        case FilterType::Bell:
+            k = 1.0 / (juce::jmax(0.01, static_cast<double>(q)) * A);
+            n1 = k * A * A;
+            break;
+
+        case FilterType::LowShelf:
+            g /= std::sqrt(A);
+            n2 = 1.0; n1 = k * A; n0 = A * A;
+            break;
+
+        case FilterType::HighShelf:
+            g *= std::sqrt(A);
+            n2 = A * A; n1 = k * A; n0 = 1.0;
+            break;
+
+        case FilterType::HighPass:
+            k = juce::MathConstants<double>::sqrt2; // Butterworth Q
+            n2 = 1.0; n1 = 0.0; n0 = 0.0;
+            break;
+
+        case FilterType::LowPass:
+            k = juce::MathConstants<double>::sqrt2;
+            n2 = 0.0; n1 = 0.0; n0 = 1.0;
+            break;
+    }
+
+    // Bilinear transform with s = (1/g)(1 - z^-1)/(1 + z^-1)
+    const double g2 = g * g;
+
+    BiquadCoefficients result;
+    result.b0 = static_cast<float>(n2 + n1 * g + n0 * g2);
+    result.b1 = static_cast<float>(2.0 * (n0 * g2 - n2));
+    result.b2 = static_cast<float>(n2 - n1 * g + n0 * g2);
+    result.a0 = static_cast<float>(1.0 + k * g + g2);
+    result.a1 = static_cast<float>(2.0 * (g2 - 1.0));
+    result.a2 = static_cast<float>(1.0 - k * g + g2);
+    return result;
+}
+
+float BiquadCoefficients::getMagnitudeDB(float frequency, double sampleRate) const noexcept
+{
+    const double halfOmegaSine = std::sin(juce::MathConstants<double>::pi * frequency / sampleRate);
+    const double phi = halfOmegaSine * halfOmegaSine;
+
+    const double bSum = static_cast<double>(b0) + b1 + b2;
+    const double aSum = static_cast<double>(a0) + a1 + a2;
+    const double numerator = bSum * bSum - 4.0 * (b0 * b1 + 4.0 * b0 * b2 + b1 * b2) * phi + 16.0 * b0 * b2 * phi * phi;
+    const double denominator = aSum * aSum - 4.0 * (a0 * a1 + 4.0 * a0 * a2 + a1 * a2) * phi + 16.0 * a0 * a2 * phi * phi;
+
+    return static_cast<float>(10.0 * std::log10(juce::jmax(1.0e-12, numerator / denominator)));
+}
+
+void BiquadResponseGrid::prepare(int numPoints, float minFrequency, float maxFrequency, double sampleRate)
+{
+    phiTable.resize(static_cast<size_t>(juce::jmax(2, numPoints)));
+    gridMinFrequency = minFrequency;
+    gridMaxFrequency = maxFrequency;
+    currentSampleRate = sampleRate;
+
+    const double lastIndex = static_cast<double>(phiTable.size() - 1);
+    for (size_t i = 0; i < phiTable.size(); ++i)
+    {
+        const double frequency = minFrequency * std::pow(static_cast<double>(maxFrequency / minFrequency), static_cast<double>(i) / lastIndex);
+        const double halfOmegaSine = std::sin(juce::MathConstants<double>::pi * frequency / sampleRate);
+        phiTable[i] = static_cast<float>(halfOmegaSine * halfOmegaSine);
+    }
+}
+
+bool BiquadResponseGrid::matches(int numPoints, float minFrequency, float maxFrequency, double sampleRate) const noexcept
+{
+    return getNumPoints() == numPoints && gridMinFrequency == minFrequency
+        && gridMaxFrequency == maxFrequency && currentSampleRate == sampleRate;
+}
+
+void BiquadResponseGrid::evaluate(const BiquadCoefficients& c, float* magnitudeDB) const noexcept
+{
+    // |B(e^jw)|^2 = p0 + p1 phi + p2 phi^2 with phi = sin^2(w/2), and the same for A.
+    // The phi form keeps its precision at low frequencies, where the cos(w) form cancels out in float
+    const float bSum = c.b0 + c.b1 + c.b2;
+    const float aSum = c.a0 + c.a1 + c.a2;
+    const float numerator0 = bSum * bSum;
+    const float numerator1 = -4.0f * (c.b0 * c.b1 + 4.0f * c.b0 * c.b2 + c.b1 * c.b2);
+    const float numerator2 = 16.0f * c.b0 * c.b2;
+    const float denominator0 = aSum * aSum;
+    const float denominator1 = -4.0f * (c.a0 * c.a1 + 4.0f * c.a0 * c.a2 + c.a1 * c.a2);
+    const float denominator2 = 16.0f * c.a0 * c.a2;
+
+    const float* phi = phiTable.data();
+    const int numPoints = getNumPoints();
+
+    // Power ratio first - plain multiply-adds with no branches
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const float numerator = numerator0 + phi[i] * (numerator1 + phi[i] * numerator2);
+        const float denominator = denominator0 + phi[i] * (denominator1 + phi[i] * denominator2);
+        magnitudeDB[i] = numerator / denominator;
+    }
+
+    for (int i = 0; i < numPoints; ++i)
+        magnitudeDB[i] = 10.0f * std::log10(juce::jmax(MIN_POWER_RATIO, magnitudeDB[i]));
+}
+
+} // namespace DynamicEQ
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace DynamicEQ {
+
+enum class FilterType; // EQBand.h
+
+/**
+ * Digital biquad equivalent of one EQ band's SVF
+ * The chowdsp SVFs are TPT (bilinear, prewarped) filters, so their response is exactly this biquad's
+ */
+struct BiquadCoefficients
+{
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+    float a0 = 1.0f, a1 = 0.0f, a2 = 0.0f;
+
+    // Mirrors EQBand's filter setup - high/low pass use the same fixed Butterworth Q
+    static BiquadCoefficients forFilter(FilterType type, float frequency, float gainDB, float q, double sampleRate);
+
+    // Magnitude in dB at a single frequency
+    float getMagnitudeDB(float frequency, double sampleRate) const noexcept;
+};
+
+/**
+ * Log-spaced frequency grid with a precomputed sin^2(w/2) table
+ * |H(e^jw)|^2 of a biquad is a ratio of quadratics in that term, so evaluating a band over the
+ * whole grid is a branch-free multiply-add loop the compiler vectorizes
+ */
+class BiquadResponseGrid
+{
+public:
+    void prepare(int numPoints, float minFrequency, float maxFrequency, double sampleRate);
+
+    int getNumPoints() const noexcept { return static_cast<int>(phiTable.size()); }
+    double getSampleRate() const noexcept { return currentSampleRate; }
+    bool matches(int numPoints, float minFrequency, float maxFrequency, double sampleRate) const noexcept;
+
+    // Writes the band's magnitude in dB at every grid point
+    void evaluate(const BiquadCoefficients& coefficients, float* magnitudeDB) const noexcept;
+
+private:
+    std::vector<float> phiTable; // sin^2(w/2) per grid point
+    float gridMinFrequency = 0.0f;
+    float gridMaxFrequency = 0.0f;
+    double currentSampleRate = 0.0;
+
+    static constexpr float MIN_POWER_RATIO = 1.0e-12f; // -120 dB floor
+};
+
+} // namespace DynamicEQ
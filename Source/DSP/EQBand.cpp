@@ -36,6 +36,7 @@ void EQBand::setupDynamics(const juce::String& thresholdID, const juce::String&
 void EQBand::prepare(double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
+    responseNeedsUpdate = true;
     
     // Create ProcessSpec for chowdsp filters
     juce::dsp::ProcessSpec spec;
@@ -51,11 +52,7 @@ void EQBand::prepare(double sampleRate, int samplesPerBlock)
     lowPassFilter.prepare(spec);
     
     // Reset all internal states
-    bellFilter.reset();
-    highShelfFilter.reset();
-    lowShelfFilter.reset();
-    highPassFilter.reset();
-    lowPassFilter.reset();
+    reset();
     
     // Prepare dynamics processing if enabled
     if (dynamicsEnabled)
@@ -66,13 +63,18 @@ void EQBand::prepare(double sampleRate, int samplesPerBlock)
         compressorSpec.numChannels = 2;
         
         compressor.prepare(compressorSpec);
-        
-        // Prepare temporary buffers for dynamics processing
-        compressorBuffer.setSize(2, samplesPerBlock);
-        keyInputBuffer.setSize(2, samplesPerBlock);
     }
 }
 
+void EQBand::reset()
+{
+    bellFilter.reset();
+    highShelfFilter.reset();
+    lowShelfFilter.reset();
+    highPassFilter.reset();
+    lowPassFilter.reset();
+}
+
 void EQBand::updateParameters()
 {
     if (manager == nullptr || !paramIndices.isValid()) 
@@ -95,6 +97,9 @@ void EQBand::updateParameters()
     q = juce::jlimit(0.1f, 10.0f, q);
     filterTypeInt = juce::jlimit(0, 4, filterTypeInt);
     
+    const bool filterChanged = responseNeedsUpdate || frequency != lastFrequency || gainDb != lastGainDb
+                            || q != lastQ || static_cast<FilterType>(filterTypeInt) != lastFilterType;
+    
     // Store for external access
     lastFrequency = frequency;
     lastGainDb = gainDb;
@@ -104,6 +109,15 @@ void EQBand::updateParameters()
     // Update filter parameters (clean and maintainable!)
     updateFilterParameters(frequency, gainDb, q, lastFilterType);
     
+    // The display draws exactly this biquad, so only recompute it when the filter actually moved
+    if (filterChanged)
+    {
+        currentResponse.coefficients = BiquadCoefficients::forFilter(lastFilterType, frequency, gainDb, q, currentSampleRate);
+        currentResponse.sampleRate = currentSampleRate;
+        responseNeedsUpdate = false;
+        publishResponse();
+    }
+    
     // Update dynamics parameters if enabled
     if (dynamicsEnabled)
     {
@@ -111,6 +125,20 @@ void EQBand::updateParameters()
     }
 }
 
+void EQBand::setActive(bool shouldBeActive) noexcept
+{
+    if (currentResponse.active == shouldBeActive)
+        return;
+    
+    currentResponse.active = shouldBeActive;
+    publishResponse();
+}
+
+void EQBand::publishResponse() noexcept
+{
+    publishedResponse.store(currentResponse);
+}
+
 void EQBand::processBuffer(juce::AudioBuffer<float>& buffer)
 {
     // Get channel pointers
@@ -371,32 +399,13 @@ void EQBand::processDynamicsBlock(juce::AudioBuffer<float>& buffer)
     if (!dynamicsEnabled || lastDynamicsBypass)
         return;
     
-    const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
-    
-    // Resize temporary buffers if needed
-    compressorBuffer.setSize(numChannels, numSamples, false, false, true);
-    keyInputBuffer.setSize(numChannels, numSamples, false, false, true);
-    
-    // Copy EQ-processed audio to compressor buffers
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        compressorBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
-        keyInputBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples); // Use same signal for key input (no sidechain)
-    }
-    
-    // Process through chowdsp compressor
-    chowdsp::BufferView<float> mainBufferView(compressorBuffer);
-    chowdsp::BufferView<const float> keyInputView(keyInputBuffer);
+    // The level detector and gain computer consume the whole key block before any gain
+    // is applied, so the EQ output can be compressed in place and double as its own key
+    chowdsp::BufferView<float> mainBufferView(buffer);
+    chowdsp::BufferView<const float> keyInputView(buffer);
     
     compressor.processBlock(mainBufferView, keyInputView);
     
-    // Copy processed audio back to original buffer
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        buffer.copyFrom(ch, 0, compressorBuffer, ch, 0, numSamples);
-    }
-    
     // Store gain reduction for metering (simplified - would need access to chowdsp internals for exact GR)
     // For now, we'll estimate based on level difference
     lastGainReduction = 0.0f; // TODO: Extract actual gain reduction from chowdsp compressor
@@ -407,55 +416,54 @@ void EQBand::processDynamicsBlockWithSidechain(juce::AudioBuffer<float>& buffer,
     if (!dynamicsEnabled || lastDynamicsBypass)
         return;
     
+    if (sidechainBuffer == nullptr || sidechainBuffer->getNumChannels() == 0)
+    {
+        // No sidechain - use main signal for key input
+        processDynamicsBlock(buffer);
+        return;
+    }
+    
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
+    const int sidechainChannels = juce::jmin(sidechainBuffer->getNumChannels(), numChannels);
     
-    // Resize temporary buffers if needed
-    compressorBuffer.setSize(numChannels, numSamples, false, false, true);
-    keyInputBuffer.setSize(numChannels, numSamples, false, false, true);
+    chowdsp::BufferView<float> mainBufferView(buffer);
     
-    // Copy EQ-processed audio to compressor buffers
-    for (int ch = 0; ch < numChannels; ++ch)
+    if (sidechainChannels == numChannels && sidechainBuffer->getNumSamples() >= numSamples)
     {
-        compressorBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        // Matching layout - key directly from the host's sidechain bus
+        chowdsp::BufferView<const float> keyInputView(sidechainBuffer->getArrayOfReadPointers(), numChannels, numSamples);
+        compressor.processBlock(mainBufferView, keyInputView);
     }
-    
-    // Use sidechain for key input if available, otherwise use main signal
-    if (sidechainBuffer != nullptr && sidechainBuffer->getNumChannels() > 0)
+    else
     {
-        // Use sidechain input for key signal
-        const int sidechainChannels = juce::jmin(sidechainBuffer->getNumChannels(), numChannels);
-        for (int ch = 0; ch < sidechainChannels; ++ch)
+        // Sidechain has fewer channels or samples - build the key in scratch memory
+        if (scratchArena == nullptr)
+        {
+            processDynamicsBlock(buffer);
+            return;
+        }
+        
+        ScratchArena::ScopedFrame scratchFrame(*scratchArena);
+        juce::AudioBuffer<float> keyInputBuffer;
+        if (!scratchArena->borrowBuffer(keyInputBuffer, numChannels, numSamples))
         {
-            keyInputBuffer.copyFrom(ch, 0, *sidechainBuffer, ch, 0, 
-                                   juce::jmin(numSamples, sidechainBuffer->getNumSamples()));
+            jassertfalse; // Arena was sized for a smaller block than the host delivered
+            processDynamicsBlock(buffer);
+            return;
         }
         
+        keyInputBuffer.clear();
+        const int sidechainSamples = juce::jmin(numSamples, sidechainBuffer->getNumSamples());
+        for (int ch = 0; ch < sidechainChannels; ++ch)
+            keyInputBuffer.copyFrom(ch, 0, *sidechainBuffer, ch, 0, sidechainSamples);
+        
         // If sidechain has fewer channels, duplicate the last channel
         for (int ch = sidechainChannels; ch < numChannels; ++ch)
-        {
             keyInputBuffer.copyFrom(ch, 0, keyInputBuffer, sidechainChannels - 1, 0, numSamples);
-        }
-    }
-    else
-    {
-        // No sidechain - use main signal for key input
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            keyInputBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
-        }
-    }
-    
-    // Process through chowdsp compressor
-    chowdsp::BufferView<float> mainBufferView(compressorBuffer);
-    chowdsp::BufferView<const float> keyInputView(keyInputBuffer);
-    
-    compressor.processBlock(mainBufferView, keyInputView);
-    
-    // Copy processed audio back to original buffer
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        buffer.copyFrom(ch, 0, compressorBuffer, ch, 0, numSamples);
+        
+        chowdsp::BufferView<const float> keyInputView(keyInputBuffer);
+        compressor.processBlock(mainBufferView, keyInputView);
     }
     
     // Store gain reduction for metering
@@ -472,8 +480,44 @@ void MultiBandEQ::setNumBands(int numBands)
     {
         auto band = std::make_unique<EQBand>();
         band->setBandIndex(i);
+        band->setScratchArena(scratchArena);
         bands.push_back(std::move(band));
     }
+    
+    cacheBandStateParameters();
+}
+
+void MultiBandEQ::setValueTreeState(juce::AudioProcessorValueTreeState* apvts)
+{
+    valueTreeState = apvts;
+    cacheBandStateParameters();
+}
+
+void MultiBandEQ::setScratchArena(ScratchArena* arena)
+{
+    scratchArena = arena;
+    
+    for (auto& band : bands)
+    {
+        if (band)
+            band->setScratchArena(arena);
+    }
+}
+
+void MultiBandEQ::cacheBandStateParameters()
+{
+    enableParameters.fill(nullptr);
+    soloParameters.fill(nullptr);
+    
+    if (valueTreeState == nullptr)
+        return;
+    
+    const int numBands = juce::jmin(static_cast<int>(bands.size()), MAX_BANDS);
+    for (int band = 0; band < numBands; ++band)
+    {
+        enableParameters[band] = valueTreeState->getRawParameterValue("eq_enable_band" + juce::String(band));
+        soloParameters[band] = valueTreeState->getRawParameterValue("eq_solo_band" + juce::String(band));
+    }
 }
 
 EQBand* MultiBandEQ::getBand(int bandIndex)
@@ -501,6 +545,15 @@ void MultiBandEQ::prepare(double sampleRate, int samplesPerBlock)
     }
 }
 
+void MultiBandEQ::reset()
+{
+    for (auto& band : bands)
+    {
+        if (band)
+            band->reset();
+    }
+}
+
 void MultiBandEQ::processBuffer(juce::AudioBuffer<float>& buffer)
 {
     // Update all band parameters first
@@ -510,39 +563,13 @@ void MultiBandEQ::processBuffer(juce::AudioBuffer<float>& buffer)
             band->updateParameters();
     }
     
-    // Check if any band is soloed
-    bool anyBandSoloed = false;
-    for (int i = 0; i < static_cast<int>(bands.size()); ++i)
-    {
-        if (bands[i] && isBandSoloed(i))
-        {
-            anyBandSoloed = true;
-            break;
-        }
-    }
+    updateActiveBands();
     
-    // Process through bands based on enable/solo state
-    if (anyBandSoloed)
+    // Process the bands that survived the enable/solo check
+    for (auto& band : bands)
     {
-        // Only process soloed bands
-        for (int i = 0; i < static_cast<int>(bands.size()); ++i)
-        {
-            if (bands[i] && isBandSoloed(i))
-            {
-                bands[i]->processBuffer(buffer);
-            }
-        }
-    }
-    else
-    {
-        // Process all enabled bands
-        for (int i = 0; i < static_cast<int>(bands.size()); ++i)
-        {
-            if (bands[i] && isBandEnabled(i))
-            {
-                bands[i]->processBuffer(buffer);
-            }
-        }
+        if (band && band->isActive())
+            band->processBuffer(buffer);
     }
 }
 
@@ -555,65 +582,56 @@ void MultiBandEQ::processBuffer(juce::AudioBuffer<float>& buffer, const juce::Au
             band->updateParameters();
     }
     
+    updateActiveBands();
+    
+    // Process the bands that survived the enable/solo check, with sidechain
+    for (auto& band : bands)
+    {
+        if (band && band->isActive())
+            band->processBuffer(buffer, sidechainBuffer);
+    }
+}
+
+void MultiBandEQ::updateActiveBands()
+{
     // Check if any band is soloed
     bool anyBandSoloed = false;
     for (int i = 0; i < static_cast<int>(bands.size()); ++i)
     {
-        if (isBandSoloed(i))
+        if (bands[i] && isBandSoloed(i))
         {
             anyBandSoloed = true;
             break;
         }
     }
     
-    // Process through bands based on enable/solo state
-    if (anyBandSoloed)
-    {
-        // Only process soloed bands with sidechain
-        for (int i = 0; i < static_cast<int>(bands.size()); ++i)
-        {
-            if (bands[i] && isBandSoloed(i))
-            {
-                bands[i]->processBuffer(buffer, sidechainBuffer);
-            }
-        }
-    }
-    else
+    // Soloed bands only when something is soloed, otherwise every enabled band
+    for (int i = 0; i < static_cast<int>(bands.size()); ++i)
     {
-        // Process all enabled bands with sidechain
-        for (int i = 0; i < static_cast<int>(bands.size()); ++i)
-        {
-            if (bands[i] && isBandEnabled(i))
-            {
-                bands[i]->processBuffer(buffer, sidechainBuffer);
-            }
-        }
+        if (bands[i])
+            bands[i]->setActive(anyBandSoloed ? isBandSoloed(i) : isBandEnabled(i));
     }
 }
 
 bool MultiBandEQ::isBandEnabled(int bandIndex) const
 {
-    if (!valueTreeState || bandIndex < 0 || bandIndex >= static_cast<int>(bands.size()))
+    if (bandIndex < 0 || bandIndex >= static_cast<int>(bands.size()) || bandIndex >= MAX_BANDS)
         return true;  // Default enabled when no state available
     
-    juce::String paramID = "eq_enable_band" + juce::String(bandIndex);
-    if (auto* param = dynamic_cast<juce::AudioParameterBool*>(valueTreeState->getParameter(paramID)))
-    {
-        return param->get();
-    }
+    if (auto* param = enableParameters[bandIndex])
+        return param->load() >= 0.5f;
+    
     return true;  // Default enabled
 }
 
 bool MultiBandEQ::isBandSoloed(int bandIndex) const
 {
-    if (!valueTreeState || bandIndex < 0 || bandIndex >= static_cast<int>(bands.size()))
+    if (bandIndex < 0 || bandIndex >= static_cast<int>(bands.size()) || bandIndex >= MAX_BANDS)
         return false;  // Default not soloed when no state available
     
-    juce::String paramID = "eq_solo_band" + juce::String(bandIndex);
-    if (auto* param = dynamic_cast<juce::AudioParameterBool*>(valueTreeState->getParameter(paramID)))
-    {
-        return param->get();
-    }
+    if (auto* param = soloParameters[bandIndex])
+        return param->load() >= 0.5f;
+    
     return false;  // Default not soloed
 }
 
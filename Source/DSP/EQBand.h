@@ -5,6 +5,9 @@
 #include <chowdsp_filters/chowdsp_filters.h>
 #include <chowdsp_eq/chowdsp_eq.h>
 #include "../Parameters/ParameterManager.h"
+#include "ScratchArena.h"
+#include "BiquadResponse.h"
+#include "SeqLock.h"
 #include <chowdsp_compressor/chowdsp_compressor.h>
 
 namespace DynamicEQ {
@@ -163,6 +166,9 @@ public:
                        const juce::String& modeID, const juce::String& bypassID);
     void prepare(double sampleRate, int samplesPerBlock);
     
+    // Clears the filter state (real-time safe)
+    void reset();
+    
     // Real-time processing
     void updateParameters();
     void processBuffer(juce::AudioBuffer<float>& buffer);
@@ -188,6 +194,24 @@ public:
     // Multi-band expansion support
     void setBandIndex(int bandIndex) { currentBandIndex = bandIndex; }
     int getBandIndex() const { return currentBandIndex; }
+    
+    // Real-time scratch memory (owned by the processor)
+    void setScratchArena(ScratchArena* arena) { scratchArena = arena; }
+    
+    // Snapshot of the running filter for the display - published lock-free from the audio thread
+    struct ResponseState
+    {
+        BiquadCoefficients coefficients;
+        double sampleRate = 44100.0;
+        bool active = false; // enabled, and not silenced by another band's solo
+    };
+    
+    ResponseState getResponseState() const noexcept { return publishedResponse.load(); }
+    uint32_t getResponseVersion() const noexcept { return publishedResponse.getVersion(); }
+    
+    // Called by MultiBandEQ each block with the band's effective enable/solo state
+    void setActive(bool shouldBeActive) noexcept;
+    bool isActive() const noexcept { return currentResponse.active; }
 
 private:
     // Clean DSP implementation using typed stereo filter wrappers
@@ -236,9 +260,13 @@ private:
     CompressorType compressor;
     bool dynamicsEnabled = false;
     
-    // Temporary buffers for dynamics processing
-    juce::AudioBuffer<float> compressorBuffer;
-    juce::AudioBuffer<float> keyInputBuffer;
+    // Key input buffers are borrowed from here instead of being resized per block
+    ScratchArena* scratchArena = nullptr;
+    
+    // Audio-thread copy of the display snapshot; republished only when it changes
+    ResponseState currentResponse;
+    SeqLock<ResponseState> publishedResponse;
+    bool responseNeedsUpdate = true;
     
     // Current values for external access
     float lastFrequency = 1000.0f;
@@ -261,6 +289,7 @@ private:
     void cacheParameterIndices();
     void cacheDynamicsParameterIndices();
     void updateFilterParameters(float frequency, float gainDb, float q, FilterType filterType);
+    void publishResponse() noexcept;
     void updateDynamicsParameters();
     void processDynamicsBlock(juce::AudioBuffer<float>& buffer);
     void processDynamicsBlockWithSidechain(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>* sidechainBuffer);
@@ -287,20 +316,31 @@ public:
     
     // Processing
     void prepare(double sampleRate, int samplesPerBlock);
+    void reset();
     void processBuffer(juce::AudioBuffer<float>& buffer);
     void processBuffer(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>* sidechainBuffer);
     
     // Band control
     void setParameterManager(ParameterManager* manager) { parameterManager = manager; }
-    void setValueTreeState(juce::AudioProcessorValueTreeState* apvts) { valueTreeState = apvts; }
+    void setValueTreeState(juce::AudioProcessorValueTreeState* apvts);
+    void setScratchArena(ScratchArena* arena);
     bool isBandEnabled(int bandIndex) const;
     bool isBandSoloed(int bandIndex) const;
     
 private:
+    // Decides which bands run this block and tells each band, so its published response carries the state
+    void updateActiveBands();
+    
     std::vector<std::unique_ptr<EQBand>> bands;
     double currentSampleRate = 44100.0;
     ParameterManager* parameterManager = nullptr;
     juce::AudioProcessorValueTreeState* valueTreeState = nullptr;
+    ScratchArena* scratchArena = nullptr;
+    
+    // Enable/solo parameters cached up front - looking them up by ID allocates on the audio thread
+    std::array<std::atomic<float>*, MAX_BANDS> enableParameters {};
+    std::array<std::atomic<float>*, MAX_BANDS> soloParameters {};
+    void cacheBandStateParameters();
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultiBandEQ)
 };
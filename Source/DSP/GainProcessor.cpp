@@ -9,51 +9,51 @@ void GainProcessor::setup(const juce::String& paramID, ParameterManager* paramMa
     manager = paramManager;
 }
 
+void GainProcessor::prepare(double sampleRate, double compensationRampSeconds)
+{
+    compensation.reset(sampleRate, compensationRampSeconds);
+}
+
 void GainProcessor::processBuffer(juce::AudioBuffer<float>& buffer)
 {
     auto* smoothedGain = manager->getSmoothedValue(parameterID);
     if (smoothedGain == nullptr) return;
     
-    if (smoothedGain->isSmoothing())
+    if (smoothedGain->isSmoothing() || compensation.isSmoothing())
     {
-        // Apply smoothed gain when parameters are changing
-        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        // Apply smoothed gain when parameters are changing - one gain per sample frame, shared by the channels
+        auto* const* channels = buffer.getArrayOfWritePointers();
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
         {
-            auto* channelData = buffer.getWritePointer(channel);
-            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            float gainValue = smoothedGain->getNextValue() * compensation.getNextValue();
+            
+            // Safety checks to prevent crashes
+            if (!std::isfinite(gainValue) || gainValue <= 0.0f)
+                continue;
+            
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
             {
-                float gainValue = smoothedGain->getNextValue();
+                auto* channelData = channels[channel];
+                float result = channelData[sample] * gainValue;
                 
-                // Safety checks to prevent crashes
-                if (std::isfinite(gainValue) && gainValue > 0.0f)
+                // Smart limiting - only engage when signal is actually hot
+                if (std::abs(result) > 0.95f)
                 {
-                    float result = channelData[sample] * gainValue;
-                    
-                    // Smart limiting - only engage when signal is actually hot
-                    if (std::abs(result) > 0.95f)
-                    {
-                        // Apply soft limiting only when needed
-                        channelData[sample] = std::tanh(result * 0.85f);
-                    }
-                    else
-                    {
-                        // Pass through unmodified for normal levels
-                        channelData[sample] = result;
-                    }
+                    // Apply soft limiting only when needed
+                    channelData[sample] = std::tanh(result * 0.85f);
+                }
+                else
+                {
+                    // Pass through unmodified for normal levels
+                    channelData[sample] = result;
                 }
             }
-            
-            // Reset for next channel
-            smoothedGain->skip(-buffer.getNumSamples());
         }
-        
-        // Skip for next buffer
-        smoothedGain->skip(buffer.getNumSamples());
     }
     else
     {
         // Apply constant gain when not smoothing - more efficient
-        float constantGain = smoothedGain->getCurrentValue();
+        float constantGain = smoothedGain->getCurrentValue() * compensation.getCurrentValue();
         
         // Safety checks for constant gain
         if (constantGain != 1.0f && std::isfinite(constantGain) && constantGain > 0.0f)
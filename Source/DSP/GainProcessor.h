@@ -18,18 +18,24 @@ public:
     
     // Setup and configuration
     void setup(const juce::String& paramID, ParameterManager* paramManager);
+    void prepare(double sampleRate, double compensationRampSeconds);
+    
+    // Extra linear gain folded into the same kernel (e.g. loudness compensation), ramped on change
+    void setCompensationGain(float gain) noexcept { compensation.setTargetValue(gain); }
     
     // Real-time processing
     void processBuffer(juce::AudioBuffer<float>& buffer);
     
     // Status queries
     float getCurrentGain() const;
+    float getCurrentCompensationGain() const noexcept { return compensation.getCurrentValue(); }
     bool isSmoothing() const;
 
 private:
     // Parameter management
     juce::String parameterID;
     ParameterManager* manager = nullptr;
+    juce::LinearSmoothedValue<float> compensation { 1.0f };
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainProcessor)
 };
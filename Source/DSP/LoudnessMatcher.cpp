@@ -0,0 +1,51 @@
+#include "LoudnessMatcher.h"
+#include <cmath>
+
+namespace DynamicEQ {
+
+void LoudnessMatcher::update(float inputLUFS, float outputLUFS, double elapsedSeconds) noexcept
+{
+    // Sample the applied gain on the loudness meter's 100 ms grid
+    secondsSinceStep += elapsedSeconds;
+    while (secondsSinceStep >= STEP_SECONDS)
+    {
+        appliedGainHistory[static_cast<size_t>(historyIndex)] = appliedGainDB.load(std::memory_order_relaxed);
+        historyIndex = (historyIndex + 1) % HISTORY_STEPS;
+        historyCount = juce::jmin(historyCount + 1, HISTORY_STEPS);
+        secondsSinceStep -= STEP_SECONDS;
+    }
+
+    // Hold the estimate until a whole window has been processed audio - while bypassed or
+    // crossfading the output tap says nothing about what the EQ does
+    if (!processingActive.load(std::memory_order_relaxed))
+        secondsProcessing = 0.0;
+    else
+        secondsProcessing += elapsedSeconds;
+
+    if (secondsProcessing < WINDOW_SECONDS || historyCount == 0 || inputLUFS < MIN_INPUT_LUFS)
+        return;
+
+    float averageGainDB = 0.0f;
+    for (int step = 0; step < historyCount; ++step)
+        averageGainDB += appliedGainHistory[static_cast<size_t>(step)];
+    averageGainDB /= static_cast<float>(historyCount);
+
+    // What the EQ alone did to the loudness; the compensation undoes it
+    const float processingDeltaDB = outputLUFS - inputLUFS - averageGainDB;
+    const float targetDB = juce::jlimit(-MAX_COMPENSATION_DB, MAX_COMPENSATION_DB, -processingDeltaDB);
+
+    const float smoothing = static_cast<float>(1.0 - std::exp(-elapsedSeconds / SMOOTHING_SECONDS));
+    smoothedCompensationDB += (targetDB - smoothedCompensationDB) * smoothing;
+    compensationDB.store(smoothedCompensationDB, std::memory_order_relaxed);
+}
+
+void LoudnessMatcher::restart() noexcept
+{
+    appliedGainHistory.fill(0.0f);
+    historyIndex = 0;
+    historyCount = 0;
+    secondsSinceStep = 0.0;
+    secondsProcessing = 0.0;
+}
+
+} // namespace DynamicEQ
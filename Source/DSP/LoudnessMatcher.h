@@ -0,0 +1,55 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+namespace DynamicEQ {
+
+/**
+ * Compensation gain that keeps the processed signal as loud as the unprocessed one
+ * A control thread feeds it the short-term loudness of the pre- and post-processing meter taps;
+ * the audio thread reports the gain it applied outside the EQ and reads back the smoothed result
+ */
+class LoudnessMatcher
+{
+public:
+    // Audio thread - everything applied between the two taps except the EQ (input/output gain and
+    // the compensation itself), and whether the EQ is fully in circuit
+    void setAppliedGainDB(float gainDB) noexcept { appliedGainDB.store(gainDB, std::memory_order_relaxed); }
+    void setProcessingActive(bool isActive) noexcept { processingActive.store(isActive, std::memory_order_relaxed); }
+
+    // Any thread
+    float getCompensationDB() const noexcept { return compensationDB.load(std::memory_order_relaxed); }
+
+    // Control thread - elapsedSeconds is the audio time the loudness readings advanced by
+    void update(float inputLUFS, float outputLUFS, double elapsedSeconds) noexcept;
+
+    // Control thread - the meters started a new measurement; waits for a full window again but keeps
+    // the current compensation so nothing jumps
+    void restart() noexcept;
+
+    static constexpr float MAX_COMPENSATION_DB = 24.0f;
+
+private:
+    // Matches the short-term loudness window, so the applied gain is averaged over the same audio
+    static constexpr int HISTORY_STEPS = 30;
+    static constexpr double STEP_SECONDS = 0.1;
+    static constexpr double WINDOW_SECONDS = HISTORY_STEPS * STEP_SECONDS;
+    static constexpr double SMOOTHING_SECONDS = 1.0;
+    static constexpr float MIN_INPUT_LUFS = -60.0f; // below this the estimate is mostly noise
+
+    std::atomic<float> appliedGainDB{0.0f};
+    std::atomic<bool> processingActive{true};
+    std::atomic<float> compensationDB{0.0f};
+
+    // Control thread only
+    std::array<float, HISTORY_STEPS> appliedGainHistory {};
+    int historyIndex = 0;
+    int historyCount = 0;
+    double secondsSinceStep = 0.0;
+    double secondsProcessing = 0.0;
+    float smoothedCompensationDB = 0.0f;
+};
+
+} // namespace DynamicEQ
@@ -0,0 +1,327 @@
+#include "MeteringEngine.h"
+#include <cmath>
+
+namespace DynamicEQ {
+
+MeteringEngine::MeteringEngine()
+{
+    prepare(currentSampleRate);
+}
+
+void MeteringEngine::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    stepLength = juce::jmax(1, juce::roundToInt(sampleRate * STEP_SECONDS));
+
+    updateKWeighting();
+    updateTruePeakFilter();
+    updateBallisticCoefficients();
+    reset();
+}
+
+void MeteringEngine::setBallistics(const Ballistics& newBallistics)
+{
+    ballistics = newBallistics;
+    updateBallisticCoefficients();
+}
+
+void MeteringEngine::reset() noexcept
+{
+    for (auto& state : channels)
+    {
+        state.kWeightingState = {};
+        std::fill(state.truePeakHistory.begin(), state.truePeakHistory.end(), 0.0f);
+        state.truePeakIndex = 0;
+        state.truePeakMax = 0.0f;
+        state.peakEnvelope = 0.0f;
+        state.meanSquare = 0.0f;
+    }
+
+    stepPosition = 0;
+    stepEnergy = 0.0;
+    stepEnergies.fill(0.0);
+    stepWriteIndex = 0;
+    stepsWritten = 0;
+    gateBlockCounts.fill(0);
+    gateBlockEnergies.fill(0.0);
+
+    readings = Readings();
+}
+
+void MeteringEngine::updateKWeighting()
+{
+    // BS.1770 gives the filters as 48 kHz coefficients; these are the analog designs behind them,
+    // so every sample rate gets the same response (they reproduce the published 48 kHz values)
+    const double pi = juce::MathConstants<double>::pi;
+
+    {
+        const double frequency = 1681.974450955533;
+        const double gainDB = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(pi * frequency / currentSampleRate);
+        const double vh = std::pow(10.0, gainDB / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        auto& shelf = kWeighting[0];
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    {
+        const double frequency = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(pi * frequency / currentSampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        // The standard leaves the high-pass numerator unnormalised (1, -2, 1)
+        auto& highPass = kWeighting[1];
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+}
+
+void MeteringEngine::updateTruePeakFilter()
+{
+    // BS.1770 Annex 2: 4x oversampling below 96 kHz, 2x below 192 kHz, plain sample peak above
+    oversamplingFactor = currentSampleRate < 96000.0 ? 4 : (currentSampleRate < 192000.0 ? 2 : 1);
+
+    const int numTaps = oversamplingFactor * TRUE_PEAK_TAPS_PER_PHASE;
+    const double centre = 0.5 * (numTaps - 1);
+    const double pi = juce::MathConstants<double>::pi;
+
+    truePeakPhases.assign(static_cast<size_t>(oversamplingFactor), std::vector<float>(TRUE_PEAK_TAPS_PER_PHASE, 0.0f));
+
+    for (int phase = 0; phase < oversamplingFactor; ++phase)
+    {
+        // Blackman-windowed sinc interpolator, each phase normalised to unity gain at DC
+        std::vector<double> taps(TRUE_PEAK_TAPS_PER_PHASE);
+        double sum = 0.0;
+
+        for (int tap = 0; tap < TRUE_PEAK_TAPS_PER_PHASE; ++tap)
+        {
+            const int index = phase + tap * oversamplingFactor;
+            const double x = (index - centre) / oversamplingFactor;
+            const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(pi * x) / (pi * x);
+            const double windowPosition = (index + 0.5) / numTaps;
+            const double window = 0.42 - 0.5 * std::cos(2.0 * pi * windowPosition) + 0.08 * std::cos(4.0 * pi * windowPosition);
+            taps[static_cast<size_t>(tap)] = sinc * window;
+            sum += taps[static_cast<size_t>(tap)];
+        }
+
+        // Taps are stored newest-sample first, matching the history read order
+        auto& phaseTaps = truePeakPhases[static_cast<size_t>(phase)];
+        for (int tap = 0; tap < TRUE_PEAK_TAPS_PER_PHASE; ++tap)
+            phaseTaps[static_cast<size_t>(tap)] = static_cast<float>(taps[static_cast<size_t>(tap)] / sum);
+    }
+
+    for (auto& state : channels)
+    {
+        state.truePeakHistory.assign(2 * TRUE_PEAK_TAPS_PER_PHASE, 0.0f);
+        state.truePeakIndex = 0;
+    }
+}
+
+void MeteringEngine::updateBallisticCoefficients()
+{
+    auto coefficientFor = [this](float timeMs)
+    {
+        if (timeMs <= 0.0f)
+            return 0.0f;
+        return static_cast<float>(std::exp(-1000.0 / (timeMs * currentSampleRate)));
+    };
+
+    peakAttackCoefficient = coefficientFor(ballistics.peakAttackMs);
+    peakReleaseCoefficient = coefficientFor(ballistics.peakReleaseMs);
+    rmsCoefficient = coefficientFor(ballistics.rmsIntegrationMs);
+}
+
+void MeteringEngine::process(const float* const* channelData, int numChannels, int numSamples) noexcept
+{
+    numChannels = juce::jlimit(0, MAX_CHANNELS, numChannels);
+    if (numChannels != readings.numChannels)
+    {
+        // A layout change starts a new measurement
+        reset();
+        readings.numChannels = numChannels;
+    }
+
+    if (numChannels == 0)
+        return;
+
+    int position = 0;
+    while (position < numSamples)
+    {
+        // Run up to the end of the current 100 ms loudness step
+        const int numToProcess = juce::jmin(numSamples - position, stepLength - stepPosition);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto& state = channels[static_cast<size_t>(channel)];
+            const float* samples = channelData[channel] + position;
+
+            // K-weighting with the state kept in locals so the loop stays in registers
+            const auto& shelf = kWeighting[0];
+            const auto& highPass = kWeighting[1];
+            double shelfZ1 = state.kWeightingState[0][0], shelfZ2 = state.kWeightingState[0][1];
+            double highPassZ1 = state.kWeightingState[1][0], highPassZ2 = state.kWeightingState[1][1];
+            double sumOfSquares = 0.0;
+
+            float peakEnvelope = state.peakEnvelope;
+            float meanSquare = state.meanSquare;
+            float truePeakMax = state.truePeakMax;
+
+            for (int i = 0; i < numToProcess; ++i)
+            {
+                const double input = samples[i];
+
+                const double shelfOut = shelf.b0 * input + shelfZ1;
+                shelfZ1 = shelf.b1 * input - shelf.a1 * shelfOut + shelfZ2;
+                shelfZ2 = shelf.b2 * input - shelf.a2 * shelfOut;
+
+                const double weighted = highPass.b0 * shelfOut + highPassZ1;
+                highPassZ1 = highPass.b1 * shelfOut - highPass.a1 * weighted + highPassZ2;
+                highPassZ2 = highPass.b2 * shelfOut - highPass.a2 * weighted;
+
+                sumOfSquares += weighted * weighted;
+
+                // Peak and RMS ballistics on the unweighted signal
+                const float magnitude = std::abs(samples[i]);
+                const float peakCoefficient = magnitude > peakEnvelope ? peakAttackCoefficient : peakReleaseCoefficient;
+                peakEnvelope = magnitude + peakCoefficient * (peakEnvelope - magnitude);
+
+                const float square = samples[i] * samples[i];
+                meanSquare = square + rmsCoefficient * (meanSquare - square);
+
+                truePeakMax = juce::jmax(truePeakMax, processTruePeak(state, samples[i]));
+            }
+
+            state.kWeightingState[0] = { shelfZ1, shelfZ2 };
+            state.kWeightingState[1] = { highPassZ1, highPassZ2 };
+            state.peakEnvelope = peakEnvelope;
+            state.meanSquare = meanSquare;
+            state.truePeakMax = truePeakMax;
+
+            // BS.1770 channel weights are 1.0 for left and right
+            stepEnergy += sumOfSquares;
+        }
+
+        position += numToProcess;
+        stepPosition += numToProcess;
+
+        if (stepPosition == stepLength)
+            finishLoudnessStep();
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto& state = channels[static_cast<size_t>(channel)];
+        const auto index = static_cast<size_t>(channel);
+        readings.peakDB[index] = juce::Decibels::gainToDecibels(state.peakEnvelope, SILENCE_DB);
+        readings.rmsDB[index] = juce::Decibels::gainToDecibels(std::sqrt(state.meanSquare), SILENCE_DB);
+        readings.truePeakDB[index] = juce::Decibels::gainToDecibels(state.truePeakMax, SILENCE_DB);
+    }
+}
+
+float MeteringEngine::processTruePeak(ChannelState& state, float sample) const noexcept
+{
+    const float magnitude = std::abs(sample);
+    if (oversamplingFactor == 1)
+        return magnitude;
+
+    // Write each sample twice so the newest TRUE_PEAK_TAPS_PER_PHASE are always contiguous
+    state.truePeakIndex = (state.truePeakIndex == 0 ? TRUE_PEAK_TAPS_PER_PHASE : state.truePeakIndex) - 1;
+    state.truePeakHistory[static_cast<size_t>(state.truePeakIndex)] = sample;
+    state.truePeakHistory[static_cast<size_t>(state.truePeakIndex + TRUE_PEAK_TAPS_PER_PHASE)] = sample;
+
+    const float* history = state.truePeakHistory.data() + state.truePeakIndex;
+    float peak = magnitude;
+
+    for (const auto& taps : truePeakPhases)
+    {
+        float interpolated = 0.0f;
+        for (int tap = 0; tap < TRUE_PEAK_TAPS_PER_PHASE; ++tap)
+            interpolated += taps[static_cast<size_t>(tap)] * history[tap];
+
+        peak = juce::jmax(peak, std::abs(interpolated));
+    }
+
+    return peak;
+}
+
+void MeteringEngine::finishLoudnessStep() noexcept
+{
+    stepEnergies[static_cast<size_t>(stepWriteIndex)] = stepEnergy / stepLength;
+    stepWriteIndex = (stepWriteIndex + 1) % SHORT_TERM_STEPS;
+    stepsWritten = juce::jmin(stepsWritten + 1, SHORT_TERM_STEPS);
+    stepPosition = 0;
+    stepEnergy = 0.0;
+
+    auto meanOfLastSteps = [this](int numSteps)
+    {
+        double sum = 0.0;
+        for (int step = 1; step <= numSteps; ++step)
+            sum += stepEnergies[static_cast<size_t>((stepWriteIndex - step + SHORT_TERM_STEPS) % SHORT_TERM_STEPS)];
+        return sum / numSteps;
+    };
+
+    // Windows report over whatever they have until they fill up
+    const double momentaryEnergy = meanOfLastSteps(juce::jmin(stepsWritten, MOMENTARY_STEPS));
+    readings.momentaryLUFS = energyToLUFS(momentaryEnergy);
+    readings.shortTermLUFS = energyToLUFS(meanOfLastSteps(stepsWritten));
+
+    // Every step completes a 400 ms gating block overlapping the previous one by 75%
+    if (stepsWritten >= MOMENTARY_STEPS && readings.momentaryLUFS > ABSOLUTE_GATE_LUFS)
+    {
+        const int bin = juce::jlimit(0, GATE_BINS - 1, static_cast<int>((readings.momentaryLUFS - ABSOLUTE_GATE_LUFS) / GATE_BIN_WIDTH_LU));
+        ++gateBlockCounts[static_cast<size_t>(bin)];
+        gateBlockEnergies[static_cast<size_t>(bin)] += momentaryEnergy;
+
+        readings.integratedLUFS = computeIntegratedLoudness();
+    }
+}
+
+float MeteringEngine::computeIntegratedLoudness() const noexcept
+{
+    // Relative gate: 10 LU below the mean of every block that passed the absolute gate
+    uint64_t numBlocks = 0;
+    double energy = 0.0;
+    for (int bin = 0; bin < GATE_BINS; ++bin)
+    {
+        numBlocks += gateBlockCounts[static_cast<size_t>(bin)];
+        energy += gateBlockEnergies[static_cast<size_t>(bin)];
+    }
+
+    if (numBlocks == 0)
+        return SILENCE_DB;
+
+    const double relativeGate = energyToLUFS(energy / static_cast<double>(numBlocks)) + RELATIVE_GATE_LU;
+    const int firstBin = juce::jlimit(0, GATE_BINS, juce::roundToInt((relativeGate - ABSOLUTE_GATE_LUFS) / GATE_BIN_WIDTH_LU));
+
+    numBlocks = 0;
+    energy = 0.0;
+    for (int bin = firstBin; bin < GATE_BINS; ++bin)
+    {
+        numBlocks += gateBlockCounts[static_cast<size_t>(bin)];
+        energy += gateBlockEnergies[static_cast<size_t>(bin)];
+    }
+
+    return numBlocks > 0 ? energyToLUFS(energy / static_cast<double>(numBlocks)) : SILENCE_DB;
+}
+
+float MeteringEngine::energyToLUFS(double meanSquare) noexcept
+{
+    if (meanSquare <= 0.0)
+        return SILENCE_DB;
+    return juce::jmax(SILENCE_DB, static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)));
+}
+
+} // namespace DynamicEQ
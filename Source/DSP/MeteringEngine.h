@@ -0,0 +1,133 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace DynamicEQ {
+
+/**
+ * ITU-R BS.1770 loudness and true-peak meter with per-channel peak/RMS ballistics
+ * Meant for the analysis worker - the audio thread only copies samples into the analyzer's ring
+ */
+class MeteringEngine
+{
+public:
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr float SILENCE_DB = -120.0f;
+
+    /** Exponential time constants for the per-channel readings */
+    struct Ballistics
+    {
+        float peakAttackMs = 0.0f;       // 0 follows peaks instantly
+        float peakReleaseMs = 650.0f;
+        float rmsIntegrationMs = 300.0f; // VU-style averaging time
+    };
+
+    /** One snapshot of every reading - trivially copyable so it can be published through a SeqLock */
+    struct Readings
+    {
+        int numChannels = 0;
+        float momentaryLUFS = SILENCE_DB;  // 400 ms window
+        float shortTermLUFS = SILENCE_DB;  // 3 s window
+        float integratedLUFS = SILENCE_DB; // gated, since the last reset
+        std::array<float, MAX_CHANNELS> peakDB { SILENCE_DB, SILENCE_DB };
+        std::array<float, MAX_CHANNELS> rmsDB { SILENCE_DB, SILENCE_DB };
+        std::array<float, MAX_CHANNELS> truePeakDB { SILENCE_DB, SILENCE_DB }; // maximum since the last reset
+
+        float getMaxPeakDB() const noexcept { return getMax(peakDB); }
+        float getMaxRMSDB() const noexcept { return getMax(rmsDB); }
+        float getMaxTruePeakDB() const noexcept { return getMax(truePeakDB); }
+
+    private:
+        float getMax(const std::array<float, MAX_CHANNELS>& values) const noexcept
+        {
+            float result = SILENCE_DB;
+            for (int channel = 0; channel < juce::jmin(numChannels, MAX_CHANNELS); ++channel)
+                result = juce::jmax(result, values[static_cast<size_t>(channel)]);
+            return result;
+        }
+    };
+
+    MeteringEngine();
+
+    void prepare(double sampleRate);
+    void setBallistics(const Ballistics& newBallistics);
+
+    // Clears the loudness history, the integrated gate and the true-peak maximum
+    void reset() noexcept;
+
+    // Channels beyond MAX_CHANNELS are ignored
+    void process(const float* const* channelData, int numChannels, int numSamples) noexcept;
+
+    const Readings& getReadings() const noexcept { return readings; }
+
+private:
+    static constexpr int MOMENTARY_STEPS = 4;
+    static constexpr int SHORT_TERM_STEPS = 30;
+    static constexpr double STEP_SECONDS = 0.1;
+    static constexpr double ABSOLUTE_GATE_LUFS = -70.0;
+    static constexpr double RELATIVE_GATE_LU = -10.0;
+    static constexpr double GATE_BIN_WIDTH_LU = 0.1;
+    static constexpr int GATE_BINS = 800; // -70 to +10 LUFS
+    static constexpr int TRUE_PEAK_TAPS_PER_PHASE = 12;
+
+    /** Transposed direct form II biquad, normalised so a0 == 1 */
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    struct ChannelState
+    {
+        std::array<std::array<double, 2>, 2> kWeightingState {}; // per stage
+        std::vector<float> truePeakHistory; // last TRUE_PEAK_TAPS_PER_PHASE inputs, stored twice so reads are contiguous
+        int truePeakIndex = 0;
+        float truePeakMax = 0.0f;
+        float peakEnvelope = 0.0f;
+        float meanSquare = 0.0f;
+    };
+
+    void updateKWeighting();
+    void updateTruePeakFilter();
+    void updateBallisticCoefficients();
+    float processTruePeak(ChannelState& state, float sample) const noexcept;
+    void finishLoudnessStep() noexcept;
+    float computeIntegratedLoudness() const noexcept;
+
+    static float energyToLUFS(double meanSquare) noexcept;
+
+    double currentSampleRate = 48000.0;
+    Ballistics ballistics;
+    Readings readings;
+
+    // K-weighting: the BS.1770 pre-filter (high shelf) followed by the RLB high-pass
+    std::array<Biquad, 2> kWeighting;
+    std::array<ChannelState, MAX_CHANNELS> channels;
+
+    // Polyphase interpolator for true peak - phase p holds taps p, p + factor, p + 2 factor, ...
+    int oversamplingFactor = 4;
+    std::vector<std::vector<float>> truePeakPhases;
+
+    float peakAttackCoefficient = 0.0f;
+    float peakReleaseCoefficient = 0.0f;
+    float rmsCoefficient = 0.0f;
+
+    // Loudness runs on 100 ms steps; momentary and short-term are the means of the last 4 and 30
+    int stepLength = 4800;
+    int stepPosition = 0;
+    double stepEnergy = 0.0;
+    std::array<double, SHORT_TERM_STEPS> stepEnergies {};
+    int stepWriteIndex = 0;
+    int stepsWritten = 0;
+
+    // Integrated loudness gating over the overlapping 400 ms blocks. Block energies are binned by
+    // loudness, so the gate needs no growing history - only the relative threshold is quantised
+    std::array<uint64_t, GATE_BINS> gateBlockCounts {};
+    std::array<double, GATE_BINS> gateBlockEnergies {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeteringEngine)
+};
+
+} // namespace DynamicEQ
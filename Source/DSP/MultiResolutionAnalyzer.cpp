@@ -0,0 +1,243 @@
+#include "MultiResolutionAnalyzer.h"
+#include <cstring>
+
+namespace DynamicEQ {
+
+const std::array<float, MultiResolutionAnalyzer::HalfBandDecimator::NUM_TAPS>& MultiResolutionAnalyzer::getHalfBandCoefficients()
+{
+    // Blackman-windowed sinc with its cutoff at a quarter of the input rate, unity gain at DC
+    static const auto coefficients = []
+    {
+        constexpr int numTaps = HalfBandDecimator::NUM_TAPS;
+        constexpr int centre = numTaps / 2;
+        std::array<float, numTaps> taps {};
+        double sum = 0.0;
+
+        for (int n = 0; n < numTaps; ++n)
+        {
+            const double x = 0.5 * (n - centre);
+            const double sinc = (n == centre) ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            const double phase = 2.0 * juce::MathConstants<double>::pi * n / (numTaps - 1);
+            const double blackman = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            taps[static_cast<size_t>(n)] = static_cast<float>(0.5 * sinc * blackman);
+            sum += taps[static_cast<size_t>(n)];
+        }
+
+        for (auto& tap : taps)
+            tap = static_cast<float>(tap / sum);
+
+        return taps;
+    }();
+
+    return coefficients;
+}
+
+void MultiResolutionAnalyzer::HalfBandDecimator::reset() noexcept
+{
+    inputHistory.fill(0.0f);
+    outputHistory.fill(0.0f);
+    writeIndex = 0;
+    producesOutput = false;
+}
+
+bool MultiResolutionAnalyzer::HalfBandDecimator::push(float input, float output, float& decimatedInput, float& decimatedOutput) noexcept
+{
+    // Doubled history so the newest NUM_TAPS samples are always contiguous
+    inputHistory[static_cast<size_t>(writeIndex)] = inputHistory[static_cast<size_t>(writeIndex + NUM_TAPS)] = input;
+    outputHistory[static_cast<size_t>(writeIndex)] = outputHistory[static_cast<size_t>(writeIndex + NUM_TAPS)] = output;
+    writeIndex = (writeIndex + 1) % NUM_TAPS;
+
+    producesOutput = !producesOutput;
+    if (!producesOutput)
+        return false;
+
+    const auto& taps = getHalfBandCoefficients();
+    const float* inputWindow = inputHistory.data() + writeIndex;
+    const float* outputWindow = outputHistory.data() + writeIndex;
+
+    float inputSum = 0.0f, outputSum = 0.0f;
+    for (int n = 0; n < NUM_TAPS; ++n)
+    {
+        inputSum += taps[static_cast<size_t>(n)] * inputWindow[n];
+        outputSum += taps[static_cast<size_t>(n)] * outputWindow[n];
+    }
+
+    decimatedInput = inputSum;
+    decimatedOutput = outputSum;
+    return true;
+}
+
+void MultiResolutionAnalyzer::prepare(double sampleRate, float overlap, int referenceFftSize)
+{
+    // Same time resolution at the top of the spectrum whatever the host rate
+    const int order = juce::jlimit(MIN_BAND_ORDER, MAX_BAND_ORDER,
+                                   static_cast<int>(std::ceil(std::log2(sampleRate * TOP_BAND_WINDOW_SECONDS))));
+    bandFftSize = 1 << order;
+    hopSize = juce::jmax(1, juce::roundToInt(bandFftSize * (1.0f - overlap)));
+    const float magnitudeScale = static_cast<float>(referenceFftSize) / static_cast<float>(bandFftSize);
+    frameDurationSeconds = static_cast<float>(hopSize / sampleRate);
+    topBandFrameReady = false;
+
+    const size_t numBins = static_cast<size_t>(bandFftSize / 2);
+    for (int b = 0; b < NUM_BANDS; ++b)
+    {
+        auto& band = bands[static_cast<size_t>(b)];
+        if (band.fft == nullptr || band.fft->getOrder() != order)
+            band.fft = std::make_unique<StereoFFT>(order);
+
+        band.inputHistory.assign(static_cast<size_t>(bandFftSize), 0.0f);
+        band.outputHistory.assign(static_cast<size_t>(bandFftSize), 0.0f);
+        band.inputDb.assign(numBins, -120.0f);
+        band.outputDb.assign(numBins, -120.0f);
+        band.fillIndex = 0;
+        band.sampleRate = sampleRate / static_cast<double>(1 << b);
+
+        // Decimating by 2^b narrows the bins as much, and the noise power per bin with them
+        band.magnitudeScale = magnitudeScale * std::sqrt(static_cast<float>(1 << b));
+    }
+
+    for (auto& decimator : decimators)
+        decimator.reset();
+
+    // Log-frequency grid from MIN_GRID_FREQUENCY to Nyquist
+    const double nyquist = sampleRate * 0.5;
+    const double logMin = std::log(static_cast<double>(MIN_GRID_FREQUENCY));
+    const double logMax = std::log(nyquist);
+
+    gridFrequencies.resize(NUM_GRID_POINTS);
+    gridPoints.resize(NUM_GRID_POINTS);
+
+    for (int g = 0; g < NUM_GRID_POINTS; ++g)
+    {
+        const double position = static_cast<double>(g) / (NUM_GRID_POINTS - 1);
+        const double frequency = std::exp(logMin + (logMax - logMin) * position);
+        gridFrequencies[static_cast<size_t>(g)] = static_cast<float>(frequency);
+
+        // Finest band whose trusted range still covers this frequency
+        int bandIndex = 0;
+        for (int b = NUM_BANDS - 1; b > 0; --b)
+        {
+            if (frequency <= CROSSOVER_FRACTION * bands[static_cast<size_t>(b)].sampleRate)
+            {
+                bandIndex = b;
+                break;
+            }
+        }
+
+        // Bins between the neighbouring grid points' midpoints; a single bin means interpolate instead
+        const double binWidth = bands[static_cast<size_t>(bandIndex)].sampleRate / bandFftSize;
+        const double halfStep = 0.5 * (logMax - logMin) / (NUM_GRID_POINTS - 1);
+        const double lowEdge = std::exp(std::log(frequency) - halfStep) / binWidth;
+        const double highEdge = std::exp(std::log(frequency) + halfStep) / binWidth;
+        const double centreBin = frequency / binWidth;
+        const int lastValidBin = static_cast<int>(numBins) - 1;
+
+        auto& point = gridPoints[static_cast<size_t>(g)];
+        point.band = bandIndex;
+        point.firstBin = juce::jlimit(0, lastValidBin, static_cast<int>(std::ceil(lowEdge)));
+        point.lastBin = juce::jlimit(0, lastValidBin, static_cast<int>(std::floor(highEdge)));
+
+        if (point.lastBin <= point.firstBin)
+        {
+            point.firstBin = juce::jlimit(0, lastValidBin - 1, static_cast<int>(centreBin));
+            point.lastBin = point.firstBin;
+            point.fraction = juce::jlimit(0.0f, 1.0f, static_cast<float>(centreBin - point.firstBin));
+        }
+        else
+        {
+            point.fraction = 0.0f;
+        }
+    }
+}
+
+int MultiResolutionAnalyzer::getSamplesUntilNextFrame() const noexcept
+{
+    if (topBandFrameReady)
+        return 0;
+
+    // A full history is slid by one hop on the next push
+    const int fillIndex = bands[0].fillIndex;
+    return fillIndex == bandFftSize ? hopSize : bandFftSize - fillIndex;
+}
+
+void MultiResolutionAnalyzer::appendToBand(Band& band, float input, float output, bool isTopBand) noexcept
+{
+    // Slide lazily so a full frame stays readable until the next sample arrives
+    if (band.fillIndex == bandFftSize)
+    {
+        const int keep = bandFftSize - hopSize;
+        std::memmove(band.inputHistory.data(), band.inputHistory.data() + hopSize, sizeof(float) * static_cast<size_t>(keep));
+        std::memmove(band.outputHistory.data(), band.outputHistory.data() + hopSize, sizeof(float) * static_cast<size_t>(keep));
+        band.fillIndex = keep;
+    }
+
+    band.inputHistory[static_cast<size_t>(band.fillIndex)] = input;
+    band.outputHistory[static_cast<size_t>(band.fillIndex)] = output;
+
+    if (++band.fillIndex < bandFftSize)
+        return;
+
+    // The top band is transformed in computeFrame; the slower bands keep their latest spectrum
+    if (isTopBand)
+        topBandFrameReady = true;
+    else
+        band.fft->perform(band.inputHistory.data(), band.outputHistory.data(), band.magnitudeScale,
+                          band.inputDb.data(), band.outputDb.data());
+}
+
+void MultiResolutionAnalyzer::push(const float* input, const float* output, int numSamples) noexcept
+{
+    jassert(numSamples <= getSamplesUntilNextFrame());
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        appendToBand(bands[0], input[i], output[i], true);
+
+        // Each stage halves the rate, so the cascade only runs as deep as there are samples for
+        float decimatedInput = input[i];
+        float decimatedOutput = output[i];
+        for (int b = 1; b < NUM_BANDS; ++b)
+        {
+            if (!decimators[static_cast<size_t>(b - 1)].push(decimatedInput, decimatedOutput, decimatedInput, decimatedOutput))
+                break;
+
+            appendToBand(bands[static_cast<size_t>(b)], decimatedInput, decimatedOutput, false);
+        }
+    }
+}
+
+void MultiResolutionAnalyzer::computeFrame(float* inputDb, float* outputDb) noexcept
+{
+    topBandFrameReady = false;
+
+    auto& topBand = bands[0];
+    topBand.fft->perform(topBand.inputHistory.data(), topBand.outputHistory.data(), topBand.magnitudeScale,
+                         topBand.inputDb.data(), topBand.outputDb.data());
+
+    for (size_t g = 0; g < gridPoints.size(); ++g)
+    {
+        const auto& point = gridPoints[g];
+        const auto& band = bands[static_cast<size_t>(point.band)];
+
+        if (point.lastBin > point.firstBin)
+        {
+            // Several bins per grid point - keep the peak so narrow tones are not lost
+            float inputPeak = -120.0f, outputPeak = -120.0f;
+            for (int bin = point.firstBin; bin <= point.lastBin; ++bin)
+            {
+                inputPeak = juce::jmax(inputPeak, band.inputDb[static_cast<size_t>(bin)]);
+                outputPeak = juce::jmax(outputPeak, band.outputDb[static_cast<size_t>(bin)]);
+            }
+            inputDb[g] = inputPeak;
+            outputDb[g] = outputPeak;
+        }
+        else
+        {
+            const size_t bin = static_cast<size_t>(point.firstBin);
+            inputDb[g] = band.inputDb[bin] + point.fraction * (band.inputDb[bin + 1] - band.inputDb[bin]);
+            outputDb[g] = band.outputDb[bin] + point.fraction * (band.outputDb[bin + 1] - band.outputDb[bin]);
+        }
+    }
+}
+
+} // namespace DynamicEQ
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "StereoFFT.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace DynamicEQ {
+
+/**
+ * Constant-Q style spectrum analysis for an input/output stream pair
+ * Each octave sub-band is decimated by two from the one above and analysed with the same FFT size,
+ * so low frequencies get long windows and high frequencies short ones for less than twice the cost
+ * of a single full-rate FFT. The band spectra are fused onto one log-frequency grid.
+ *
+ * Calibration: the top band reads like a referenceFftSize-point frame, so a steady tone there shows the
+ * same level as in the single-STFT display. Each decimated band's bins are twice as narrow in Hz as the
+ * band above, which would drop broadband material by 3 dB per crossover, so every band is normalised
+ * for its decimation factor - levels are power per top-band bin, continuous for noise and music across
+ * the crossovers. A pure tone below the top band reads 3 dB higher per octave band down.
+ */
+class MultiResolutionAnalyzer
+{
+public:
+    static constexpr int NUM_BANDS = 5;
+    static constexpr int NUM_GRID_POINTS = 512;
+    static constexpr float MIN_GRID_FREQUENCY = 20.0f;
+
+    // Window length of the full-rate band - the FFT size follows the sample rate
+    static constexpr double TOP_BAND_WINDOW_SECONDS = 0.02;
+    static constexpr int MIN_BAND_ORDER = 10;
+    static constexpr int MAX_BAND_ORDER = 13;
+
+    // A band is used up to this fraction of its own sample rate (below the decimation filter's transition)
+    static constexpr float CROSSOVER_FRACTION = 0.375f;
+
+    MultiResolutionAnalyzer() = default;
+
+    // Setup (analysis worker) - allocates. The top band's levels match an FFT of referenceFftSize points
+    void prepare(double sampleRate, float overlap, int referenceFftSize);
+
+    // Feed at most getSamplesUntilNextFrame() samples, then call computeFrame() or consumeFrame() once that reaches zero
+    int getSamplesUntilNextFrame() const noexcept;
+    void push(const float* input, const float* output, int numSamples) noexcept;
+
+    // Fuses the latest band spectra into NUM_GRID_POINTS dB values per stream
+    void computeFrame(float* inputDb, float* outputDb) noexcept;
+
+    // Marks the pending frame as handled without transforming it, for passes nobody displays
+    void consumeFrame() noexcept { topBandFrameReady = false; }
+
+    const std::vector<float>& getFrequencies() const noexcept { return gridFrequencies; }
+    float getFrameDurationSeconds() const noexcept { return frameDurationSeconds; }
+    int getBandFftSize() const noexcept { return bandFftSize; }
+
+private:
+    /** 2:1 half-band FIR decimator for the stream pair */
+    struct HalfBandDecimator
+    {
+        static constexpr int NUM_TAPS = 63;
+
+        void reset() noexcept;
+        // Returns true when a decimated sample pair was produced
+        bool push(float input, float output, float& decimatedInput, float& decimatedOutput) noexcept;
+
+        std::array<float, NUM_TAPS * 2> inputHistory {};
+        std::array<float, NUM_TAPS * 2> outputHistory {};
+        int writeIndex = 0;
+        bool producesOutput = false;
+    };
+
+    struct Band
+    {
+        std::unique_ptr<StereoFFT> fft;
+        std::vector<float> inputHistory, outputHistory;
+        std::vector<float> inputDb, outputDb;
+        int fillIndex = 0;
+        double sampleRate = 0.0;
+        float magnitudeScale = 1.0f; // includes the decimation normalisation
+    };
+
+    /** Where a grid point reads from: a band and a bin range (or an interpolation position) */
+    struct GridPoint
+    {
+        int band = 0;
+        int firstBin = 0;
+        int lastBin = 0;
+        float fraction = 0.0f;
+    };
+
+    void appendToBand(Band& band, float input, float output, bool isTopBand) noexcept;
+    static const std::array<float, HalfBandDecimator::NUM_TAPS>& getHalfBandCoefficients();
+
+    std::array<Band, NUM_BANDS> bands;
+    std::array<HalfBandDecimator, NUM_BANDS - 1> decimators;
+    std::vector<GridPoint> gridPoints;
+    std::vector<float> gridFrequencies;
+
+    int bandFftSize = 0;
+    int hopSize = 1;
+    float frameDurationSeconds = 0.0f;
+    bool topBandFrameReady = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultiResolutionAnalyzer)
+};
+
+} // namespace DynamicEQ
@@ -0,0 +1,257 @@
+#include "RealtimeGuard.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <streambuf>
+
+#if VTR_USE_RTSAN
+// RealtimeSanitizer runtime entry points (the same ones [[clang::nonblocking]] instrumentation calls)
+extern "C"
+{
+    void __rtsan_realtime_enter();
+    void __rtsan_realtime_exit();
+    void __rtsan_disable();
+    void __rtsan_enable();
+    void __rtsan_notify_blocking_call(const char* functionName);
+}
+#endif
+
+namespace DynamicEQ {
+
+namespace
+{
+    // Read by the malloc interposer (RealtimeGuardInterposers.cpp), so they must not need a lazy TLS
+    // allocation of their own when the plugin is loaded with dlopen
+   #if defined(__linux__)
+    #define VTR_GUARD_TLS __attribute__((tls_model("initial-exec")))
+   #else
+    #define VTR_GUARD_TLS
+   #endif
+
+    thread_local int realtimeDepth VTR_GUARD_TLS = 0;
+    thread_local int disabledDepth VTR_GUARD_TLS = 0;
+    thread_local bool reportInProgress VTR_GUARD_TLS = false;
+
+    bool shouldAbortOnViolation()
+    {
+        // CI wants a hard failure; set VTR_RT_GUARD_REPORT_ONLY to keep running while investigating
+        static const bool abortOnViolation = std::getenv("VTR_RT_GUARD_REPORT_ONLY") == nullptr;
+        return abortOnViolation;
+    }
+
+    // Forwards to a standard stream's real buffer after checking the calling thread
+    class GuardedStreamBuffer : public std::streambuf
+    {
+    public:
+        GuardedStreamBuffer(std::ostream& streamToGuard, const char* streamName)
+            : stream(streamToGuard), name(streamName), destination(streamToGuard.rdbuf())
+        {
+            stream.rdbuf(this);
+        }
+
+        ~GuardedStreamBuffer() override
+        {
+            stream.rdbuf(destination);
+        }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            RealtimeGuard::checkNotRealtime(name);
+            if (traits_type::eq_int_type(ch, traits_type::eof()))
+                return traits_type::not_eof(ch);
+            return destination->sputc(traits_type::to_char_type(ch));
+        }
+
+        std::streamsize xsputn(const char* data, std::streamsize count) override
+        {
+            RealtimeGuard::checkNotRealtime(name);
+            return destination->sputn(data, count);
+        }
+
+        int sync() override { return destination->pubsync(); }
+
+    private:
+        std::ostream& stream;
+        const char* name;
+        std::streambuf* destination;
+    };
+
+    class GuardedLogger : public juce::Logger
+    {
+    protected:
+        void logMessage(const juce::String& message) override
+        {
+            RealtimeGuard::checkNotRealtime("juce::Logger");
+            juce::Logger::outputDebugString(message);
+        }
+    };
+
+    struct InstalledHooks
+    {
+        InstalledHooks()
+        {
+            if (juce::Logger::getCurrentLogger() == nullptr)
+                juce::Logger::setCurrentLogger(&logger);
+        }
+
+        ~InstalledHooks()
+        {
+            if (juce::Logger::getCurrentLogger() == &logger)
+                juce::Logger::setCurrentLogger(nullptr);
+        }
+
+        GuardedStreamBuffer coutBuffer { std::cout, "std::cout" };
+        GuardedStreamBuffer cerrBuffer { std::cerr, "std::cerr" };
+        GuardedStreamBuffer clogBuffer { std::clog, "std::clog" };
+        GuardedLogger logger;
+    };
+}
+
+bool RealtimeGuard::isInRealtimeContext() noexcept
+{
+    return realtimeDepth > 0 && disabledDepth == 0 && !reportInProgress;
+}
+
+void RealtimeGuard::checkNotRealtime(const char* operation) noexcept
+{
+   #if VTR_USE_RTSAN
+    // RTSan owns reporting in this mode so its stack traces and suppressions apply
+    __rtsan_notify_blocking_call(operation);
+   #else
+    if (isInRealtimeContext())
+        reportViolation(operation);
+   #endif
+}
+
+void RealtimeGuard::installHooks()
+{
+   #if VTR_REALTIME_GUARD
+    static InstalledHooks hooks;
+    juce::ignoreUnused(hooks);
+   #endif
+}
+
+void RealtimeGuard::reportViolation(const char* operation) noexcept
+{
+    // The report itself allocates and writes to stderr, so lift the guard while it runs
+    reportInProgress = true;
+
+    std::fprintf(stderr, "\n*** Real-time safety violation: %s called from the audio thread ***\n", operation);
+    std::fprintf(stderr, "%s\n", juce::SystemStats::getStackBacktrace().toRawUTF8());
+    std::fflush(stderr);
+
+    reportInProgress = false;
+
+    if (shouldAbortOnViolation())
+        std::abort();
+}
+
+RealtimeGuard::ScopedRealtimeContext::ScopedRealtimeContext() noexcept
+{
+    ++realtimeDepth;
+   #if VTR_USE_RTSAN
+    __rtsan_realtime_enter();
+   #endif
+}
+
+RealtimeGuard::ScopedRealtimeContext::~ScopedRealtimeContext() noexcept
+{
+   #if VTR_USE_RTSAN
+    __rtsan_realtime_exit();
+   #endif
+    --realtimeDepth;
+}
+
+RealtimeGuard::ScopedDisabler::ScopedDisabler() noexcept
+{
+    ++disabledDepth;
+   #if VTR_USE_RTSAN
+    __rtsan_disable();
+   #endif
+}
+
+RealtimeGuard::ScopedDisabler::~ScopedDisabler() noexcept
+{
+   #if VTR_USE_RTSAN
+    __rtsan_enable();
+   #endif
+    --disabledDepth;
+}
+
+} // namespace DynamicEQ
+
+#if VTR_REALTIME_GUARD && ! VTR_USE_RTSAN && defined(__linux__)
+// Called by the C library interposers, which cannot include JUCE's headers
+extern "C" void vtr_realtime_guard_check(const char* operation) noexcept
+{
+    DynamicEQ::RealtimeGuard::checkNotRealtime(operation);
+}
+#endif
+
+#if VTR_REALTIME_GUARD && ! VTR_USE_RTSAN
+// Without RTSan, catch heap traffic by replacing the global allocation functions.
+// The aligned overloads are left to the runtime, which pairs them with its own deallocators.
+void* operator new(std::size_t size)
+{
+    DynamicEQ::RealtimeGuard::checkNotRealtime("operator new");
+    if (auto* block = std::malloc(size == 0 ? 1 : size))
+        return block;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    DynamicEQ::RealtimeGuard::checkNotRealtime("operator new[]");
+    if (auto* block = std::malloc(size == 0 ? 1 : size))
+        return block;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    DynamicEQ::RealtimeGuard::checkNotRealtime("operator new");
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    DynamicEQ::RealtimeGuard::checkNotRealtime("operator new[]");
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* block) noexcept
+{
+    if (block != nullptr)
+        DynamicEQ::RealtimeGuard::checkNotRealtime("operator delete");
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept
+{
+    if (block != nullptr)
+        DynamicEQ::RealtimeGuard::checkNotRealtime("operator delete[]");
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+    operator delete(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept
+{
+    operator delete[](block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept
+{
+    operator delete(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept
+{
+    operator delete[](block);
+}
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+// Enabled by the VTR_REALTIME_SANITIZER CMake option; compiles away otherwise
+#ifndef VTR_REALTIME_GUARD
+ #define VTR_REALTIME_GUARD 0
+#endif
+
+// Set when the compiler supports -fsanitize=realtime (clang 20+)
+#ifndef VTR_USE_RTSAN
+ #define VTR_USE_RTSAN 0
+#endif
+
+namespace DynamicEQ {
+
+/**
+ * Debug/test guard for the audio thread
+ * Marks processBlock as a real-time context and traps allocations, locks, logging, file I/O
+ * and Python calls made from inside it, printing a stack trace for each violation
+ */
+class RealtimeGuard
+{
+public:
+    // True while the calling thread is inside a ScopedRealtimeContext
+    static bool isInRealtimeContext() noexcept;
+
+    // Reports (and by default aborts) if called from a real-time context
+    static void checkNotRealtime(const char* operation) noexcept;
+
+    // Installs the Logger and std::cout/cerr/clog hooks - call once before audio starts
+    static void installHooks();
+
+    /** Marks the enclosing scope as real-time for the current thread */
+    class ScopedRealtimeContext
+    {
+    public:
+        ScopedRealtimeContext() noexcept;
+        ~ScopedRealtimeContext() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeContext)
+    };
+
+    /** Temporarily lifts the guard, e.g. for an intentional, bounded operation */
+    class ScopedDisabler
+    {
+    public:
+        ScopedDisabler() noexcept;
+        ~ScopedDisabler() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedDisabler)
+    };
+
+private:
+    static void reportViolation(const char* operation) noexcept;
+};
+
+} // namespace DynamicEQ
+
+#if VTR_REALTIME_GUARD
+ #define VTR_REALTIME_CONTEXT() DynamicEQ::RealtimeGuard::ScopedRealtimeContext realtimeGuardContext
+ #define VTR_ASSERT_NOT_REALTIME(operation) DynamicEQ::RealtimeGuard::checkNotRealtime(operation)
+#else
+ #define VTR_REALTIME_CONTEXT()
+ #define VTR_ASSERT_NOT_REALTIME(operation)
+#endif
@@ -0,0 +1,146 @@
+// C library functions the built-in real-time guard traps when RTSan is not available (Linux only, see
+// CMakeLists.txt): the allocator, pthread_mutex_lock and file I/O. Each checks the calling thread and
+// forwards to glibc - the allocator through its __libc_ entry points, the rest through RTLD_NEXT.
+//
+// Deliberately includes no system or JUCE headers: with _FORTIFY_SOURCE or 64-bit file offsets they
+// turn open, read and friends into inline wrappers or renamed symbols that cannot be redefined here
+
+#if VTR_REALTIME_GUARD && ! VTR_USE_RTSAN && defined(__linux__)
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+
+extern "C"
+{
+    void vtr_realtime_guard_check(const char* operation) noexcept; // RealtimeGuard.cpp
+
+    void* __libc_malloc(std::size_t);
+    void* __libc_calloc(std::size_t, std::size_t);
+    void* __libc_realloc(void*, std::size_t);
+    void __libc_free(void*);
+
+    void* dlsym(void* handle, const char* name);
+}
+
+namespace
+{
+    // glibc's RTLD_NEXT, and the open flags that take a mode argument (the same on every Linux port
+    // the plugin builds for)
+    void* const NEXT_DEFINITION = reinterpret_cast<void*>(-1L);
+    constexpr int CREATE_FLAG = 0100;
+    constexpr int TMPFILE_FLAGS = 020200000;
+
+    using MutexLockFunction = int (*)(void*);
+    using OpenFunction = int (*)(const char*, int, ...);
+    using FopenFunction = void* (*)(const char*, const char*);
+    using ReadFunction = long (*)(int, void*, std::size_t);
+    using WriteFunction = long (*)(int, const void*, std::size_t);
+
+    // Looked up on first use, without a function-local static whose guard could itself take a lock
+    template <typename Function>
+    Function nextDefinition(std::atomic<Function>& cached, const char* name) noexcept
+    {
+        auto function = cached.load(std::memory_order_relaxed);
+        if (function == nullptr)
+        {
+            function = reinterpret_cast<Function>(dlsym(NEXT_DEFINITION, name));
+            cached.store(function, std::memory_order_relaxed);
+        }
+        return function;
+    }
+
+    std::atomic<MutexLockFunction> nextMutexLock { nullptr };
+    std::atomic<OpenFunction> nextOpen { nullptr };
+    std::atomic<OpenFunction> nextOpen64 { nullptr };
+    std::atomic<FopenFunction> nextFopen { nullptr };
+    std::atomic<FopenFunction> nextFopen64 { nullptr };
+    std::atomic<ReadFunction> nextRead { nullptr };
+    std::atomic<WriteFunction> nextWrite { nullptr };
+
+    unsigned int modeArgument(int flags, va_list arguments) noexcept
+    {
+        const bool createsFile = (flags & CREATE_FLAG) != 0 || (flags & TMPFILE_FLAGS) == TMPFILE_FLAGS;
+        return createsFile ? va_arg(arguments, unsigned int) : 0u;
+    }
+}
+
+extern "C"
+{
+    void* malloc(std::size_t size)
+    {
+        vtr_realtime_guard_check("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size)
+    {
+        vtr_realtime_guard_check("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* block, std::size_t size)
+    {
+        vtr_realtime_guard_check("realloc");
+        return __libc_realloc(block, size);
+    }
+
+    void free(void* block)
+    {
+        if (block != nullptr)
+            vtr_realtime_guard_check("free");
+        __libc_free(block);
+    }
+
+    int pthread_mutex_lock(void* mutex)
+    {
+        vtr_realtime_guard_check("pthread_mutex_lock");
+        return nextDefinition(nextMutexLock, "pthread_mutex_lock")(mutex);
+    }
+
+    int open(const char* path, int flags, ...)
+    {
+        vtr_realtime_guard_check("open");
+        va_list arguments;
+        va_start(arguments, flags);
+        const unsigned int mode = modeArgument(flags, arguments);
+        va_end(arguments);
+        return nextDefinition(nextOpen, "open")(path, flags, mode);
+    }
+
+    int open64(const char* path, int flags, ...)
+    {
+        vtr_realtime_guard_check("open64");
+        va_list arguments;
+        va_start(arguments, flags);
+        const unsigned int mode = modeArgument(flags, arguments);
+        va_end(arguments);
+        return nextDefinition(nextOpen64, "open64")(path, flags, mode);
+    }
+
+    void* fopen(const char* path, const char* mode)
+    {
+        vtr_realtime_guard_check("fopen");
+        return nextDefinition(nextFopen, "fopen")(path, mode);
+    }
+
+    void* fopen64(const char* path, const char* mode)
+    {
+        vtr_realtime_guard_check("fopen64");
+        return nextDefinition(nextFopen64, "fopen64")(path, mode);
+    }
+
+    long read(int descriptor, void* buffer, std::size_t count)
+    {
+        vtr_realtime_guard_check("read");
+        return nextDefinition(nextRead, "read")(descriptor, buffer, count);
+    }
+
+    long write(int descriptor, const void* buffer, std::size_t count)
+    {
+        vtr_realtime_guard_check("write");
+        return nextDefinition(nextWrite, "write")(descriptor, buffer, count);
+    }
+}
+
+#endif
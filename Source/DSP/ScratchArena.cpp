@@ -0,0 +1,145 @@
+#include "ScratchArena.h"
+#include <cstdlib>
+#include <cstring>
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <sys/mman.h>
+#endif
+
+namespace DynamicEQ {
+
+namespace
+{
+    constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    void* allocateAligned(size_t bytes)
+    {
+       #if JUCE_WINDOWS
+        return _aligned_malloc(bytes, ScratchArena::CACHE_LINE_SIZE);
+       #else
+        void* result = nullptr;
+        if (posix_memalign(&result, ScratchArena::CACHE_LINE_SIZE, bytes) != 0)
+            return nullptr;
+        return result;
+       #endif
+    }
+
+    void freeAligned(void* block)
+    {
+       #if JUCE_WINDOWS
+        _aligned_free(block);
+       #else
+        std::free(block);
+       #endif
+    }
+}
+
+ScratchArena::~ScratchArena()
+{
+    release();
+}
+
+void ScratchArena::prepare(size_t bytesNeeded, bool useHugePages)
+{
+    bytesNeeded = alignUp(juce::jmax(bytesNeeded, CACHE_LINE_SIZE));
+
+    // Keep the existing block when it is already big enough - prepareToPlay can be called repeatedly
+    if (memory != nullptr && bytesNeeded <= capacity && useHugePages == hugePagesInUse)
+    {
+        offset = 0;
+        return;
+    }
+
+    release();
+
+   #if JUCE_LINUX
+    if (useHugePages)
+    {
+        // Explicit huge pages first, then fall back to transparent huge pages below
+        const size_t hugeBytes = (bytesNeeded + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        void* mapped = mmap(nullptr, hugeBytes, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapped != MAP_FAILED)
+        {
+            memory = static_cast<char*>(mapped);
+            capacity = hugeBytes;
+            mappedBytes = hugeBytes;
+            hugePagesInUse = true;
+        }
+    }
+   #endif
+
+    if (memory == nullptr)
+    {
+        memory = static_cast<char*>(allocateAligned(bytesNeeded));
+        if (memory == nullptr)
+        {
+            juce::Logger::writeToLog("ScratchArena: failed to allocate " + juce::String(static_cast<juce::int64>(bytesNeeded)) + " bytes");
+            return;
+        }
+
+        capacity = bytesNeeded;
+
+       #if JUCE_LINUX && defined(MADV_HUGEPAGE)
+        if (useHugePages)
+            hugePagesInUse = madvise(memory, capacity, MADV_HUGEPAGE) == 0;
+       #endif
+    }
+
+    // Touch every page now so the audio thread never takes a page fault
+    std::memset(memory, 0, capacity);
+
+   #if JUCE_LINUX || JUCE_MAC
+    mlock(memory, capacity);
+   #endif
+
+    offset = 0;
+    highWaterMark = 0;
+}
+
+void ScratchArena::release()
+{
+    if (memory == nullptr)
+        return;
+
+   #if JUCE_LINUX || JUCE_MAC
+    munlock(memory, capacity);
+   #endif
+
+    if (mappedBytes > 0)
+    {
+       #if JUCE_LINUX
+        munmap(memory, mappedBytes);
+       #endif
+    }
+    else
+    {
+        freeAligned(memory);
+    }
+
+    memory = nullptr;
+    capacity = 0;
+    mappedBytes = 0;
+    offset = 0;
+    hugePagesInUse = false;
+}
+
+bool ScratchArena::borrowBuffer(juce::AudioBuffer<float>& bufferToReferTo, int numChannels, int numSamples)
+{
+    auto** channels = allocate<float*>(static_cast<size_t>(numChannels));
+    if (channels == nullptr)
+        return false;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        channels[channel] = allocate<float>(static_cast<size_t>(numSamples));
+        if (channels[channel] == nullptr)
+            return false;
+    }
+
+    // The referring overload only copies the channel pointers into preallocated space
+    bufferToReferTo.setDataToReferTo(channels, numChannels, numSamples);
+    return true;
+}
+
+} // namespace DynamicEQ
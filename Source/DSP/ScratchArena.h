@@ -0,0 +1,91 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+#include <cstddef>
+
+// Back the arena with huge pages where the OS allows it (set via the VTR_SCRATCH_HUGE_PAGES CMake option)
+#ifndef VTR_SCRATCH_USE_HUGE_PAGES
+ #define VTR_SCRATCH_USE_HUGE_PAGES 0
+#endif
+
+namespace DynamicEQ {
+
+/**
+ * Preallocated scratch memory for the audio thread
+ * Sized once in prepareToPlay, then borrowed from with a bump pointer so processBlock never touches the heap
+ */
+class ScratchArena
+{
+public:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    ScratchArena() = default;
+    ~ScratchArena();
+
+    // Setup (message thread only - allocates)
+    void prepare(size_t bytesNeeded, bool useHugePages = false);
+    void release();
+
+    // Real-time borrowing - returns nullptr when the arena is exhausted
+    template <typename ElementType>
+    ElementType* allocate(size_t numElements)
+    {
+        const size_t bytes = alignUp(numElements * sizeof(ElementType));
+        if (memory == nullptr || offset + bytes > capacity)
+            return nullptr;
+
+        auto* result = reinterpret_cast<ElementType*>(memory + offset);
+        offset += bytes;
+        highWaterMark = juce::jmax(highWaterMark, offset);
+        return result;
+    }
+
+    // Borrow a multi-channel buffer that refers to arena memory (no heap allocation)
+    bool borrowBuffer(juce::AudioBuffer<float>& bufferToReferTo, int numChannels, int numSamples);
+
+    // Called at the top of every processBlock
+    void reset() noexcept { offset = 0; }
+
+    size_t getCapacity() const noexcept { return capacity; }
+    size_t getBytesUsed() const noexcept { return offset; }
+    size_t getHighWaterMark() const noexcept { return highWaterMark; }
+    bool isUsingHugePages() const noexcept { return hugePagesInUse; }
+
+    // Sizing helpers for prepareToPlay
+    static size_t alignUp(size_t bytes) noexcept { return (bytes + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1); }
+    static size_t bytesForBuffer(int numChannels, int numSamples) noexcept
+    {
+        return alignUp(sizeof(float*) * static_cast<size_t>(numChannels))
+             + static_cast<size_t>(numChannels) * alignUp(sizeof(float) * static_cast<size_t>(numSamples));
+    }
+
+    /**
+     * Restores the arena offset on destruction so a stage can borrow temporarily
+     * without holding memory for the rest of the block
+     */
+    class ScopedFrame
+    {
+    public:
+        explicit ScopedFrame(ScratchArena& arenaToUse) noexcept : arena(arenaToUse), savedOffset(arenaToUse.offset) {}
+        ~ScopedFrame() noexcept { arena.offset = savedOffset; }
+
+    private:
+        ScratchArena& arena;
+        size_t savedOffset;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedFrame)
+    };
+
+private:
+    char* memory = nullptr;
+    size_t capacity = 0;
+    size_t mappedBytes = 0;
+    size_t offset = 0;
+    size_t highWaterMark = 0;
+    bool hugePagesInUse = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScratchArena)
+};
+
+} // namespace DynamicEQ
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace DynamicEQ {
+
+/**
+ * Lock-free single-writer / multi-reader snapshot of a small trivially copyable value
+ * The writer never waits; a reader that overlaps a write simply retries. The payload is kept in
+ * relaxed atomic words so the overlapping copy is not a data race.
+ */
+template <typename ValueType>
+class SeqLock
+{
+public:
+    static_assert(std::is_trivially_copyable<ValueType>::value, "SeqLock values are copied bytewise");
+
+    // Holds a default value from the start, but reports version 0 until the first real store
+    SeqLock() noexcept { store(ValueType{}); sequence.store(0, std::memory_order_relaxed); }
+
+    // Writer thread only
+    void store(const ValueType& value) noexcept
+    {
+        std::array<std::uint32_t, NUM_WORDS> words {};
+        std::memcpy(words.data(), &value, sizeof(ValueType));
+
+        const std::uint32_t start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+            data[i].store(words[i], std::memory_order_relaxed);
+
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    // Any thread
+    ValueType load() const noexcept
+    {
+        std::array<std::uint32_t, NUM_WORDS> words {};
+
+        for (;;)
+        {
+            const std::uint32_t before = sequence.load(std::memory_order_acquire);
+            if ((before & 1) != 0)
+                continue;
+
+            for (size_t i = 0; i < NUM_WORDS; ++i)
+                words[i] = data[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before)
+                break;
+        }
+
+        ValueType value;
+        std::memcpy(&value, words.data(), sizeof(ValueType));
+        return value;
+    }
+
+    // Changes on every store - 0 until the first one, so readers can tell nothing has been published yet
+    std::uint32_t getVersion() const noexcept { return sequence.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t NUM_WORDS = (sizeof(ValueType) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+
+    std::atomic<std::uint32_t> sequence { 0 };
+    std::array<std::atomic<std::uint32_t>, NUM_WORDS> data {};
+};
+
+} // namespace DynamicEQ
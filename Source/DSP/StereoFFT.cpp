@@ -0,0 +1,68 @@
+#include "StereoFFT.h"
+#include <array>
+#include <mutex>
+
+namespace DynamicEQ {
+
+namespace
+{
+    constexpr int MAX_WINDOW_ORDER = 16;
+}
+
+StereoFFT::StereoFFT(int orderToUse)
+    : order(orderToUse),
+      size(1 << orderToUse),
+      fft(orderToUse),
+      window(getHannWindow(orderToUse)),
+      timeData(static_cast<size_t>(size)),
+      frequencyData(static_cast<size_t>(size))
+{
+}
+
+const std::vector<float>& StereoFFT::getHannWindow(int windowOrder)
+{
+    static std::array<std::vector<float>, MAX_WINDOW_ORDER + 1> tables;
+    static std::mutex tablesMutex;
+
+    jassert(windowOrder >= 0 && windowOrder <= MAX_WINDOW_ORDER);
+    windowOrder = juce::jlimit(0, MAX_WINDOW_ORDER, windowOrder);
+
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    auto& table = tables[static_cast<size_t>(windowOrder)];
+
+    if (table.empty())
+    {
+        // Periodic Hann so overlapped frames sum to a constant
+        const int windowSize = 1 << windowOrder;
+        table.resize(static_cast<size_t>(windowSize));
+        for (int i = 0; i < windowSize; ++i)
+            table[static_cast<size_t>(i)] = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / windowSize));
+    }
+
+    return table;
+}
+
+void StereoFFT::perform(const float* first, const float* second, float magnitudeScale,
+                        float* firstDb, float* secondDb) noexcept
+{
+    for (int i = 0; i < size; ++i)
+        timeData[static_cast<size_t>(i)] = { first[i] * window[static_cast<size_t>(i)],
+                                             second[i] * window[static_cast<size_t>(i)] };
+
+    fft.perform(timeData.data(), frequencyData.data(), false);
+
+    // X[k] = (Z[k] + conj(Z[N-k])) / 2,  Y[k] = (Z[k] - conj(Z[N-k])) / 2j
+    const int numBins = size / 2;
+    const float halfScale = 0.5f * magnitudeScale;
+    for (int k = 0; k < numBins; ++k)
+    {
+        const auto z = frequencyData[static_cast<size_t>(k)];
+        const auto zMirror = std::conj(frequencyData[static_cast<size_t>((size - k) & (size - 1))]);
+
+        // Convert to dB with floor to prevent log(0)
+        firstDb[k] = juce::Decibels::gainToDecibels(std::abs(z + zMirror) * halfScale, -120.0f);
+        secondDb[k] = juce::Decibels::gainToDecibels(std::abs(z - zMirror) * halfScale, -120.0f);
+    }
+}
+
+} // namespace DynamicEQ
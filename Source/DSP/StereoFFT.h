@@ -0,0 +1,38 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <complex>
+#include <vector>
+
+namespace DynamicEQ {
+
+/**
+ * Magnitude spectra of two real frames from a single complex FFT
+ * The frames are packed as z = w * (a + j * b) and separated again by conjugate symmetry
+ */
+class StereoFFT
+{
+public:
+    explicit StereoFFT(int order);
+
+    int getOrder() const noexcept { return order; }
+    int getSize() const noexcept { return size; }
+
+    // Writes size / 2 dB values per stream, floored at -120 dB
+    void perform(const float* first, const float* second, float magnitudeScale,
+                 float* firstDb, float* secondDb) noexcept;
+
+    // Periodic Hann table for an FFT order, built once per process and shared
+    static const std::vector<float>& getHannWindow(int order);
+
+private:
+    int order;
+    int size;
+    juce::dsp::FFT fft;
+    const std::vector<float>& window;
+    std::vector<std::complex<float>> timeData, frequencyData;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StereoFFT)
+};
+
+} // namespace DynamicEQ
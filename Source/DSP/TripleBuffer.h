@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace DynamicEQ {
+
+/**
+ * Lock-free single-writer / single-reader triple buffer
+ * The writer fills its private slot and publishes it; the reader always gets the newest
+ * complete slot. Neither side blocks or allocates, and a slow reader simply skips frames.
+ */
+template <typename ElementType>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Writer thread only
+    ElementType& getWriteBuffer() noexcept { return buffers[static_cast<size_t>(writeIndex)]; }
+
+    void publish() noexcept
+    {
+        const int previous = middle.exchange(writeIndex | NEW_DATA_FLAG, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Reader thread only - the reference stays valid until the next acquire()
+    const ElementType& acquire() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & NEW_DATA_FLAG) != 0)
+        {
+            const int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+            readIndex = previous & INDEX_MASK;
+        }
+
+        return buffers[static_cast<size_t>(readIndex)];
+    }
+
+    bool hasNewData() const noexcept { return (middle.load(std::memory_order_relaxed) & NEW_DATA_FLAG) != 0; }
+
+private:
+    static constexpr int INDEX_MASK = 0x3;
+    static constexpr int NEW_DATA_FLAG = 0x4;
+
+    std::array<ElementType, 3> buffers {};
+    int writeIndex = 0;
+    std::atomic<int> middle { 1 };
+    int readIndex = 2;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+};
+
+} // namespace DynamicEQ
@@ -5,9 +5,6 @@
 FrequencyResponseDisplay::FrequencyResponseDisplay(SpectrumAnalyzer& analyzer)
     : spectrumAnalyzer(analyzer), audioProcessor(nullptr)
 {
-    // Start timer for 30Hz updates
-    startTimer(static_cast<int>(1000.0f / UPDATE_RATE_HZ));
-    
     // Initialize EQ points
     for (int i = 0; i < 5; ++i) {
         eqPoints[i].bandIndex = i;
@@ -18,9 +15,6 @@ FrequencyResponseDisplay::FrequencyResponseDisplay(SpectrumAnalyzer& analyzer)
 FrequencyResponseDisplay::FrequencyResponseDisplay(SpectrumAnalyzer& analyzer, VaclisDynamicEQAudioProcessor& processor)
     : spectrumAnalyzer(analyzer), audioProcessor(&processor)
 {
-    // Start timer for 30Hz updates
-    startTimer(static_cast<int>(1000.0f / UPDATE_RATE_HZ));
-    
     // Initialize EQ points
     for (int i = 0; i < 5; ++i) {
         eqPoints[i].bandIndex = i;
@@ -71,52 +65,10 @@ FrequencyResponseDisplay::~FrequencyResponseDisplay()
 
 void FrequencyResponseDisplay::paint(juce::Graphics& g)
 {
-    // Fill background
-    g.fillAll(backgroundColour);
-    
-    // Draw border
-    g.setColour(gridColour.brighter(0.3f));
-    g.drawRect(getLocalBounds(), 1);
-    
-    // Draw grid and labels
-    drawFrequencyGrid(g);
-    drawMagnitudeGrid(g);
-    drawFrequencyLabels(g);
-    drawMagnitudeLabels(g);
-    
-    // Draw spectrum if visible and data available
-    if (spectrumVisible)
-    {
-        // Save graphics state and create clipping region
-        g.saveState();
-        g.reduceClipRegion(getLocalBounds());
-        
-        // Draw input spectrum
-        if ((displayMode == DisplayMode::Input || displayMode == DisplayMode::Both) && !inputSpectrum.empty())
-        {
-            juce::Path inputPath = createSpectrumPath(inputSpectrum);
-            g.setColour(inputSpectrumColour);
-            g.strokePath(inputPath, juce::PathStrokeType(2.0f));
-        }
-        
-        // Draw output spectrum
-        if ((displayMode == DisplayMode::Output || displayMode == DisplayMode::Both) && !outputSpectrum.empty())
-        {
-            juce::Path outputPath = createSpectrumPath(outputSpectrum);
-            g.setColour(outputSpectrumColour);
-            g.strokePath(outputPath, juce::PathStrokeType(2.0f));
-        }
-        
-        // Restore graphics state
-        g.restoreState();
-    }
-    
-    // Draw EQ curve if enabled and processor available
-    if (showEQCurve && audioProcessor != nullptr)
-    {
-        g.setColour(eqCurveColour.withAlpha(0.8f));
-        g.strokePath(createEQCurvePath(), juce::PathStrokeType(2.0f));
-    }
+    // Both layers are prerendered images - only the band handles are drawn here
+    const auto bounds = getLocalBounds().toFloat();
+    staticLayer.draw(g, bounds);
+    dynamicLayer.draw(g, bounds);
     
     // Draw EQ points
     for (int band = 0; band < 5; ++band)
@@ -141,47 +93,142 @@ void FrequencyResponseDisplay::paint(juce::Graphics& g)
             }
         }
     }
-    
-    // Draw title
-    g.setColour(textColour);
-    g.setFont(12.0f);
-    g.drawText("Frequency Response", getLocalBounds().removeFromTop(15).reduced(5), juce::Justification::centredLeft);
 }
 
 void FrequencyResponseDisplay::resized()
 {
-    // Component resized, paths will be recreated on next paint
+    // One spectrum column per pixel - the analyzer rebuilds its map for the new width
+    columnPath.update(spectrumSubscription, getWidth());
     
     // Update EQ point screen positions after resize
     if (audioProcessor != nullptr)
     {
         updateEQPointScreenPositions();
     }
+    
+    renderStaticLayer();
+    renderDynamicLayer();
+}
+
+void FrequencyResponseDisplay::renderStaticLayer()
+{
+    // Only changes with the size, so it is drawn right here on the message thread
+    staticLayer.renderNow([this](juce::Graphics& g)
+    {
+        g.fillAll(backgroundColour);
+        
+        g.setColour(gridColour.brighter(0.3f));
+        g.drawRect(getLocalBounds(), 1);
+        
+        drawFrequencyGrid(g);
+        drawMagnitudeGrid(g);
+        drawFrequencyLabels(g);
+        drawMagnitudeLabels(g);
+        
+        g.setColour(textColour);
+        g.setFont(12.0f);
+        g.drawText("Frequency Response", getLocalBounds().removeFromTop(15).reduced(5), juce::Justification::centredLeft);
+    });
+}
+
+void FrequencyResponseDisplay::renderDynamicLayer()
+{
+    // Paths are built here from the current frame and parameters; stroking them happens on the render thread
+    juce::Path inputPath, outputPath, eqCurvePath;
+    
+    if (spectrumVisible)
+    {
+        const auto& frame = spectrumAnalyzer.acquireSpectrumFrame();
+        lastSpectrumSequence = frame.sequence;
+        
+        // Column maxima keep narrow peaks visible, as drawing every bin did
+        const auto* columns = columnPath.findColumns(spectrumSubscription, frame);
+        
+        if ((displayMode == DisplayMode::Input || displayMode == DisplayMode::Both) && !frame.inputSpectrum.empty())
+            inputPath = columns != nullptr ? ColumnPath::createPath(columns->inputMax, getLocalBounds().toFloat(), MIN_MAGNITUDE_DB, MAX_MAGNITUDE_DB)
+                                           : createSpectrumPath(frame.inputSpectrum, frame.frequencies);
+        
+        if ((displayMode == DisplayMode::Output || displayMode == DisplayMode::Both) && !frame.outputSpectrum.empty())
+            outputPath = columns != nullptr ? ColumnPath::createPath(columns->outputMax, getLocalBounds().toFloat(), MIN_MAGNITUDE_DB, MAX_MAGNITUDE_DB)
+                                            : createSpectrumPath(frame.outputSpectrum, frame.frequencies);
+    }
+    
+    if (showEQCurve && audioProcessor != nullptr)
+    {
+        eqCurvePath = createEQCurvePath();
+        renderedCurveRevision = curveRevision;
+    }
+    
+    dynamicLayer.render([inputPath, outputPath, eqCurvePath,
+                         clipArea = getLocalBounds(),
+                         inputColour = inputSpectrumColour,
+                         outputColour = outputSpectrumColour,
+                         curveColour = eqCurveColour.withAlpha(0.8f)](juce::Graphics& g)
+    {
+        g.reduceClipRegion(clipArea);
+        
+        g.setColour(inputColour);
+        g.strokePath(inputPath, juce::PathStrokeType(2.0f));
+        
+        g.setColour(outputColour);
+        g.strokePath(outputPath, juce::PathStrokeType(2.0f));
+        
+        g.setColour(curveColour);
+        g.strokePath(eqCurvePath, juce::PathStrokeType(2.0f));
+    });
 }
 
 void FrequencyResponseDisplay::setDisplayMode(DisplayMode mode)
 {
     displayMode = mode;
-    repaint();
+    renderDynamicLayer();
 }
 
 void FrequencyResponseDisplay::setSpectrumVisible(bool visible)
 {
     spectrumVisible = visible;
-    repaint();
+    updateSpectrumSubscription();
+    renderDynamicLayer();
 }
 
-void FrequencyResponseDisplay::timerCallback()
+void FrequencyResponseDisplay::visibilityChanged()
 {
-    updateSpectrumData();
+    updateSpectrumSubscription();
+}
+
+void FrequencyResponseDisplay::updateSpectrumSubscription()
+{
+    // The analyzer only runs its FFTs while some display is showing a spectrum
+    if (spectrumVisible && isVisible())
+    {
+        if (!spectrumSubscription.isActive())
+        {
+            spectrumSubscription = spectrumAnalyzer.subscribe(SpectrumAnalyzer::Consumer::Spectrum);
+            columnPath.update(spectrumSubscription, getWidth());
+        }
+    }
+    else
+    {
+        spectrumSubscription.reset();
+    }
+}
+
+void FrequencyResponseDisplay::refresh(double elapsedSeconds)
+{
+    juce::ignoreUnused(elapsedSeconds);
+    
+    // Hidden behind the spectrogram - pending changes are picked up once shown again
+    if (!isShowing())
+        return;
     
     // Update EQ points from parameters if processor is available
     if (audioProcessor != nullptr)
     {
+        // Re-reads the parameters; only bands that actually changed get re-evaluated
         updateEQPointsFromParameters();
-        // Always invalidate cache to ensure curve updates with parameter changes
-        invalidateResponseCache();
     }
+    
+    updateSpectrumData();
 }
 
 void FrequencyResponseDisplay::parameterChanged(const juce::String& parameterID, float newValue)
@@ -193,6 +240,7 @@ void FrequencyResponseDisplay::parameterChanged(const juce::String& parameterID,
         updateEQPointsFromParameters();
         invalidateResponseCache();
         updateEQPointScreenPositions();
+        eqCurveDirty = true;
         repaint();
         
     }
@@ -200,12 +248,12 @@ void FrequencyResponseDisplay::parameterChanged(const juce::String& parameterID,
 
 void FrequencyResponseDisplay::updateSpectrumData()
 {
-    // Get fresh spectrum data
-    inputSpectrum = spectrumAnalyzer.getInputSpectrum();
-    outputSpectrum = spectrumAnalyzer.getOutputSpectrum();
-    
-    // Trigger repaint
-    repaint();
+    // Only re-render when the analyzer has published a new frame or the EQ curve moved.
+    // The DSP publishes new coefficients a block after a parameter change, hence the revision check
+    const bool newFrame = spectrumVisible && spectrumAnalyzer.getSpectrumSequence() != lastSpectrumSequence;
+    const bool curveMoved = showEQCurve && curveRevision != renderedCurveRevision;
+    if (eqCurveDirty.exchange(false) || newFrame || curveMoved)
+        renderDynamicLayer();
 }
 
 void FrequencyResponseDisplay::drawFrequencyGrid(juce::Graphics& g)
@@ -281,7 +329,7 @@ void FrequencyResponseDisplay::drawMagnitudeLabels(juce::Graphics& g)
     }
 }
 
-juce::Path FrequencyResponseDisplay::createSpectrumPath(const std::vector<float>& spectrum)
+juce::Path FrequencyResponseDisplay::createSpectrumPath(const std::vector<float>& spectrum, const std::vector<float>& frequencies)
 {
     juce::Path path;
     
@@ -291,11 +339,11 @@ juce::Path FrequencyResponseDisplay::createSpectrumPath(const std::vector<float>
     // Start path
     bool pathStarted = false;
     
-    // Convert spectrum data to path
-    for (size_t i = 1; i < spectrum.size(); ++i) // Skip DC component
+    // Convert spectrum data to path - frequencies come from the analyzer (linear bins or its log grid)
+    const size_t numPoints = juce::jmin(spectrum.size(), frequencies.size());
+    for (size_t i = 0; i < numPoints; ++i)
     {
-        // Calculate frequency for this bin
-        const float frequency = (static_cast<float>(i) * static_cast<float>(spectrumAnalyzer.getSampleRate())) / (2.0f * SpectrumAnalyzer::FFT_SIZE);
+        const float frequency = frequencies[i];
         
         // Skip frequencies outside our range
         if (frequency < MIN_FREQUENCY || frequency > MAX_FREQUENCY)
@@ -391,6 +439,7 @@ void FrequencyResponseDisplay::mouseDrag(const juce::MouseEvent& event)
         // Update all points to follow the new curve
         invalidateResponseCache();
         updateEQPointScreenPositions();
+        renderDynamicLayer();
         repaint();
     }
 }
@@ -538,6 +587,7 @@ void FrequencyResponseDisplay::updateEQPointsFromParameters()
     }
     
     // Update screen positions based on actual combined response
+    invalidateResponseCache();
     updateEQPointScreenPositions();
 }
 
@@ -577,103 +627,143 @@ juce::Path FrequencyResponseDisplay::createEQCurvePath()
 
 std::vector<float> FrequencyResponseDisplay::calculateBandResponse(int bandIndex, int numPoints)
 {
-    std::vector<float> response(numPoints, 0.0f);
-    
     if (audioProcessor == nullptr || bandIndex < 0 || bandIndex >= 5)
-        return response;
-        
-    // Check if band is enabled
-    juce::String enableParamID = "eq_enable_band" + juce::String(bandIndex);
-    auto* enableParam = audioProcessor->getValueTreeState().getParameter(enableParamID);
-    if (!enableParam || enableParam->getValue() < 0.5f)
-        return response; // Band is disabled, return flat response
+        return std::vector<float>(static_cast<size_t>(numPoints), 0.0f);
     
-    // Get current band parameters
-    auto& point = eqPoints[bandIndex];
+    if (!responseCacheValid || static_cast<int>(cachedCombinedResponse.size()) != numPoints)
+        updateBandCurves(numPoints);
     
-    // Get filter type from parameter
-    DynamicEQ::FilterType filterType = DynamicEQ::FilterType::Bell; // Default
-    juce::String typeParamID = "eq_type_band" + juce::String(bandIndex);
-    if (auto* typeParam = audioProcessor->getValueTreeState().getParameter(typeParamID))
-    {
-        int typeIndex = static_cast<int>(typeParam->getValue() * 4.99f); // 0-4 range
-        filterType = static_cast<DynamicEQ::FilterType>(typeIndex);
-    }
+    const auto& curve = bandCurves[static_cast<size_t>(bandIndex)];
+    if (!curve.enabled)
+        return std::vector<float>(static_cast<size_t>(numPoints), 0.0f); // Band is disabled, return flat response
     
-    const float sampleRate = 48000.0f; // Assume 48kHz for visualization
+    return curve.responseDB;
+}
+
+std::vector<float> FrequencyResponseDisplay::calculateCombinedEQResponse(int numPoints)
+{
+    if (audioProcessor == nullptr)
+        return std::vector<float>(static_cast<size_t>(numPoints), 0.0f);
     
-    // Calculate response for each frequency point
-    for (int i = 0; i < numPoints; ++i)
-    {
-        float freq = MIN_FREQUENCY * std::pow(MAX_FREQUENCY / MIN_FREQUENCY, (float)i / (numPoints - 1));
-        float magnitude = 0.0f;
-        
-        // Calculate different filter responses based on type
-        switch (filterType)
-        {
-            case DynamicEQ::FilterType::Bell:
-                magnitude = calculateBellResponse(freq, point.frequency, point.gainDB, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::HighShelf:
-                magnitude = calculateHighShelfResponse(freq, point.frequency, point.gainDB, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::LowShelf:
-                magnitude = calculateLowShelfResponse(freq, point.frequency, point.gainDB, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::HighPass:
-                magnitude = calculateHighPassResponse(freq, point.frequency, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::LowPass:
-                magnitude = calculateLowPassResponse(freq, point.frequency, point.Q);
-                break;
-                
-            default:
-                magnitude = 0.0f;
-                break;
-        }
-        
-        response[i] = magnitude;
-    }
+    // Only bands whose settings changed since the last call are re-evaluated
+    if (!responseCacheValid || static_cast<int>(cachedCombinedResponse.size()) != numPoints)
+        updateBandCurves(numPoints);
     
-    return response;
+    return cachedCombinedResponse;
 }
 
-std::vector<float> FrequencyResponseDisplay::calculateCombinedEQResponse(int numPoints)
+bool FrequencyResponseDisplay::BandSettings::operator==(const BandSettings& other) const noexcept
 {
-    std::vector<float> combinedResponse(numPoints, 0.0f);
+    return enabled == other.enabled && type == other.type && frequency == other.frequency
+        && gainDB == other.gainDB && q == other.q;
+}
+
+FrequencyResponseDisplay::BandSettings FrequencyResponseDisplay::readBandSettings(int bandIndex) const
+{
+    BandSettings settings;
+    auto& apvts = audioProcessor->getValueTreeState();
     
-    if (audioProcessor == nullptr)
-        return combinedResponse;
+    // Check if band is enabled
+    if (auto* enableParam = apvts.getParameter("eq_enable_band" + juce::String(bandIndex)))
+        settings.enabled = enableParam->getValue() >= 0.5f;
+    
+    // Get filter type from parameter
+    if (auto* typeParam = apvts.getParameter("eq_type_band" + juce::String(bandIndex)))
+        settings.type = static_cast<DynamicEQ::FilterType>(static_cast<int>(typeParam->getValue() * 4.99f)); // 0-4 range
     
-    // Check if we can use cached response
-    if (responseCacheValid && cachedCombinedResponse.size() == numPoints)
-        return cachedCombinedResponse;
+    // Frequency, gain and Q follow the handle, which may be ahead of the parameters while dragging
+    const auto& point = eqPoints[static_cast<size_t>(bandIndex)];
+    settings.frequency = point.frequency;
+    settings.gainDB = point.gainDB;
+    settings.q = point.Q;
+    
+    return settings;
+}
+
+double FrequencyResponseDisplay::getDisplaySampleRate() const
+{
+    // Drawn at the processor's rate so the curve shows the same cramping near Nyquist as the filters
+    const double sampleRate = audioProcessor != nullptr ? audioProcessor->getSampleRate() : 0.0;
+    return sampleRate > 0.0 ? sampleRate : 48000.0;
+}
+
+void FrequencyResponseDisplay::updateBandCurves(int numPoints)
+{
+    const double sampleRate = getDisplaySampleRate();
+    bool combinedChanged = static_cast<int>(cachedCombinedResponse.size()) != numPoints;
+    
+    if (!responseGrid.matches(numPoints, MIN_FREQUENCY, MAX_FREQUENCY, sampleRate))
+    {
+        responseGrid.prepare(numPoints, MIN_FREQUENCY, MAX_FREQUENCY, sampleRate);
+        for (auto& curve : bandCurves)
+            curve.valid = false;
+    }
+    
+    const auto& multiBandEQ = audioProcessor->getMultiBandEQ();
     
-    // Calculate combined response by summing all enabled bands
     for (int band = 0; band < 5; ++band)
     {
-        // Check if band is enabled
-        juce::String enableParamID = "eq_enable_band" + juce::String(band);
-        auto* enableParam = audioProcessor->getValueTreeState().getParameter(enableParamID);
-        if (enableParam && enableParam->getValue() >= 0.5f)
+        auto& curve = bandCurves[static_cast<size_t>(band)];
+        const auto* eqBand = multiBandEQ.getBand(band);
+        const uint32_t version = eqBand != nullptr ? eqBand->getResponseVersion() : 0;
+        const auto settings = readBandSettings(band);
+        
+        // A snapshot that was already there when the display started is taken to match the parameters;
+        // after a change only a newer one does
+        if (!curve.hasObservedSettings || settings != curve.observedSettings)
         {
-            auto bandResponse = calculateBandResponse(band, numPoints);
-            for (int i = 0; i < numPoints; ++i)
-            {
-                combinedResponse[i] += bandResponse[i];
-            }
+            curve.settingsChangedAtVersion = curve.hasObservedSettings ? version : 0;
+            curve.observedSettings = settings;
+            curve.hasObservedSettings = true;
         }
+        
+        if (version != 0 && version != curve.settingsChangedAtVersion)
+        {
+            // Exactly the biquad the audio thread is running, including its clamping and solo state
+            if (curve.valid && curve.publishedVersion == version)
+                continue;
+            
+            const auto state = eqBand->getResponseState();
+            curve.publishedVersion = version;
+            curve.enabled = state.active;
+            curve.coefficients = state.coefficients;
+        }
+        else
+        {
+            // Nothing processed since the parameters last moved - derive the filter from them instead
+            if (curve.valid && curve.publishedVersion == 0 && settings == curve.settings)
+                continue;
+            
+            curve.settings = settings;
+            curve.publishedVersion = 0;
+            curve.enabled = settings.enabled;
+            curve.coefficients = DynamicEQ::BiquadCoefficients::forFilter(settings.type, settings.frequency, settings.gainDB,
+                                                                          settings.q, sampleRate);
+        }
+        
+        curve.valid = true;
+        combinedChanged = true;
+        
+        // Disabled bands skip the evaluation
+        if (!curve.enabled)
+            continue;
+        
+        curve.responseDB.resize(static_cast<size_t>(numPoints));
+        responseGrid.evaluate(curve.coefficients, curve.responseDB.data());
     }
     
-    // Cache the result
-    cachedCombinedResponse = combinedResponse;
-    responseCacheValid = true;
+    if (combinedChanged)
+    {
+        // Calculate combined response by summing all enabled bands
+        cachedCombinedResponse.assign(static_cast<size_t>(numPoints), 0.0f);
+        for (const auto& curve : bandCurves)
+            if (curve.enabled)
+                juce::FloatVectorOperations::add(cachedCombinedResponse.data(), curve.responseDB.data(), numPoints);
+        
+        ++curveRevision;
+    }
     
-    return combinedResponse;
+    responseCacheValid = true;
 }
 
 // Coordinate conversion helpers
@@ -740,163 +830,15 @@ float FrequencyResponseDisplay::getActualGainAtFrequency(float frequency)
 {
     if (audioProcessor == nullptr)
         return 0.0f;
-        
-    float totalGain = 0.0f;
-    
-    // Calculate contribution from each active band
-    for (int band = 0; band < 5; ++band)
-    {
-        // Check if band is enabled
-        juce::String enableParamID = "eq_enable_band" + juce::String(band);
-        auto* enableParam = audioProcessor->getValueTreeState().getParameter(enableParamID);
-        if (!enableParam || enableParam->getValue() < 0.5f)
-            continue; // Band is disabled
-            
-        auto& point = eqPoints[band];
-        
-        // Get filter type
-        DynamicEQ::FilterType filterType = DynamicEQ::FilterType::Bell;
-        juce::String typeParamID = "eq_type_band" + juce::String(band);
-        if (auto* typeParam = audioProcessor->getValueTreeState().getParameter(typeParamID))
-        {
-            int typeIndex = static_cast<int>(typeParam->getValue() * 4.99f);
-            filterType = static_cast<DynamicEQ::FilterType>(typeIndex);
-        }
-        
-        // Calculate filter response at the given frequency
-        float bandGain = 0.0f;
-        switch (filterType)
-        {
-            case DynamicEQ::FilterType::Bell:
-                bandGain = calculateBellResponse(frequency, point.frequency, point.gainDB, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::HighShelf:
-                bandGain = calculateHighShelfResponse(frequency, point.frequency, point.gainDB, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::LowShelf:
-                bandGain = calculateLowShelfResponse(frequency, point.frequency, point.gainDB, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::HighPass:
-                bandGain = calculateHighPassResponse(frequency, point.frequency, point.Q);
-                break;
-                
-            case DynamicEQ::FilterType::LowPass:
-                bandGain = calculateLowPassResponse(frequency, point.frequency, point.Q);
-                break;
-        }
-        
-        totalGain += bandGain;
-    }
-    
-    return totalGain;
-}
-
-// Filter response calculation methods
-float FrequencyResponseDisplay::calculateBellResponse(float freq, float centerFreq, float gainDB, float Q) const
-{
-    if (std::abs(gainDB) < 0.01f) return 0.0f; // No gain, no response
     
-    // Use chowdsp's actual bell filter response
-    chowdsp::EQ::BellPlot bellPlot;
-    bellPlot.setCutoffFrequency(centerFreq);
-    bellPlot.setGainDecibels(gainDB);
-    bellPlot.setQValue(Q);
+    if (!responseCacheValid)
+        updateBandCurves(CURVE_RESOLUTION);
     
-    // Get the actual magnitude response and convert to dB
-    float magnitude = bellPlot.getMagnitudeForFrequency(freq);
-    return juce::Decibels::gainToDecibels(magnitude);
-}
-
-float FrequencyResponseDisplay::calculateHighShelfResponse(float freq, float cutoffFreq, float gainDB, float Q) const
-{
-    if (std::abs(gainDB) < 0.01f) return 0.0f;
-    
-    // Manual high shelf calculation (corrected)
-    const float omega = freq / cutoffFreq;
-    const float A = std::pow(10.0f, gainDB / 40.0f); // Convert dB to linear amplitude
-    
-    // High shelf: gain at high frequencies, unity at low frequencies
-    if (omega >= 4.0f) // High frequencies
-    {
-        return gainDB; // Full gain
-    }
-    else if (omega <= 0.25f) // Low frequencies
-    {
-        return 0.0f; // Unity gain (0dB)
-    }
-    else // Transition region
-    {
-        const float logOmega = std::log2(omega);
-        const float sharpness = Q * 0.5f; // Q controls transition sharpness
-        const float transition = 0.5f * (1.0f + std::tanh(logOmega * sharpness));
-        return gainDB * transition;
-    }
-}
-
-float FrequencyResponseDisplay::calculateLowShelfResponse(float freq, float cutoffFreq, float gainDB, float Q) const
-{
-    if (std::abs(gainDB) < 0.01f) return 0.0f;
-    
-    // Manual low shelf calculation (corrected)
-    const float omega = freq / cutoffFreq;
-    const float A = std::pow(10.0f, gainDB / 40.0f); // Convert dB to linear amplitude
-    
-    // Low shelf: gain at low frequencies, unity at high frequencies
-    if (omega <= 0.25f) // Low frequencies
-    {
-        return gainDB; // Full gain
-    }
-    else if (omega >= 4.0f) // High frequencies
-    {
-        return 0.0f; // Unity gain (0dB)
-    }
-    else // Transition region
-    {
-        const float logOmega = std::log2(omega);
-        const float sharpness = Q * 0.5f; // Q controls transition sharpness
-        const float transition = 0.5f * (1.0f - std::tanh(logOmega * sharpness));
-        return gainDB * transition;
-    }
-}
-
-float FrequencyResponseDisplay::calculateHighPassResponse(float freq, float cutoffFreq, float Q) const
-{
-    // Proper 2nd order high-pass filter response
-    const float omega = freq / cutoffFreq;
-    const float omega2 = omega * omega;
-    
-    // Standard 2nd order high-pass transfer function: H(s) = s^2 / (s^2 + s/Q + 1)
-    // At s = jω, |H(jω)|^2 = ω^4 / (ω^4 + ω^2/Q^2 + 1)
-    const float numerator = omega2 * omega2;
-    const float denominator = numerator + (omega2 / (Q * Q)) + 1.0f;
-    
-    const float magnitude_squared = numerator / denominator;
+    // Sum the contribution of each active band, straight from its cached coefficients
+    float totalGain = 0.0f;
+    for (const auto& curve : bandCurves)
+        if (curve.enabled)
+            totalGain += curve.coefficients.getMagnitudeDB(frequency, responseGrid.getSampleRate());
     
-    // Convert to dB
-    if (magnitude_squared > 1e-10f)
-        return 10.0f * std::log10(magnitude_squared);
-    else
-        return -100.0f; // Very low magnitude
+    return totalGain;
 }
-
-float FrequencyResponseDisplay::calculateLowPassResponse(float freq, float cutoffFreq, float Q) const
-{
-    // Proper 2nd order low-pass filter response
-    const float omega = freq / cutoffFreq;
-    const float omega2 = omega * omega;
-    
-    // Standard 2nd order low-pass transfer function: H(s) = 1 / (s^2 + s/Q + 1)
-    // At s = jω, |H(jω)|^2 = 1 / (ω^4 + ω^2/Q^2 + 1)
-    const float denominator = omega2 * omega2 + (omega2 / (Q * Q)) + 1.0f;
-    
-    const float magnitude_squared = 1.0f / denominator;
-    
-    // Convert to dB
-    if (magnitude_squared > 1e-10f)
-        return 10.0f * std::log10(magnitude_squared);
-    else
-        return -100.0f; // Very low magnitude
-}
\ No newline at end of file
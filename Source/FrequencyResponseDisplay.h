@@ -2,12 +2,15 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "SpectrumAnalyzer.h"
-#include <chowdsp_visualizers/chowdsp_visualizers.h>
+#include "ColumnPath.h"
+#include "VisualizerRenderer.h"
+#include "RefreshScheduler.h"
+#include "DSP/BiquadResponse.h"
 
 class VaclisDynamicEQAudioProcessor;
 
 class FrequencyResponseDisplay : public juce::Component, 
-                               private juce::Timer,
+                               public RefreshScheduler::Client,
                                private juce::AudioProcessorValueTreeState::Listener
 {
 public:
@@ -37,6 +40,7 @@ public:
     
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void visibilityChanged() override;
     
     void setDisplayMode(DisplayMode mode);
     void setSpectrumVisible(bool visible);
@@ -56,36 +60,36 @@ public:
     
     // EQ curve calculation methods
     juce::Path createEQCurvePath();
-    std::vector<float> calculateBandResponse(int bandIndex, int numPoints = 512);
-    std::vector<float> calculateCombinedEQResponse(int numPoints = 512);
-    
-    // Filter response calculation methods
-    float calculateBellResponse(float freq, float centerFreq, float gainDB, float Q) const;
-    float calculateHighShelfResponse(float freq, float cutoffFreq, float gainDB, float Q) const;
-    float calculateLowShelfResponse(float freq, float cutoffFreq, float gainDB, float Q) const;
-    float calculateHighPassResponse(float freq, float cutoffFreq, float Q) const;
-    float calculateLowPassResponse(float freq, float cutoffFreq, float Q) const;
+    std::vector<float> calculateBandResponse(int bandIndex, int numPoints = CURVE_RESOLUTION);
+    std::vector<float> calculateCombinedEQResponse(int numPoints = CURVE_RESOLUTION);
     
     // Coordinate conversion helpers
     float xToFrequency(float x) const;
     float yToGainDB(float y) const;
     
 private:
-    void timerCallback() override;
+    void refresh(double elapsedSeconds) override;
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     void updateSpectrumData();
+    void updateSpectrumSubscription();
+    
+    // Layered rendering - the grid is cached, spectrum and EQ curve are rasterized in the background
+    void renderStaticLayer();
+    void renderDynamicLayer();
     
     void drawFrequencyGrid(juce::Graphics& g);
     void drawMagnitudeGrid(juce::Graphics& g);
     void drawFrequencyLabels(juce::Graphics& g);
     void drawMagnitudeLabels(juce::Graphics& g);
     
-    juce::Path createSpectrumPath(const std::vector<float>& spectrum);
+    juce::Path createSpectrumPath(const std::vector<float>& spectrum, const std::vector<float>& frequencies);
     
     float frequencyToX(float frequency) const;
     float magnitudeToY(float magnitudeDB) const;
     
     SpectrumAnalyzer& spectrumAnalyzer;
+    SpectrumAnalyzer::Subscription spectrumSubscription; // held while the spectrum is shown
+    ColumnPath columnPath { MIN_FREQUENCY, MAX_FREQUENCY, SPECTRUM_SMOOTHING_OCTAVES }; // one column per pixel
     VaclisDynamicEQAudioProcessor* audioProcessor;
     
     // Display settings
@@ -102,20 +106,64 @@ private:
     bool showEQCurve = true;
     bool showIndividualBands = false;
     
-    // Curve calculation cache
+    // Curve calculation cache - each band keeps its own response and is only re-evaluated when it changes.
+    // Bands follow the coefficients the DSP publishes, unless the parameters have moved since its last
+    // snapshot (before audio has run, while dragging, or with the audio stopped)
+    struct BandSettings
+    {
+        bool enabled = false;
+        DynamicEQ::FilterType type = DynamicEQ::FilterType::Bell;
+        float frequency = 0.0f;
+        float gainDB = 0.0f;
+        float q = 0.0f;
+        
+        bool operator==(const BandSettings& other) const noexcept;
+        bool operator!=(const BandSettings& other) const noexcept { return !(*this == other); }
+    };
+    
+    struct BandCurve
+    {
+        BandSettings settings;           // parameter fallback key
+        uint32_t publishedVersion = 0;   // DSP snapshot key, 0 while using the fallback
+        
+        // The parameters as last read, and the DSP version current when they changed - only a snapshot
+        // published after that reflects them
+        BandSettings observedSettings;
+        uint32_t settingsChangedAtVersion = 0;
+        bool hasObservedSettings = false;
+        bool enabled = false;
+        DynamicEQ::BiquadCoefficients coefficients;
+        std::vector<float> responseDB;
+        bool valid = false;
+    };
+    
+    BandSettings readBandSettings(int bandIndex) const;
+    void updateBandCurves(int numPoints);
+    double getDisplaySampleRate() const;
+    
+    std::array<BandCurve, 5> bandCurves;
+    DynamicEQ::BiquadResponseGrid responseGrid;
     std::vector<float> cachedCombinedResponse;
-    bool responseCacheValid = false;
+    bool responseCacheValid = false; // false = re-read band settings before the next use
+    uint32_t curveRevision = 0;         // bumped whenever the combined curve changes
+    uint32_t renderedCurveRevision = 0; // revision the dynamic layer last drew
+    
+    // Sequence number of the last spectrum frame drawn
+    uint64_t lastSpectrumSequence = 0;
+    
+    // Set by parameter listeners (any thread) so the next tick re-renders the EQ curve
+    std::atomic<bool> eqCurveDirty { true };
     
-    // Spectrum data
-    std::vector<float> inputSpectrum;
-    std::vector<float> outputSpectrum;
+    VisualizerRenderer::Layer staticLayer { *this };  // background, grid, labels
+    VisualizerRenderer::Layer dynamicLayer { *this }; // spectrum and EQ curve; band handles stay live
     
     // Visual parameters
     static constexpr float MIN_FREQUENCY = 20.0f;
     static constexpr float MAX_FREQUENCY = 20000.0f;
     static constexpr float MIN_MAGNITUDE_DB = -24.0f;
     static constexpr float MAX_MAGNITUDE_DB = 12.0f;
-    static constexpr float UPDATE_RATE_HZ = 30.0f;
+    static constexpr int CURVE_RESOLUTION = 512;
+    static constexpr float SPECTRUM_SMOOTHING_OCTAVES = 0.0f; // e.g. 1.0f / 6.0f for sixth-octave smoothing
     
     // Grid parameters
     static constexpr int FREQUENCY_GRID_LINES = 10; // 20Hz, 50Hz, 100Hz, 200Hz, 500Hz, 1kHz, 2kHz, 5kHz, 10kHz, 20kHz
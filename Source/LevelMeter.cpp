@@ -2,8 +2,6 @@
 
 LevelMeter::LevelMeter()
 {
-    // Start timer for updates
-    startTimer(static_cast<int>(1000.0f / UPDATE_RATE_HZ));
 }
 
 void LevelMeter::paint(juce::Graphics& g)
@@ -21,6 +19,8 @@ void LevelMeter::paint(juce::Graphics& g)
     // Get current levels
     float currentDB = currentLevel.load();
     float peakDB = peakLevel.load();
+    paintedLevel = currentDB;
+    paintedPeak = peakDB;
     
     // Calculate positions
     float currentPos = dbToPosition(currentDB);
@@ -91,14 +91,19 @@ void LevelMeter::updateLevel(float newLevel)
     // Convert to dB
     float levelDB = newLevel > 0.0f ? juce::Decibels::gainToDecibels(newLevel) : -60.0f;
     
+    updateLevels(levelDB, levelDB);
+}
+
+void LevelMeter::updateLevels(float levelDB, float peakDB)
+{
     // Update current level
-    currentLevel.store(levelDB);
+    currentLevel.store(juce::jmax(levelDB, -60.0f));
     
     // Update peak hold
     float currentPeakDB = peakLevel.load();
-    if (levelDB > currentPeakDB)
+    if (peakDB > currentPeakDB)
     {
-        peakLevel.store(levelDB);
+        peakLevel.store(peakDB);
         peakHoldTime = PEAK_HOLD_SECONDS;
     }
 }
@@ -116,34 +121,27 @@ void LevelMeter::setRange(float minDecibels, float maxDecibels)
     repaint();
 }
 
-void LevelMeter::timerCallback()
+void LevelMeter::refresh(double elapsedSeconds)
 {
-    // Update peak hold decay
+    const float elapsed = static_cast<float>(elapsedSeconds);
+    const float currentLevelDB = currentLevel.load();
+    float currentPeakDB = peakLevel.load();
+    
+    // Hold the peak, then let it fall towards the current level - time based, so the refresh rate doesn't matter
     if (peakHoldTime > 0.0f)
     {
-        peakHoldTime -= (1.0f / UPDATE_RATE_HZ);
-        if (peakHoldTime <= 0.0f)
-        {
-            // Start decaying peak
-            float currentPeakDB = peakLevel.load();
-            float decayedPeak = currentPeakDB - 0.5f; // 0.5dB per update decay
-            peakLevel.store(juce::jmax(decayedPeak, currentLevel.load()));
-        }
+        peakHoldTime -= elapsed;
     }
-    else
+    else if (currentPeakDB > currentLevelDB)
     {
-        // Continue decaying peak
-        float currentPeakDB = peakLevel.load();
-        float currentLevelDB = currentLevel.load();
-        if (currentPeakDB > currentLevelDB)
-        {
-            float decayedPeak = currentPeakDB - 0.3f; // 0.3dB per update decay
-            peakLevel.store(juce::jmax(decayedPeak, currentLevelDB));
-        }
+        currentPeakDB = juce::jmax(currentPeakDB - PEAK_DECAY_DB_PER_SECOND * elapsed, currentLevelDB);
+        peakLevel.store(currentPeakDB);
     }
     
-    // Trigger repaint
-    repaint();
+    // Only repaint when something visible changed
+    const float visibleChangeDB = 0.05f;
+    if (std::abs(currentLevelDB - paintedLevel) > visibleChangeDB || std::abs(currentPeakDB - paintedPeak) > visibleChangeDB)
+        repaint();
 }
 
 float LevelMeter::dbToPosition(float db) const
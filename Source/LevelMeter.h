@@ -3,8 +3,9 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <atomic>
+#include "RefreshScheduler.h"
 
-class LevelMeter : public juce::Component, private juce::Timer
+class LevelMeter : public juce::Component, public RefreshScheduler::Client
 {
 public:
     LevelMeter();
@@ -15,12 +16,15 @@ public:
     // Update level values (called from audio thread)
     void updateLevel(float newLevel);
     
+    // Level bar and peak marker in dB, e.g. from the analyzer's ballistic RMS and peak readings
+    void updateLevels(float levelDB, float peakDB);
+    
     // Configuration
     void setOrientation(bool isHorizontal);
     void setRange(float minDB, float maxDB);
     
 private:
-    void timerCallback() override;
+    void refresh(double elapsedSeconds) override;
     float dbToPosition(float db) const;
     
     // Level data (atomic for thread safety)
@@ -30,7 +34,11 @@ private:
     // Peak hold
     float peakHoldTime = 0.0f;
     static constexpr float PEAK_HOLD_SECONDS = 1.5f;
-    static constexpr float UPDATE_RATE_HZ = 30.0f;
+    static constexpr float PEAK_DECAY_DB_PER_SECOND = 9.0f;
+    
+    // Values last painted, so refresh() only repaints when the bar or peak moved
+    float paintedLevel = -60.0f;
+    float paintedPeak = -60.0f;
     
     // Configuration
     bool horizontal = false;
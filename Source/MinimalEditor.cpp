@@ -73,6 +73,11 @@ MinimalEditor::MinimalEditor(VaclisDynamicEQAudioProcessor& p)
     addAndMakeVisible(*frequencyResponseDisplay);
     DBG("MinimalEditor frequency response display added successfully");
     
+    // Both displays refresh from one vblank-driven tick (no idle detection in this debug editor)
+    refreshScheduler = std::make_unique<RefreshScheduler>(*this, nullptr);
+    refreshScheduler->addClient(*spectrumDisplay);
+    refreshScheduler->addClient(*frequencyResponseDisplay);
+    
     // Step 4: Add one band component (most likely crash point)
     DBG("MinimalEditor adding band component");
     bandComponent = std::make_unique<BandControlComponent>(0, "TEST", audioProcessor);
@@ -4,6 +4,7 @@
 #include "PluginProcessor.h"
 #include "SpectrumDisplay.h"
 #include "FrequencyResponseDisplay.h"
+#include "RefreshScheduler.h"
 #include "DSP/EQBand.h"
 
 // Forward declaration
@@ -40,6 +41,7 @@ private:
     
     // Step 3: Add frequency response display
     std::unique_ptr<FrequencyResponseDisplay> frequencyResponseDisplay;
+    std::unique_ptr<RefreshScheduler> refreshScheduler;
     
     // Step 4: Add one band component (most likely crash point)
     std::unique_ptr<BandControlComponent> bandComponent;
@@ -663,13 +663,6 @@ VaclisDynamicEQAudioProcessorEditor::VaclisDynamicEQAudioProcessorEditor (Vaclis
     frequencyResponseDisplay->setSpectrumVisible(true); // Start visible
     addAndMakeVisible(*frequencyResponseDisplay);
     
-    // Keep old spectrum display for compatibility (not visible by default)
-    spectrumDisplay = std::make_unique<SpectrumDisplay>(audioProcessor.getSpectrumAnalyzer());
-    spectrumDisplay->setDisplayMode(SpectrumDisplay::DisplayMode::Both);
-    spectrumDisplay->setAlpha(0.7f);
-    spectrumDisplay->setVisible(false); // Not used in new design
-    addAndMakeVisible(*spectrumDisplay);
-    
     // Setup level meters
     inputLevelMeter = std::make_unique<LevelMeter>();
     inputLevelMeter->setOrientation(false); // Vertical
@@ -680,6 +673,28 @@ VaclisDynamicEQAudioProcessorEditor::VaclisDynamicEQAudioProcessorEditor (Vaclis
     outputLevelMeter->setOrientation(false); // Vertical  
     outputLevelMeter->setRange(-60.0f, 0.0f);
     addAndMakeVisible(*outputLevelMeter);
+    meterSubscription = audioProcessor.getSpectrumAnalyzer().subscribe(SpectrumAnalyzer::Consumer::Meters);
+    
+    if (auto* ballisticsParameter = dynamic_cast<juce::AudioParameterChoice*>(
+        audioProcessor.getValueTreeState().getParameter("meter_ballistics")))
+    {
+        meterBallisticsCombo.addItemList(ballisticsParameter->choices, 1);
+    }
+    meterBallisticsCombo.setTooltip("Level meter ballistics");
+    addAndMakeVisible(meterBallisticsCombo);
+    meterBallisticsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getValueTreeState(), "meter_ballistics", meterBallisticsCombo);
+    
+    loudnessLabel.setJustificationType(juce::Justification::centredLeft);
+    loudnessLabel.setColour(juce::Label::textColourId, juce::Colours::lightgrey);
+    loudnessLabel.setFont(juce::Font(juce::FontOptions(11.0f)));
+    addAndMakeVisible(loudnessLabel);
+    
+    loudnessResetButton.setButtonText("RESET");
+    loudnessResetButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF404040));
+    loudnessResetButton.setTooltip("Restart the integrated loudness and true-peak measurement");
+    loudnessResetButton.onClick = [this]() { audioProcessor.getSpectrumAnalyzer().resetLoudness(); };
+    addAndMakeVisible(loudnessResetButton);
     
     // Setup spectrum mode button
     spectrumModeButton.setButtonText("SPEC");
@@ -702,6 +717,26 @@ VaclisDynamicEQAudioProcessorEditor::VaclisDynamicEQAudioProcessorEditor (Vaclis
     };
     addAndMakeVisible(spectrumModeButton);
     
+    // Setup spectrogram view (hidden until SGRAM is switched on)
+    spectrogramDisplay = std::make_unique<SpectrogramDisplay>(audioProcessor.getSpectrumAnalyzer());
+    addChildComponent(*spectrogramDisplay);
+    
+    spectrogramModeButton.setButtonText("SGRAM");
+    spectrogramModeButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF404040));      // Dark gray when off
+    spectrogramModeButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFF00AA00));    // Bright green when on
+    spectrogramModeButton.setColour(juce::TextButton::textColourOffId, juce::Colours::lightgrey);
+    spectrogramModeButton.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+    spectrogramModeButton.setToggleable(true);
+    spectrogramModeButton.setClickingTogglesState(true);
+    spectrogramModeButton.onClick = [this]() {
+        // Swap the views - each one only subscribes to the analyzer while it is visible
+        const bool showSpectrogram = spectrogramModeButton.getToggleState();
+        spectrogramDisplay->setVisible(showSpectrogram);
+        if (frequencyResponseDisplay)
+            frequencyResponseDisplay->setVisible(!showSpectrogram);
+    };
+    addAndMakeVisible(spectrogramModeButton);
+    
     // Setup sidechain button
     sidechainButton.setButtonText("SC");
     sidechainButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0x40404040));
@@ -716,6 +751,29 @@ VaclisDynamicEQAudioProcessorEditor::VaclisDynamicEQAudioProcessorEditor (Vaclis
     sidechainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         audioProcessor.getValueTreeState(), "sidechain_enable", sidechainButton);
     
+    // Setup A/B compare and auto gain buttons
+    for (auto* button : { &abCompareButton, &autoGainButton })
+    {
+        button->setColour(juce::TextButton::buttonColourId, juce::Colour(0x40404040));
+        button->setColour(juce::TextButton::textColourOffId, juce::Colours::lightgrey);
+        button->setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+        button->setToggleable(true);
+        button->setClickingTogglesState(true);
+        addAndMakeVisible(*button);
+    }
+    
+    abCompareButton.setButtonText("A/B");
+    abCompareButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0x80FFCC00)); // Yellow while hearing B
+    abCompareButton.setTooltip("Compare with the EQ bypassed (crossfaded)");
+    autoGainButton.setButtonText("AUTO");
+    autoGainButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0x8000AAFF)); // Blue when matching
+    autoGainButton.setTooltip("Match the EQ'd loudness to the bypassed signal");
+    
+    abCompareAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getValueTreeState(), "ab_bypass", abCompareButton);
+    autoGainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        audioProcessor.getValueTreeState(), "auto_gain", autoGainButton);
+    
     // Setup VTR components
     loadReferenceButton.setButtonText("Load Reference & Apply VTR");
     loadReferenceButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF0080FF));
@@ -729,10 +787,53 @@ VaclisDynamicEQAudioProcessorEditor::VaclisDynamicEQAudioProcessorEditor (Vaclis
     vtrStatusLabel.setFont(juce::Font(juce::FontOptions(12.0f)));
     addAndMakeVisible(vtrStatusLabel);
     
+    // Where the reference and live features are extracted
+    if (auto* backendParameter = dynamic_cast<juce::AudioParameterChoice*>(
+        audioProcessor.getValueTreeState().getParameter("feature_backend")))
+    {
+        featureBackendCombo.addItemList(backendParameter->choices, 1);
+    }
+    featureBackendCombo.setTooltip("Feature extraction backend for VTR");
+    addAndMakeVisible(featureBackendCombo);
+    featureBackendAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getValueTreeState(), "feature_backend", featureBackendCombo);
+    
+    // How the spectrum display is analysed
+    if (auto* resolutionParameter = dynamic_cast<juce::AudioParameterChoice*>(
+        audioProcessor.getValueTreeState().getParameter("spectrum_resolution")))
+    {
+        spectrumResolutionCombo.addItemList(resolutionParameter->choices, 1);
+    }
+    spectrumResolutionCombo.setTooltip("Spectrum FFT size (multi-resolution uses octave sub-band FFTs)");
+    addAndMakeVisible(spectrumResolutionCombo);
+    spectrumResolutionAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getValueTreeState(), "spectrum_resolution", spectrumResolutionCombo);
+    
+    if (auto* overlapParameter = dynamic_cast<juce::AudioParameterChoice*>(
+        audioProcessor.getValueTreeState().getParameter("spectrum_overlap")))
+    {
+        spectrumOverlapCombo.addItemList(overlapParameter->choices, 1);
+    }
+    spectrumOverlapCombo.setTooltip("Spectrum frame overlap");
+    addAndMakeVisible(spectrumOverlapCombo);
+    spectrumOverlapAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        audioProcessor.getValueTreeState(), "spectrum_overlap", spectrumOverlapCombo);
+    
     // ProgressBar removed to avoid lifecycle issues
     
-    // Start timer for level meter updates (30Hz)
-    startTimer(33);
+    // One display-synced tick drives the meters and visualizers; it slows right down on silence
+    refreshScheduler = std::make_unique<RefreshScheduler>(*this, [this]()
+    {
+        constexpr float silenceLevel = 1.0e-4f; // -80 dBFS RMS
+        return audioProcessor.getInputLevel() > silenceLevel || audioProcessor.getOutputLevel() > silenceLevel;
+    });
+    
+    // The editor goes first so the meters see this tick's levels
+    refreshScheduler->addClient(*this);
+    refreshScheduler->addClient(*inputLevelMeter);
+    refreshScheduler->addClient(*outputLevelMeter);
+    refreshScheduler->addClient(*frequencyResponseDisplay);
+    refreshScheduler->addClient(*spectrogramDisplay);
     
     // Ensure proper initial layout
     resized();
@@ -751,8 +852,8 @@ VaclisDynamicEQAudioProcessorEditor::VaclisDynamicEQAudioProcessorEditor (Vaclis
 
 VaclisDynamicEQAudioProcessorEditor::~VaclisDynamicEQAudioProcessorEditor()
 {
-    // Stop the timer before destruction to prevent callbacks on deleted objects
-    stopTimer();
+    // Stop refresh ticks before destruction to prevent callbacks on deleted objects
+    refreshScheduler.reset();
     
     // ProgressBar removed - no need to reset
     
@@ -805,7 +906,7 @@ void VaclisDynamicEQAudioProcessorEditor::resized()
     
     // Reserve space for title and add control buttons
     auto titleArea = bounds.removeFromTop(40); // Reduced height
-    auto buttonRow = titleArea.removeFromRight(120).removeFromBottom(25).reduced(5);
+    auto buttonRow = titleArea.removeFromRight(280).removeFromBottom(25).reduced(5);
     
     // Add frequency response display area
     auto frequencyResponseArea = bounds.removeFromTop(180); // Increased height by 50% (120 * 1.5 = 180)
@@ -816,12 +917,21 @@ void VaclisDynamicEQAudioProcessorEditor::resized()
         frequencyResponseDisplay->setBounds(frequencyResponseArea.reduced(10));
     }
     
+    if (spectrogramDisplay)
+        spectrogramDisplay->setBounds(frequencyResponseArea.reduced(10));
+    
     // Position buttons side by side
     auto specButtonArea = buttonRow.removeFromLeft(50);
     auto scButtonArea = buttonRow.removeFromLeft(50);
+    auto sgramButtonArea = buttonRow.removeFromLeft(60);
+    auto abButtonArea = buttonRow.removeFromLeft(50);
+    auto autoGainButtonArea = buttonRow.removeFromLeft(60);
     
     spectrumModeButton.setBounds(specButtonArea);
     sidechainButton.setBounds(scButtonArea);
+    spectrogramModeButton.setBounds(sgramButtonArea);
+    abCompareButton.setBounds(abButtonArea);
+    autoGainButton.setBounds(autoGainButtonArea);
     
     // Create main layout area
     auto mainArea = bounds.reduced(10);
@@ -837,6 +947,8 @@ void VaclisDynamicEQAudioProcessorEditor::resized()
     if (inputLevelMeter)
         inputLevelMeter->setBounds(inputMeterArea);
     
+    meterBallisticsCombo.setBounds(inputGainArea.removeFromTop(34).withSizeKeepingCentre(90, 24));
+    
     // Output Gain (right side) 
     auto outputGainArea = mainArea.removeFromRight(100); // Wider for meter
     outputGainLabel.setBounds(outputGainArea.removeFromTop(20));
@@ -848,6 +960,10 @@ void VaclisDynamicEQAudioProcessorEditor::resized()
     if (outputLevelMeter)
         outputLevelMeter->setBounds(outputMeterArea);
     
+    outputGainArea.removeFromTop(5);
+    loudnessLabel.setBounds(outputGainArea.removeFromTop(48));
+    loudnessResetButton.setBounds(outputGainArea.removeFromTop(22).withSizeKeepingCentre(60, 20));
+    
     // Multi-band area (center)
     auto bandsArea = mainArea.reduced(10, 0);
     auto originalBandsArea = bandsArea; // Save for spectrum display
@@ -889,16 +1005,13 @@ void VaclisDynamicEQAudioProcessorEditor::resized()
     const int buttonWidth = 250;
     auto vtrButtonArea = vtrControlsArea.withSizeKeepingCentre(buttonWidth, 40);
     loadReferenceButton.setBounds(vtrButtonArea);
+    featureBackendCombo.setBounds(vtrControlsArea.removeFromRight(150).withSizeKeepingCentre(150, 24));
+    spectrumResolutionCombo.setBounds(vtrControlsArea.removeFromLeft(150).withSizeKeepingCentre(150, 24));
+    spectrumOverlapCombo.setBounds(vtrControlsArea.removeFromLeft(90).withSizeKeepingCentre(80, 24));
     
     // VTR status (below button)
     auto vtrStatusArea = vtrControlsArea.removeFromBottom(20);
     vtrStatusLabel.setBounds(vtrStatusArea);
-    
-    // Old spectrum display not used in new design (keep hidden)
-    if (spectrumDisplay)
-    {
-        spectrumDisplay->setBounds(0, 0, 0, 0); // Hide by making it invisible
-    }
 }
 
 void VaclisDynamicEQAudioProcessorEditor::parameterChanged(const juce::String& parameterID, float newValue)
@@ -920,23 +1033,46 @@ void VaclisDynamicEQAudioProcessorEditor::parameterChanged(const juce::String& p
     }
 }
 
-void VaclisDynamicEQAudioProcessorEditor::timerCallback()
+void VaclisDynamicEQAudioProcessorEditor::refresh(double elapsedSeconds)
 {
-    // Update level meters with current audio levels
+    juce::ignoreUnused(elapsedSeconds);
+    
+    // Update level meters with the analyzer's RMS and peak readings (loudest channel)
+    auto& analyzer = audioProcessor.getSpectrumAnalyzer();
     if (inputLevelMeter)
     {
-        inputLevelMeter->updateLevel(audioProcessor.getInputLevel());
+        const auto readings = analyzer.getInputMeterReadings();
+        inputLevelMeter->updateLevels(readings.getMaxRMSDB(), readings.getMaxPeakDB());
     }
     
     if (outputLevelMeter)
     {
-        outputLevelMeter->updateLevel(audioProcessor.getOutputLevel());
+        const auto readings = analyzer.getOutputMeterReadings();
+        outputLevelMeter->updateLevels(readings.getMaxRMSDB(), readings.getMaxPeakDB());
     }
     
+    updateLoudnessReadout();
+    
     // Update VTR status
     updateVTRStatus();
 }
 
+void VaclisDynamicEQAudioProcessorEditor::updateLoudnessReadout()
+{
+    const auto readings = audioProcessor.getSpectrumAnalyzer().getOutputMeterReadings();
+    
+    // One decimal, or -inf below the meter's floor
+    auto format = [](float value)
+    {
+        return value <= DynamicEQ::MeteringEngine::SILENCE_DB ? juce::String("-inf") : juce::String(value, 1);
+    };
+    
+    loudnessLabel.setText("S  " + format(readings.shortTermLUFS) + " LUFS\n"
+                          + "I  " + format(readings.integratedLUFS) + " LUFS\n"
+                          + "TP " + format(readings.getMaxTruePeakDB()) + " dB",
+                          juce::dontSendNotification);
+}
+
 void VaclisDynamicEQAudioProcessorEditor::loadReferenceAudio()
 {
     // Create file chooser for audio files
@@ -1013,7 +1149,9 @@ void VaclisDynamicEQAudioProcessorEditor::updateVTRStatus()
     // Update VTR status based on processor state
     if (audioProcessor.isVTRProcessing())
     {
-        vtrStatusLabel.setText("VTR Processing...", juce::dontSendNotification);
+        vtrStatusLabel.setText(audioProcessor.isVTRWaitingForBackend() ? "VTR: Waiting for the Python backend..."
+                                                                       : "VTR Processing...",
+                               juce::dontSendNotification);
         loadReferenceButton.setEnabled(false); // Disable loading during processing
     }
     else
@@ -3,9 +3,10 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "PluginProcessor.h"
 #include "DSP/EQBand.h"
-#include "SpectrumDisplay.h"
 #include "FrequencyResponseDisplay.h"
+#include "SpectrogramDisplay.h"
 #include "LevelMeter.h"
+#include "RefreshScheduler.h"
 
 // Forward declaration
 class VaclisDynamicEQAudioProcessor;
@@ -101,7 +102,7 @@ private:
 
 class VaclisDynamicEQAudioProcessorEditor  : public juce::AudioProcessorEditor,
                                             public juce::AudioProcessorValueTreeState::Listener,
-                                            private juce::Timer
+                                            public RefreshScheduler::Client
 {
 public:
     VaclisDynamicEQAudioProcessorEditor (VaclisDynamicEQAudioProcessor&);
@@ -113,8 +114,8 @@ public:
     // AudioProcessorValueTreeState::Listener
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     
-    // Timer callback for level meter updates
-    void timerCallback() override;
+    // Refresh tick - feeds the level meters and VTR status
+    void refresh(double elapsedSeconds) override;
 
 private:
     VaclisDynamicEQAudioProcessor& audioProcessor;
@@ -137,20 +138,46 @@ private:
     std::unique_ptr<FrequencyResponseDisplay> frequencyResponseDisplay;
     juce::TextButton spectrumModeButton;
     
-    // Old spectrum display (keep for compatibility, but not used in new design)
-    std::unique_ptr<SpectrumDisplay> spectrumDisplay;
+    // Spectrogram view (shares the frequency response area, toggled by SGRAM)
+    std::unique_ptr<SpectrogramDisplay> spectrogramDisplay;
+    juce::TextButton spectrogramModeButton;
     
     // Level meters
     std::unique_ptr<LevelMeter> inputLevelMeter;
     std::unique_ptr<LevelMeter> outputLevelMeter;
+    SpectrumAnalyzer::Subscription meterSubscription; // keeps the processor computing levels
+    juce::ComboBox meterBallisticsCombo;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> meterBallisticsAttachment;
+    
+    // Output loudness (short-term and integrated LUFS) and true peak; the button starts a new measurement
+    juce::Label loudnessLabel;
+    juce::TextButton loudnessResetButton;
+    void updateLoudnessReadout();
+    
+    // Single vblank-driven tick for every animated component in the editor
+    std::unique_ptr<RefreshScheduler> refreshScheduler;
     
     // Sidechain control
     juce::TextButton sidechainButton;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> sidechainAttachment;
     
+    // Loudness-matched A/B compare (B bypasses the EQ, AUTO matches A's loudness to it)
+    juce::TextButton abCompareButton;
+    juce::TextButton autoGainButton;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> abCompareAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> autoGainAttachment;
+    
     // VTR components
     juce::TextButton loadReferenceButton;
     juce::Label vtrStatusLabel;
+    juce::ComboBox featureBackendCombo;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> featureBackendAttachment;
+    
+    // Spectrum display analysis settings
+    juce::ComboBox spectrumResolutionCombo;
+    juce::ComboBox spectrumOverlapCombo;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> spectrumResolutionAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> spectrumOverlapAttachment;
     // Remove ProgressBar to avoid lifecycle issues
     // double vtrProgress = 0.0;
     // std::unique_ptr<juce::ProgressBar> vtrProgressBar;
@@ -17,6 +17,10 @@ VaclisDynamicEQAudioProcessor::VaclisDynamicEQAudioProcessor()
 #endif
        parameters (*this, nullptr, "Parameters", createParameterLayout())
 {
+   #if VTR_REALTIME_GUARD
+    DynamicEQ::RealtimeGuard::installHooks();
+   #endif
+    
     // Setup scalable parameter management
     parameterManager.addParameter("input_gain", parameters);
     parameterManager.addParameter("output_gain", parameters);
@@ -55,7 +59,25 @@ VaclisDynamicEQAudioProcessor::VaclisDynamicEQAudioProcessor()
     inputGain.setup("input_gain", &parameterManager);
     outputGain.setup("output_gain", &parameterManager);
     
+    sidechainEnableParameter = parameters.getRawParameterValue("sidechain_enable");
+    autoGainParameter = parameters.getRawParameterValue("auto_gain");
+    abBypassParameter = parameters.getRawParameterValue("ab_bypass");
+    featureBackendParameter = parameters.getRawParameterValue("feature_backend");
+    spectrumResolutionParameter = parameters.getRawParameterValue("spectrum_resolution");
+    spectrumOverlapParameter = parameters.getRawParameterValue("spectrum_overlap");
+    meterBallisticsParameter = parameters.getRawParameterValue("meter_ballistics");
+    
+    // Loudness matching runs on the analysis worker from the meter taps
+    spectrumAnalyzer.setLoudnessMatcher(&loudnessMatcher);
+    parameters.addParameterListener("auto_gain", this);
+    parameters.addParameterListener("feature_backend", this);
+    parameters.addParameterListener("spectrum_resolution", this);
+    parameters.addParameterListener("spectrum_overlap", this);
+    parameters.addParameterListener("meter_ballistics", this);
+    handleAsyncUpdate();
+    
     // Setup multi-band EQ system
+    multiBandEQ.setScratchArena(&scratchArena);
     multiBandEQ.setNumBands(DynamicEQ::CURRENT_BANDS);
     multiBandEQ.setParameterManager(&parameterManager);
     multiBandEQ.setValueTreeState(&parameters);
@@ -135,6 +157,12 @@ VaclisDynamicEQAudioProcessor::VaclisDynamicEQAudioProcessor()
 
 VaclisDynamicEQAudioProcessor::~VaclisDynamicEQAudioProcessor()
 {
+    parameters.removeParameterListener("auto_gain", this);
+    parameters.removeParameterListener("feature_backend", this);
+    parameters.removeParameterListener("spectrum_resolution", this);
+    parameters.removeParameterListener("spectrum_overlap", this);
+    parameters.removeParameterListener("meter_ballistics", this);
+    cancelPendingUpdate();
 }
 
 void VaclisDynamicEQAudioProcessor::addGainParameter(juce::AudioProcessorValueTreeState::ParameterLayout& layout,
@@ -437,6 +465,54 @@ juce::AudioProcessorValueTreeState::ParameterLayout VaclisDynamicEQAudioProcesso
         "Sidechain Enable",
         false  // Default off
     ));
+    
+    // Loudness-matched A/B compare
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        "auto_gain",
+        "Auto Gain",
+        false  // Default off
+    ));
+    
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        "ab_bypass",
+        "A/B Bypass",
+        false  // Default A (EQ in)
+    ));
+    
+    // Where VTR features are extracted - a setting rather than something to automate
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "feature_backend",
+        "Feature Backend",
+        juce::StringArray { "Native", "LibXtract", "Python librosa", "External process" },
+        0,  // Native, librosa-compatible
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    ));
+    
+    // Spectrum display analysis: octave sub-band FFTs, or one STFT of a fixed size (MIN_STFT_ORDER upwards)
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "spectrum_resolution",
+        "Spectrum Resolution",
+        juce::StringArray { "Multi-resolution", "1024", "2048", "4096", "8192", "16384", "32768" },
+        0,  // Multi-resolution
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    ));
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "spectrum_overlap",
+        "Spectrum Overlap",
+        juce::StringArray { "50%", "75%", "87.5%" },
+        0,  // 50%
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    ));
+    
+    // Peak release and RMS integration of the level meters
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "meter_ballistics",
+        "Meter Ballistics",
+        juce::StringArray { "Fast", "Normal", "Slow" },
+        1,  // Normal (VU-style RMS)
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)
+    ));
 
     return layout;
 }
@@ -513,14 +589,27 @@ void VaclisDynamicEQAudioProcessor::prepareToPlay (double sampleRate, int sample
     // Prepare scalable parameter system
     parameterManager.prepare(sampleRate, 30.0);  // 30ms smoothing
     
+    // Size the scratch arena for the largest set of buffers borrowed within one block
+    // (a sidechain key buffer plus the A/B crossfade's dry copy - spectrum analysis runs on its own worker)
+    const int numChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels(), 2);
+    const size_t scratchBytes = 2 * DynamicEQ::ScratchArena::bytesForBuffer(numChannels, samplesPerBlock);
+    scratchArena.prepare(scratchBytes * 2, VTR_SCRATCH_USE_HUGE_PAGES); // 2x headroom for oversized host blocks
+    
     // Prepare modular DSP components
     multiBandEQ.prepare(sampleRate, samplesPerBlock);
     spectrumAnalyzer.prepare(sampleRate, samplesPerBlock);
+    
+    // The compensation ramp matches the A/B crossfade, so switching to B fades gain and EQ out together
+    outputGain.prepare(sampleRate, AB_CROSSFADE_SECONDS);
+    processedMix.reset(sampleRate, AB_CROSSFADE_SECONDS);
+    processedMix.setCurrentAndTargetValue(abBypassParameter->load() > 0.5f ? 0.0f : 1.0f);
+    eqResetWhileBypassed = false;
 }
 
 void VaclisDynamicEQAudioProcessor::releaseResources()
 {
     // Release any resources that were allocated in prepareToPlay()
+    scratchArena.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -556,6 +645,7 @@ void VaclisDynamicEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
 {
     juce::ignoreUnused (midiMessages);
     juce::ScopedNoDenormals noDenormals;
+    VTR_REALTIME_CONTEXT();
     
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -564,37 +654,26 @@ void VaclisDynamicEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Capture input for spectrum analysis and level metering
-    juce::AudioBuffer<float> inputBuffer(buffer.getNumChannels(), buffer.getNumSamples());
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-        inputBuffer.copyFrom(channel, 0, buffer, channel, 0, buffer.getNumSamples());
+    // Everything borrowed below is handed back at the start of the next block
+    scratchArena.reset();
     
-    // Calculate input level (RMS)
-    float inputRMS = 0.0f;
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-    {
-        inputRMS += buffer.getRMSLevel(channel, 0, buffer.getNumSamples());
-    }
-    inputRMS /= buffer.getNumChannels();
-    inputLevel.store(inputRMS);
+    // Capture the main input bus for analysis and metering (copies into the analyzer's ring)
+    spectrumAnalyzer.captureInput(getBusBuffer(buffer, true, 0));
 
     // Check for sidechain input
     const juce::AudioBuffer<float>* sidechainBuffer = nullptr;
-    bool sidechainEnabled = false;
-    
-    if (auto* sidechainParam = parameters.getRawParameterValue("sidechain_enable"))
-    {
-        sidechainEnabled = *sidechainParam > 0.5f;
-    }
+    const bool sidechainEnabled = sidechainEnableParameter != nullptr && sidechainEnableParameter->load() > 0.5f;
     
     // Get sidechain input if enabled and available
+    // (the bus view must outlive the processing chain below, so it lives at function scope)
+    juce::AudioBuffer<float> sidechainBus;
     if (sidechainEnabled && getBusCount(true) > 1)
     {
         if (auto* bus = getBus(true, 1))
         {
             if (bus->isEnabled())
             {
-                auto sidechainBus = getBusBuffer(buffer, true, 1); // Sidechain is input bus 1
+                sidechainBus = getBusBuffer(buffer, true, 1); // Sidechain is input bus 1
                 if (sidechainBus.getNumChannels() > 0 && sidechainBus.getNumSamples() > 0)
                 {
                     sidechainBuffer = &sidechainBus;
@@ -606,20 +685,12 @@ void VaclisDynamicEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     // Modular processing chain - clean and scalable
     updateParameterSmoothers();
     processInputGain(buffer);
-    processEQWithSidechain(buffer, sidechainBuffer);
+    processEQWithBypass(buffer, sidechainBuffer);
+    updateLoudnessCompensation();
     processOutputGain(buffer);
     
-    // Calculate output level (RMS)
-    float outputRMS = 0.0f;
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-    {
-        outputRMS += buffer.getRMSLevel(channel, 0, buffer.getNumSamples());
-    }
-    outputRMS /= buffer.getNumChannels();
-    outputLevel.store(outputRMS);
-    
-    // Spectrum analysis with input and output
-    spectrumAnalyzer.processBlock(inputBuffer, buffer);
+    // Spectrum analysis and metering with input and output - the FFT and meter work happens on the analysis worker
+    spectrumAnalyzer.captureOutput(getBusBuffer(buffer, false, 0));
 }
 
 void VaclisDynamicEQAudioProcessor::updateParameterSmoothers()
@@ -666,11 +737,145 @@ void VaclisDynamicEQAudioProcessor::processEQWithSidechain(juce::AudioBuffer<flo
     multiBandEQ.processBuffer(buffer, sidechainBuffer);
 }
 
+void VaclisDynamicEQAudioProcessor::processEQWithBypass(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>* sidechainBuffer)
+{
+    // A/B compare - B bypasses the EQ. Only the blocks inside the crossfade need a dry copy
+    const bool bypassed = abBypassParameter->load() > 0.5f;
+    processedMix.setTargetValue(bypassed ? 0.0f : 1.0f);
+    
+    if (!processedMix.isSmoothing())
+    {
+        if (bypassed)
+        {
+            // Clear the filters once, so switching back to A starts from silence instead of stale state
+            if (!eqResetWhileBypassed)
+            {
+                multiBandEQ.reset();
+                eqResetWhileBypassed = true;
+            }
+            return;
+        }
+        
+        processEQWithSidechain(buffer, sidechainBuffer);
+        return;
+    }
+    
+    eqResetWhileBypassed = false;
+    
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+    
+    DynamicEQ::ScratchArena::ScopedFrame scratchFrame(scratchArena);
+    juce::AudioBuffer<float> dryBuffer;
+    if (!scratchArena.borrowBuffer(dryBuffer, numChannels, numSamples))
+    {
+        // Arena exhausted by an oversized host block - switch without the fade rather than allocate
+        processedMix.setCurrentAndTargetValue(processedMix.getTargetValue());
+        if (!bypassed)
+            processEQWithSidechain(buffer, sidechainBuffer);
+        return;
+    }
+    
+    for (int channel = 0; channel < numChannels; ++channel)
+        dryBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+    
+    processEQWithSidechain(buffer, sidechainBuffer);
+    
+    // Linear crossfade - the dry and EQ'd signals are strongly correlated
+    auto* const* processed = buffer.getArrayOfWritePointers();
+    const auto* const* dry = dryBuffer.getArrayOfReadPointers();
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        const float mix = processedMix.getNextValue();
+        for (int channel = 0; channel < numChannels; ++channel)
+            processed[channel][sample] = dry[channel][sample] + mix * (processed[channel][sample] - dry[channel][sample]);
+    }
+}
+
+void VaclisDynamicEQAudioProcessor::updateLoudnessCompensation()
+{
+    // Only A is compensated - B is the untouched reference the EQ is matched against
+    const bool autoGainEnabled = autoGainParameter->load() > 0.5f;
+    const bool processingSelected = processedMix.getTargetValue() > 0.5f;
+    const float compensationDB = autoGainEnabled && processingSelected ? loudnessMatcher.getCompensationDB() : 0.0f;
+    outputGain.setCompensationGain(juce::Decibels::decibelsToGain(compensationDB));
+    
+    // Tell the matcher what sat between its taps besides the EQ, and whether the EQ was fully in
+    const float appliedGain = inputGain.getCurrentGain() * outputGain.getCurrentGain() * outputGain.getCurrentCompensationGain();
+    loudnessMatcher.setAppliedGainDB(juce::Decibels::gainToDecibels(appliedGain));
+    loudnessMatcher.setProcessingActive(processingSelected && !processedMix.isSmoothing());
+}
+
 void VaclisDynamicEQAudioProcessor::processOutputGain(juce::AudioBuffer<float>& buffer)
 {
     outputGain.processBuffer(buffer);
 }
 
+void VaclisDynamicEQAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    juce::ignoreUnused(parameterID, newValue);
+    
+    // May arrive on the audio thread (automation) - subscriptions are changed on the message thread
+    triggerAsyncUpdate();
+}
+
+void VaclisDynamicEQAudioProcessor::handleAsyncUpdate()
+{
+    if (autoGainParameter->load() > 0.5f)
+    {
+        if (!loudnessMeterSubscription.isActive())
+            loudnessMeterSubscription = spectrumAnalyzer.subscribe(SpectrumAnalyzer::Consumer::Meters);
+    }
+    else
+    {
+        loudnessMeterSubscription.reset();
+    }
+    
+    // In the order of the feature_backend choices
+    static constexpr SpectrumAnalyzer::FeatureExtractionBackend featureBackends[] = {
+        SpectrumAnalyzer::FeatureExtractionBackend::JUCE_BASED,
+        SpectrumAnalyzer::FeatureExtractionBackend::LIBXTRACT_BASED,
+        SpectrumAnalyzer::FeatureExtractionBackend::PYTHON_LIBROSA,
+        SpectrumAnalyzer::FeatureExtractionBackend::EXTERNAL_PROCESS
+    };
+    const int backendIndex = juce::jlimit(0, static_cast<int>(std::size(featureBackends)) - 1,
+                                          juce::roundToInt(featureBackendParameter->load()));
+    if (spectrumAnalyzer.getFeatureExtractionBackend() != featureBackends[backendIndex])
+        spectrumAnalyzer.setFeatureExtractionBackend(featureBackends[backendIndex]);
+    
+    // In the order of the spectrum_overlap choices
+    static constexpr float spectrumOverlaps[] = { 0.5f, 0.75f, 0.875f };
+    const int overlapIndex = juce::jlimit(0, static_cast<int>(std::size(spectrumOverlaps)) - 1,
+                                          juce::roundToInt(spectrumOverlapParameter->load()));
+    
+    // Choice 0 is multi-resolution, then one STFT order per choice. Only changes are passed on - each one
+    // makes the analysis worker rebuild its history
+    const int resolutionIndex = juce::jlimit(0, SpectrumAnalyzer::MAX_STFT_ORDER - SpectrumAnalyzer::MIN_STFT_ORDER + 1,
+                                             juce::roundToInt(spectrumResolutionParameter->load()));
+    const bool multiResolution = resolutionIndex == 0;
+    const int stftOrder = multiResolution ? SpectrumAnalyzer::DEFAULT_STFT_ORDER
+                                          : SpectrumAnalyzer::MIN_STFT_ORDER + resolutionIndex - 1;
+    
+    if (spectrumAnalyzer.getStftSize() != (1 << stftOrder) || spectrumAnalyzer.getStftOverlap() != spectrumOverlaps[overlapIndex])
+        spectrumAnalyzer.setStftSettings(stftOrder, spectrumOverlaps[overlapIndex]);
+    if (spectrumAnalyzer.isMultiResolutionEnabled() != multiResolution)
+        spectrumAnalyzer.setMultiResolutionEnabled(multiResolution);
+    
+    // In the order of the meter_ballistics choices: peak attack, peak release, RMS integration (ms)
+    static constexpr DynamicEQ::MeteringEngine::Ballistics meterBallistics[] = {
+        { 0.0f, 300.0f, 50.0f },
+        { 0.0f, 650.0f, 300.0f },
+        { 0.0f, 1500.0f, 1000.0f }
+    };
+    const int ballisticsIndex = juce::jlimit(0, static_cast<int>(std::size(meterBallistics)) - 1,
+                                             juce::roundToInt(meterBallisticsParameter->load()));
+    if (ballisticsIndex != appliedMeterBallistics)
+    {
+        appliedMeterBallistics = ballisticsIndex;
+        spectrumAnalyzer.setMeterBallistics(meterBallistics[ballisticsIndex]);
+    }
+}
+
 bool VaclisDynamicEQAudioProcessor::hasEditor() const
 {
     return true;
@@ -796,7 +1001,7 @@ void VaclisDynamicEQAudioProcessor::processReferenceAudioFile(const juce::File&
                 switch (backend)
                 {
                     case SpectrumAnalyzer::FeatureExtractionBackend::JUCE_BASED:
-                        backendName = "JUCE";
+                        backendName = "Native (librosa-compatible)";
                         break;
                     case SpectrumAnalyzer::FeatureExtractionBackend::PYTHON_LIBROSA:
                         backendName = "Python Librosa";
@@ -804,11 +1009,33 @@ void VaclisDynamicEQAudioProcessor::processReferenceAudioFile(const juce::File&
                     case SpectrumAnalyzer::FeatureExtractionBackend::LIBXTRACT_BASED:
                         backendName = "LibXtract";
                         break;
+                    case SpectrumAnalyzer::FeatureExtractionBackend::EXTERNAL_PROCESS:
+                        backendName = "External process";
+                        break;
                     default:
                         break;
                 }
                 juce::Logger::writeToLog("VTR: Using backend: " + backendName);
                 
+                // Give a Python warm-up in progress the chance to finish, so the reference uses the embedded
+                // interpreter rather than starting a child. The editor shows the wait; closing the plugin ends it
+                if (!processor_->spectrumAnalyzer.isFeatureBackendReady())
+                {
+                    juce::Logger::writeToLog("VTR: Waiting for the feature backend to warm up...");
+                    processor_->vtrWaitingForBackend.store(true);
+                    const bool ready = processor_->spectrumAnalyzer.waitForFeatureBackend(VTR_BACKEND_WAIT_MS, [this] { return shouldExit(); });
+                    processor_->vtrWaitingForBackend.store(false);
+                    
+                    if (shouldExit())
+                    {
+                        processor_->vtrProcessing.store(false);
+                        return jobHasFinished;
+                    }
+                    
+                    if (!ready)
+                        juce::Logger::writeToLog("VTR: Backend still warming up - extracting without it");
+                }
+                
                 auto features = processor_->spectrumAnalyzer.extractFeatures(audioData, sampleRate);
                 juce::Logger::writeToLog("VTR: Feature extraction complete, got " + juce::String(features.size()) + " features");
                 
@@ -7,10 +7,15 @@
 #include "Parameters/ParameterManager.h"
 #include "DSP/EQBand.h"
 #include "DSP/GainProcessor.h"
+#include "DSP/ScratchArena.h"
+#include "DSP/LoudnessMatcher.h"
+#include "DSP/RealtimeGuard.h"
 #include "SpectrumAnalyzer.h"
 #include "VTR/VTRNetwork.h"
 
-class VaclisDynamicEQAudioProcessor  : public juce::AudioProcessor
+class VaclisDynamicEQAudioProcessor  : public juce::AudioProcessor,
+                                       private juce::AudioProcessorValueTreeState::Listener,
+                                       private juce::AsyncUpdater
 {
 public:
     VaclisDynamicEQAudioProcessor();
@@ -46,16 +51,18 @@ public:
 
     juce::AudioProcessorValueTreeState& getValueTreeState() { return parameters; }
     SpectrumAnalyzer& getSpectrumAnalyzer() { return spectrumAnalyzer; }
+    const DynamicEQ::MultiBandEQ& getMultiBandEQ() const { return multiBandEQ; }
     
     // VTR functionality
     VTRNetwork& getVTRNetwork() { return vtrNetwork; }
     bool loadVTRModel(const juce::String& modelPath, const juce::String& scalerPath);
     void processReferenceAudioFile(const juce::File& audioFile);
     bool isVTRProcessing() const { return vtrProcessing.load(); }
+    bool isVTRWaitingForBackend() const { return vtrWaitingForBackend.load(); }
     
-    // Level metering
-    float getInputLevel() const { return inputLevel.load(); }
-    float getOutputLevel() const { return outputLevel.load(); }
+    // Level metering - linear RMS of the loudest channel, from the analyzer's meters
+    float getInputLevel() const { return juce::Decibels::decibelsToGain(spectrumAnalyzer.getInputMeterReadings().getMaxRMSDB()); }
+    float getOutputLevel() const { return juce::Decibels::decibelsToGain(spectrumAnalyzer.getOutputMeterReadings().getMaxRMSDB()); }
 
 private:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -124,29 +131,53 @@ private:
     
     juce::AudioProcessorValueTreeState parameters;
     
+    // Real-time scratch memory, sized in prepareToPlay and reset every block
+    DynamicEQ::ScratchArena scratchArena;
+    std::atomic<float>* sidechainEnableParameter = nullptr;
+    std::atomic<float>* autoGainParameter = nullptr;
+    std::atomic<float>* abBypassParameter = nullptr;
+    std::atomic<float>* featureBackendParameter = nullptr;
+    std::atomic<float>* spectrumResolutionParameter = nullptr;
+    std::atomic<float>* spectrumOverlapParameter = nullptr;
+    std::atomic<float>* meterBallisticsParameter = nullptr;
+    int appliedMeterBallistics = -1; // message thread only
+    
     // Modular DSP components
     DynamicEQ::ParameterManager parameterManager;
     DynamicEQ::GainProcessor inputGain;
     DynamicEQ::GainProcessor outputGain;
     DynamicEQ::MultiBandEQ multiBandEQ;
+    DynamicEQ::LoudnessMatcher loudnessMatcher; // declared first - the analyzer's worker feeds it
     SpectrumAnalyzer spectrumAnalyzer;
+    
+    // Loudness-matched A/B compare. The meters drive the compensation, so they stay subscribed while
+    // auto gain is on; processedMix crossfades between the dry signal (0) and the EQ (1)
+    SpectrumAnalyzer::Subscription loudnessMeterSubscription;
+    juce::LinearSmoothedValue<float> processedMix { 1.0f };
+    bool eqResetWhileBypassed = false;
+    static constexpr double AB_CROSSFADE_SECONDS = 0.03;
+    
     VTRNetwork vtrNetwork;
     
     // VTR processing state
     std::atomic<bool> vtrProcessing{false};
+    std::atomic<bool> vtrWaitingForBackend{false}; // the job is waiting for the Python warm-up
+    static constexpr int VTR_BACKEND_WAIT_MS = 120000;
     std::unique_ptr<juce::ThreadPool> vtrThreadPool;
     
-    // Level metering (atomic for thread safety)
-    std::atomic<float> inputLevel{0.0f};
-    std::atomic<float> outputLevel{0.0f};
-    
     // Processing helper methods
     void updateParameterSmoothers();
     void processInputGain(juce::AudioBuffer<float>& buffer);
     void processEQ(juce::AudioBuffer<float>& buffer);
     void processEQWithSidechain(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>* sidechainBuffer);
+    void processEQWithBypass(juce::AudioBuffer<float>& buffer, const juce::AudioBuffer<float>* sidechainBuffer);
+    void updateLoudnessCompensation();
     void processOutputGain(juce::AudioBuffer<float>& buffer);
     
+    // Auto gain (un)subscribes the meters and the analysis settings are applied, on the message thread
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void handleAsyncUpdate() override;
+    
     // VTR processing helper
     void applyVTRPredictions(const std::vector<float>& predictions);
     
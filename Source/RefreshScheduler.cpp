@@ -0,0 +1,78 @@
+#include "RefreshScheduler.h"
+
+RefreshScheduler::Client::~Client()
+{
+    if (scheduler != nullptr)
+        scheduler->removeClient(*this);
+}
+
+//==============================================================================
+RefreshScheduler::RefreshScheduler(juce::Component& componentToAttachTo, std::function<bool()> isAudioActive)
+    : component(componentToAttachTo),
+      audioActive(std::move(isAudioActive)),
+      vblankAttachment(&componentToAttachTo, [this] { handleVBlank(); })
+{
+}
+
+RefreshScheduler::~RefreshScheduler()
+{
+    for (auto* client : clients)
+        client->scheduler = nullptr;
+}
+
+void RefreshScheduler::addClient(Client& client)
+{
+    jassert(client.scheduler == nullptr || client.scheduler == this);
+
+    client.scheduler = this;
+    client.lastRefreshMs = juce::Time::getMillisecondCounterHiRes();
+    clients.addIfNotAlreadyThere(&client);
+}
+
+void RefreshScheduler::removeClient(Client& client)
+{
+    clients.removeFirstMatchingValue(&client);
+    client.scheduler = nullptr;
+}
+
+void RefreshScheduler::handleVBlank()
+{
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    if (audioActive == nullptr || audioActive())
+        lastActivityMs = nowMs;
+
+    idle = isWindowHidden() || nowMs - lastActivityMs > IDLE_HOLD_SECONDS * 1000.0;
+
+    // Fast displays get throttled to roughly ACTIVE_RATE_HZ; the half-interval slack stops vblank
+    // jitter on a 60 Hz display from skipping every other tick
+    const double intervalMs = 1000.0 / (idle ? IDLE_RATE_HZ : ACTIVE_RATE_HZ);
+    const double minimumGapMs = idle ? intervalMs : intervalMs * 0.5;
+    if (nowMs - lastTickMs < minimumGapMs)
+        return;
+
+    lastTickMs = nowMs;
+
+    // Index loop - a client may remove itself (or another) from inside refresh()
+    for (int i = 0; i < clients.size(); ++i)
+    {
+        auto* client = clients.getUnchecked(i);
+        const double elapsedSeconds = (nowMs - client->lastRefreshMs) * 0.001;
+        client->lastRefreshMs = nowMs;
+        client->refresh(elapsedSeconds);
+    }
+}
+
+bool RefreshScheduler::isWindowHidden() const
+{
+    auto* peer = component.getPeer();
+    return peer == nullptr || peer->isMinimised() || !component.isShowing() || isPeerOccluded(*peer);
+}
+
+#if ! JUCE_MAC
+bool RefreshScheduler::isPeerOccluded(juce::ComponentPeer& peer)
+{
+    juce::ignoreUnused(peer);
+    return false;
+}
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <functional>
+
+/**
+ * One display-synchronised refresh tick per editor, replacing per-component timers
+ * Clients are polled on vblank, check their own data sequence numbers and repaint only when
+ * something changed. The tick drops to a low rate while audio is silent or the window is hidden
+ */
+class RefreshScheduler
+{
+public:
+    /** Anything the scheduler polls - unregisters itself when destroyed */
+    class Client
+    {
+    public:
+        virtual ~Client();
+
+        // Called on the message thread; elapsedSeconds is the time since this client's last refresh
+        virtual void refresh(double elapsedSeconds) = 0;
+
+    private:
+        friend class RefreshScheduler;
+        RefreshScheduler* scheduler = nullptr;
+        double lastRefreshMs = 0.0;
+    };
+
+    // isAudioActive is polled each tick; returning false for IDLE_HOLD_SECONDS lowers the rate
+    RefreshScheduler(juce::Component& componentToAttachTo, std::function<bool()> isAudioActive);
+    ~RefreshScheduler();
+
+    // Clients are refreshed in the order they were added
+    void addClient(Client& client);
+    void removeClient(Client& client);
+
+    bool isIdle() const noexcept { return idle; }
+
+private:
+    void handleVBlank();
+    bool isWindowHidden() const;
+
+    // The platform's own occlusion state where it has one (macOS) - false elsewhere, where a window
+    // covered by another one still counts as visible
+    static bool isPeerOccluded(juce::ComponentPeer& peer);
+
+    juce::Component& component;
+    std::function<bool()> audioActive;
+    juce::Array<Client*> clients;
+
+    double lastTickMs = 0.0;
+    double lastActivityMs = 0.0;
+    bool idle = false;
+
+    static constexpr double ACTIVE_RATE_HZ = 60.0;
+    static constexpr double IDLE_RATE_HZ = 4.0;
+    static constexpr double IDLE_HOLD_SECONDS = 3.0; // lets meters fall before slowing down
+
+    // Last member, so no vblank callback can arrive while the rest is being torn down
+    juce::VBlankAttachment vblankAttachment;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RefreshScheduler)
+};
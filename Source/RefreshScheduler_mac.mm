@@ -0,0 +1,11 @@
+#include "RefreshScheduler.h"
+#import <AppKit/AppKit.h>
+
+bool RefreshScheduler::isPeerOccluded(juce::ComponentPeer& peer)
+{
+    // The peer's native handle is its NSView; a window entirely covered by others, on another Space or
+    // behind the screen saver is not in NSWindowOcclusionStateVisible
+    auto* view = (__bridge NSView*) peer.getNativeHandle();
+    NSWindow* window = [view window];
+    return window != nil && ([window occlusionState] & NSWindowOcclusionStateVisible) == 0;
+}
@@ -0,0 +1,145 @@
+#include "SpectrogramDisplay.h"
+
+SpectrogramDisplay::SpectrogramDisplay(SpectrumAnalyzer& analyzer)
+    : spectrumAnalyzer(analyzer)
+{
+    // Dark blue -> purple -> orange -> pale yellow, similar to the usual "inferno" map
+    juce::ColourGradient gradient(juce::Colour(0xFF000004), 0.0f, 0.0f, juce::Colour(0xFFFCFFA4), 1.0f, 0.0f, false);
+    gradient.addColour(0.25, juce::Colour(0xFF420A68));
+    gradient.addColour(0.5, juce::Colour(0xFF932667));
+    gradient.addColour(0.75, juce::Colour(0xFFDD513A));
+    
+    for (int i = 0; i < COLOUR_MAP_SIZE; ++i)
+        colourMap[static_cast<size_t>(i)] = gradient.getColourAtPosition(static_cast<double>(i) / (COLOUR_MAP_SIZE - 1));
+    
+    setInterceptsMouseClicks(false, false);
+    setOpaque(true);
+}
+
+void SpectrogramDisplay::paint(juce::Graphics& g)
+{
+    g.fillAll(backgroundColour);
+    
+    if (ringImage.isValid())
+    {
+        const int width = ringImage.getWidth();
+        const int height = ringImage.getHeight();
+        const int olderWidth = width - writeColumnIndex;
+        
+        // Oldest columns (write position to the end) on the left, the wrapped newest ones on the right
+        g.drawImage(ringImage, 0, 0, olderWidth, height, writeColumnIndex, 0, olderWidth, height);
+        if (writeColumnIndex > 0)
+            g.drawImage(ringImage, olderWidth, 0, writeColumnIndex, height, 0, 0, writeColumnIndex, height);
+    }
+    
+    drawFrequencyLabels(g);
+}
+
+void SpectrogramDisplay::resized()
+{
+    // Start a fresh history at the new size - one image column per analysis frame, one row per pixel
+    if (getWidth() > 0 && getHeight() > 0)
+    {
+        ringImage = juce::Image(juce::Image::RGB, getWidth(), getHeight(), false);
+        ringImage.clear(ringImage.getBounds(), colourMap[0]);
+    }
+    else
+    {
+        ringImage = juce::Image();
+    }
+    
+    writeColumnIndex = 0;
+    columnPath.update(spectrumSubscription, getHeight());
+}
+
+void SpectrogramDisplay::visibilityChanged()
+{
+    updateSubscription();
+}
+
+void SpectrogramDisplay::setSource(Source newSource)
+{
+    source = newSource;
+}
+
+void SpectrogramDisplay::updateSubscription()
+{
+    // Only keep the analyzer busy while the spectrogram can actually be seen
+    if (isVisible())
+    {
+        if (!spectrumSubscription.isActive())
+        {
+            spectrumSubscription = spectrumAnalyzer.subscribe(SpectrumAnalyzer::Consumer::Spectrum);
+            columnPath.update(spectrumSubscription, getHeight());
+        }
+    }
+    else
+    {
+        spectrumSubscription.reset();
+    }
+}
+
+void SpectrogramDisplay::refresh(double elapsedSeconds)
+{
+    juce::ignoreUnused(elapsedSeconds);
+    
+    if (!isShowing() || !ringImage.isValid())
+        return;
+    
+    // Every frame the worker queued since the last tick becomes its own column, so time scrolls at the
+    // analysis rate. Frames reduced for a previous size are dropped; the next one arrives within a hop
+    const int numNewColumns = spectrumAnalyzer.readColumnHistory(spectrumSubscription.getColumnSlot(), columnPath.getLayout(),
+                                                                 [this](const float* inputMax, const float* outputMax)
+    {
+        writeColumn(source == Source::Input ? inputMax : outputMax);
+    });
+    
+    if (numNewColumns > 0)
+        repaint();
+}
+
+void SpectrogramDisplay::writeColumn(const float* rowValues)
+{
+    const int height = ringImage.getHeight();
+    const int numRows = juce::jmin(height, columnPath.getLayout().numColumns);
+    
+    {
+        // Touch only the one column being replaced
+        juce::Image::BitmapData pixels(ringImage, writeColumnIndex, 0, 1, height, juce::Image::BitmapData::writeOnly);
+        const float scale = (COLOUR_MAP_SIZE - 1) / (MAX_MAGNITUDE_DB - MIN_MAGNITUDE_DB);
+        
+        for (int row = 0; row < numRows; ++row)
+        {
+            const int index = juce::jlimit(0, COLOUR_MAP_SIZE - 1,
+                                           static_cast<int>((rowValues[row] - MIN_MAGNITUDE_DB) * scale));
+            pixels.setPixelColour(0, height - 1 - row, colourMap[static_cast<size_t>(index)]);
+        }
+    }
+    
+    writeColumnIndex = (writeColumnIndex + 1) % ringImage.getWidth();
+}
+
+void SpectrogramDisplay::drawFrequencyLabels(juce::Graphics& g)
+{
+    g.setColour(labelColour);
+    g.setFont(9.0f);
+    
+    const float frequencies[] = {100.0f, 1000.0f, 10000.0f};
+    const char* labels[] = {"100", "1k", "10k"};
+    
+    for (int i = 0; i < 3; ++i)
+    {
+        const float y = frequencyToY(frequencies[i]);
+        g.drawText(labels[i], 2, static_cast<int>(y - 6), 30, 12, juce::Justification::centredLeft);
+    }
+}
+
+float SpectrogramDisplay::frequencyToY(float frequency) const
+{
+    const float height = static_cast<float>(getHeight());
+    const float logFreq = std::log10(frequency);
+    const float logMin = std::log10(MIN_FREQUENCY);
+    const float logMax = std::log10(MAX_FREQUENCY);
+    
+    return height * (1.0f - (logFreq - logMin) / (logMax - logMin));
+}
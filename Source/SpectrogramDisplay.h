@@ -0,0 +1,60 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "SpectrumAnalyzer.h"
+#include "ColumnPath.h"
+#include "RefreshScheduler.h"
+#include <array>
+
+/**
+ * Scrolling spectrogram (waterfall) of the analyzer's input or output
+ * Each analysis frame is colour-mapped into one column of an image ring and painting blits the
+ * two wrapped halves, so the per-frame cost is one column whatever the window width
+ */
+class SpectrogramDisplay : public juce::Component, public RefreshScheduler::Client
+{
+public:
+    enum class Source
+    {
+        Input,
+        Output
+    };
+    
+    explicit SpectrogramDisplay(SpectrumAnalyzer& analyzer);
+    
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void visibilityChanged() override;
+    
+    void setSource(Source newSource);
+    
+private:
+    void refresh(double elapsedSeconds) override;
+    void updateSubscription();
+    void writeColumn(const float* rowValues);
+    void drawFrequencyLabels(juce::Graphics& g);
+    float frequencyToY(float frequency) const;
+    
+    SpectrumAnalyzer& spectrumAnalyzer;
+    SpectrumAnalyzer::Subscription spectrumSubscription; // held while visible
+    ColumnPath columnPath { MIN_FREQUENCY, MAX_FREQUENCY, 0.0f, false, true }; // image rows, instantaneous spectrum, every frame
+    Source source = Source::Output;
+    
+    // Image ring - column writeColumnIndex is the oldest and is overwritten next
+    juce::Image ringImage;
+    int writeColumnIndex = 0;
+    
+    // Visual parameters
+    static constexpr float MIN_FREQUENCY = 20.0f;
+    static constexpr float MAX_FREQUENCY = 20000.0f;
+    static constexpr float MIN_MAGNITUDE_DB = -40.0f;
+    static constexpr float MAX_MAGNITUDE_DB = 40.0f;
+    static constexpr int COLOUR_MAP_SIZE = 256;
+    
+    // Magnitude -> colour lookup, built once
+    std::array<juce::Colour, COLOUR_MAP_SIZE> colourMap;
+    juce::Colour backgroundColour = juce::Colour(0xFF1A1A1A);
+    juce::Colour labelColour = juce::Colour(0xFFAAAAAA);
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrogramDisplay)
+};
@@ -1,27 +1,21 @@
 #include "SpectrumAnalyzer.h"
+#include "DSP/RealtimeGuard.h"
+#include <cstring>
 #include <thread>
+#include <utility>
 
 SpectrumAnalyzer::SpectrumAnalyzer()
-    : fft(FFT_ORDER)
-{
-    // Initialize buffers
-    inputFifo.resize(FFT_SIZE, 0.0f);
-    outputFifo.resize(FFT_SIZE, 0.0f);
-    inputFFTData.resize(FFT_SIZE * 2, 0.0f);
-    outputFFTData.resize(FFT_SIZE * 2, 0.0f);
-    
-    // Initialize spectrum data (half of FFT size for real spectrum)
-    const int spectrumSize = FFT_SIZE / 2;
-    inputSpectrum.resize(spectrumSize, 0.0f);
-    outputSpectrum.resize(spectrumSize, 0.0f);
-    inputPeakHold.resize(spectrumSize, 0.0f);
-    outputPeakHold.resize(spectrumSize, 0.0f);
-    inputPeakTimer.resize(spectrumSize, 0.0f);
-    outputPeakTimer.resize(spectrumSize, 0.0f);
+{
+    // Initialize buffers (STFT buffers are sized by the worker in applyPendingStftSettings)
+    inputRing.resize(RING_SIZE_DEFAULT, 0.0f);
+    outputRing.resize(RING_SIZE_DEFAULT, 0.0f);
+    for (auto* rings : { &inputChannelRings, &outputChannelRings })
+        for (auto& ring : *rings)
+            ring.resize(RING_SIZE_DEFAULT, 0.0f);
     
     // Initialize VTR3 feature extraction
     latestFeatures.resize(TOTAL_FEATURES, 0.0f);
-    featureUpdateInterval = static_cast<int>(UPDATE_RATE_HZ / featureUpdateRateHz);
+    featureFrame.resize(static_cast<size_t>(FFT_SIZE), 0.0f);
     
     // Initialize Essentia feature extractor
 #ifdef HAVE_ESSENTIA
@@ -31,29 +25,49 @@ SpectrumAnalyzer::SpectrumAnalyzer()
     // Initialize feature extractor 
     featureExtractor = std::make_unique<FeatureExtractor>();
     
-    // Initialize with JUCE backend first for immediate availability
-    featureExtractor->initialize(44100.0, FFT_SIZE, FeatureExtractor::Backend::JUCE_BASED);
+    // The native tables are ready immediately; a Python backend starts warming up in the background
+    // here, at plugin load, instead of in prepare
+    featureExtractor->initialize(44100.0, FFT_SIZE, toExtractorBackend(currentBackend));
 }
 
-void SpectrumAnalyzer::prepare(double sampleRateToUse, int samplesPerBlock)
+SpectrumAnalyzer::~SpectrumAnalyzer()
 {
-    juce::ignoreUnused(samplesPerBlock);
-    this->sampleRate = sampleRateToUse;
+    analysisThread->removeTimeSliceClient(this);
     
-    // Calculate peak decay rate based on update rate and hold time
-    const float updateInterval = 1.0f / UPDATE_RATE_HZ;
-    peakDecayRate = updateInterval / PEAK_HOLD_TIME_SECONDS;
+    // Lets an extraction in progress finish - it may be waiting for a reference analysis
+    liveFeatureThread.signalThreadShouldExit();
+    liveFeatureThread.notify();
+    liveFeatureThread.stopThread(-1);
+}
+
+void SpectrumAnalyzer::prepare(double sampleRateToUse, int samplesPerBlock)
+{
+    // Detach from the worker while its buffers are resized (waits for any running slice)
+    analysisThread->removeTimeSliceClient(this);
     
-    // Reset buffers
-    std::fill(inputFifo.begin(), inputFifo.end(), 0.0f);
-    std::fill(outputFifo.begin(), outputFifo.end(), 0.0f);
-    std::fill(inputPeakHold.begin(), inputPeakHold.end(), 0.0f);
-    std::fill(outputPeakHold.begin(), outputPeakHold.end(), 0.0f);
-    std::fill(inputPeakTimer.begin(), inputPeakTimer.end(), 0.0f);
-    std::fill(outputPeakTimer.begin(), outputPeakTimer.end(), 0.0f);
+    this->sampleRate = sampleRateToUse;
     
-    fifoIndex = 0;
-    nextFFTBlockReady = false;
+    // Ring holds RING_LENGTH_SECONDS of audio so a briefly stalled worker never drops samples
+    const int ringSize = juce::nextPowerOfTwo(juce::jmax(RING_SIZE_DEFAULT,
+                                                         static_cast<int>(sampleRateToUse * RING_LENGTH_SECONDS),
+                                                         samplesPerBlock * 4));
+    inputRing.assign(static_cast<size_t>(ringSize), 0.0f);
+    outputRing.assign(static_cast<size_t>(ringSize), 0.0f);
+    for (auto* rings : { &inputChannelRings, &outputChannelRings })
+        for (auto& ring : *rings)
+            ring.assign(static_cast<size_t>(ringSize), 0.0f);
+    analysisFifo.setTotalSize(ringSize);
+    analysisFifo.reset();
+    pendingInputSamples = 0;
+    analysisSamplesToSkip = 0;
+    meterSamplesToSkip = 0;
+    
+    // K-weighting, true-peak interpolation and ballistics all depend on the sample rate
+    inputMeter.prepare(sampleRateToUse);
+    outputMeter.prepare(sampleRateToUse);
+    
+    // Rebuild the STFT state (history, hop and peak hold timing depend on the sample rate)
+    stftSettingsChanged.store(true);
     
     // Prepare Essentia feature extractor
 #ifdef HAVE_ESSENTIA
@@ -63,327 +77,778 @@ void SpectrumAnalyzer::prepare(double sampleRateToUse, int samplesPerBlock)
     }
 #endif
     
-    // Initialize feature extractor with current sample rate
+    // Initialize feature extractor with current sample rate - never waits for the Python backend
     if (featureExtractor)
     {
-        FeatureExtractor::Backend backend = FeatureExtractor::Backend::JUCE_BASED;
-        
-        if (currentBackend == FeatureExtractionBackend::LIBXTRACT_BASED)
-        {
-            backend = FeatureExtractor::Backend::LIBXTRACT_BASED;
-        }
-        else if (currentBackend == FeatureExtractionBackend::PYTHON_LIBROSA)
-        {
-            backend = FeatureExtractor::Backend::PYTHON_LIBROSA;
-            std::cout << "SpectrumAnalyzer: Requesting Python backend initialization..." << std::endl;
-        }
-        
-        featureExtractor->initialize(sampleRateToUse, FFT_SIZE, backend);
+        featureExtractor->initialize(sampleRateToUse, FFT_SIZE, toExtractorBackend(currentBackend));
     }
+    
+    analysisThread->addTimeSliceClient(this);
 }
 
-void SpectrumAnalyzer::processBlock(const juce::AudioBuffer<float>& inputBuffer, const juce::AudioBuffer<float>& outputBuffer)
+void SpectrumAnalyzer::downmixInto(float* destination, const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
 {
-    const int numSamples = inputBuffer.getNumSamples();
-    const int numChannels = inputBuffer.getNumChannels();
+    const int numChannels = buffer.getNumChannels();
+    if (numChannels == 0)
+    {
+        juce::FloatVectorOperations::clear(destination, numSamples);
+        return;
+    }
     
-    // Process samples into FIFO
-    for (int sample = 0; sample < numSamples; ++sample)
+    // Average the channels
+    const float channelGain = 1.0f / static_cast<float>(numChannels);
+    juce::FloatVectorOperations::copyWithMultiply(destination, buffer.getReadPointer(0, startSample), channelGain, numSamples);
+    for (int channel = 1; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::addWithMultiply(destination, buffer.getReadPointer(channel, startSample), channelGain, numSamples);
+}
+
+int SpectrumAnalyzer::copyChannelsInto(std::array<std::vector<float>, DynamicEQ::MeteringEngine::MAX_CHANNELS>& rings, int ringStart,
+                                       const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), DynamicEQ::MeteringEngine::MAX_CHANNELS);
+    for (int channel = 0; channel < numChannels; ++channel)
+        juce::FloatVectorOperations::copy(rings[static_cast<size_t>(channel)].data() + ringStart,
+                                          buffer.getReadPointer(channel, startSample), numSamples);
+    return numChannels;
+}
+
+SpectrumAnalyzer::Subscription::Subscription(SpectrumAnalyzer& analyzerToUse, Consumer consumerToUse)
+    : analyzer(&analyzerToUse), consumer(consumerToUse)
+{
+    analyzer->addSubscriber(consumer);
+}
+
+SpectrumAnalyzer::Subscription::Subscription(Subscription&& other) noexcept
+    : analyzer(std::exchange(other.analyzer, nullptr)),
+      consumer(other.consumer),
+      columnSlot(std::exchange(other.columnSlot, -1))
+{
+}
+
+SpectrumAnalyzer::Subscription& SpectrumAnalyzer::Subscription::operator=(Subscription&& other) noexcept
+{
+    if (this != &other)
     {
-        // Mix channels to mono for spectrum analysis
-        float inputSample = 0.0f;
-        float outputSample = 0.0f;
-        
-        for (int channel = 0; channel < numChannels; ++channel)
-        {
-            inputSample += inputBuffer.getSample(channel, sample);
-            outputSample += outputBuffer.getSample(channel, sample);
-        }
-        
-        // Average the channels
-        if (numChannels > 1)
-        {
-            inputSample /= numChannels;
-            outputSample /= numChannels;
-        }
-        
-        // Store in FIFO
-        inputFifo[fifoIndex] = inputSample;
-        outputFifo[fifoIndex] = outputSample;
-        
-        fifoIndex++;
-        
-        // Check if we have enough samples for FFT
-        if (fifoIndex >= FFT_SIZE)
+        reset();
+        analyzer = std::exchange(other.analyzer, nullptr);
+        consumer = other.consumer;
+        columnSlot = std::exchange(other.columnSlot, -1);
+    }
+    return *this;
+}
+
+SpectrumAnalyzer::Subscription::~Subscription()
+{
+    reset();
+}
+
+void SpectrumAnalyzer::Subscription::reset()
+{
+    if (analyzer == nullptr)
+        return;
+    
+    if (columnSlot >= 0)
+        analyzer->releaseColumnSlot(std::exchange(columnSlot, -1));
+    
+    std::exchange(analyzer, nullptr)->removeSubscriber(consumer);
+}
+
+void SpectrumAnalyzer::Subscription::setColumnLayout(const ColumnLayout& layout)
+{
+    jassert(consumer == Consumer::Spectrum);
+    if (analyzer == nullptr)
+        return;
+    
+    if (columnSlot < 0)
+        columnSlot = analyzer->claimColumnSlot();
+    
+    // Every slot taken - the subscriber keeps using the full-resolution spectra
+    if (columnSlot >= 0)
+        analyzer->setColumnLayout(columnSlot, layout);
+}
+
+int SpectrumAnalyzer::claimColumnSlot()
+{
+    std::lock_guard<std::mutex> lock(columnLayoutMutex);
+    for (int slot = 0; slot < MAX_COLUMN_LAYOUTS; ++slot)
+    {
+        if (!columnSlotInUse[static_cast<size_t>(slot)])
         {
-            nextFFTBlockReady = true;
-            fifoIndex = 0;
+            columnSlotInUse[static_cast<size_t>(slot)] = true;
+            return slot;
         }
     }
     
-    // Perform FFT if we have enough data
-    if (nextFFTBlockReady)
+    jassertfalse;
+    return -1;
+}
+
+void SpectrumAnalyzer::releaseColumnSlot(int slot)
+{
+    {
+        std::lock_guard<std::mutex> lock(columnLayoutMutex);
+        columnSlotInUse[static_cast<size_t>(slot)] = false;
+        requestedColumnLayouts[static_cast<size_t>(slot)] = ColumnLayout();
+    }
+    columnLayoutsChanged.store(true);
+    
+    // The next owner of the slot must not see this subscriber's queued frames
+    auto& history = columnHistories[static_cast<size_t>(slot)];
+    std::lock_guard<std::mutex> lock(history.mutex);
+    history.readRow = history.numRows = 0;
+}
+
+void SpectrumAnalyzer::setColumnLayout(int slot, const ColumnLayout& layout)
+{
+    {
+        std::lock_guard<std::mutex> lock(columnLayoutMutex);
+        auto& requested = requestedColumnLayouts[static_cast<size_t>(slot)];
+        if (requested == layout)
+            return;
+        requested = layout;
+    }
+    columnLayoutsChanged.store(true);
+}
+
+void SpectrumAnalyzer::addSubscriber(Consumer consumer)
+{
+    const bool wasAnalysing = needsAnalysis();
+    const int previousCount = subscriberCounts[static_cast<size_t>(consumer)].fetch_add(1);
+    
+    if (!wasAnalysing && needsAnalysis())
+    {
+        // Restart from clean history and wake the worker so the first frame arrives promptly
+        warmUpPending.store(true);
+        analysisThread->moveToFrontOfQueue(this);
+    }
+    else if (consumer == Consumer::Meters && previousCount == 0)
+    {
+        meterWarmUpPending.store(true);
+        analysisThread->moveToFrontOfQueue(this);
+    }
+}
+
+void SpectrumAnalyzer::removeSubscriber(Consumer consumer)
+{
+    const int previous = subscriberCounts[static_cast<size_t>(consumer)].fetch_sub(1);
+    jassert(previous > 0);
+    juce::ignoreUnused(previous);
+}
+
+bool SpectrumAnalyzer::hasSubscribers(Consumer consumer) const noexcept
+{
+    return subscriberCounts[static_cast<size_t>(consumer)].load(std::memory_order_relaxed) > 0;
+}
+
+bool SpectrumAnalyzer::needsAnalysis() const noexcept
+{
+    return hasSubscribers(Consumer::Spectrum) || hasSubscribers(Consumer::Features);
+}
+
+bool SpectrumAnalyzer::needsCapture() const noexcept
+{
+    return needsAnalysis() || hasSubscribers(Consumer::Meters);
+}
+
+void SpectrumAnalyzer::captureInput(const juce::AudioBuffer<float>& inputBuffer) noexcept
+{
+    // Nothing to feed while the editor is closed and live VTR is off
+    analysingBlock = needsAnalysis();
+    meteringBlock = hasSubscribers(Consumer::Meters);
+    capturingBlock = analysingBlock || meteringBlock;
+    if (!capturingBlock)
+        return;
+    
+    // Write into the free region without publishing it - captureOutput fills the
+    // matching output samples and then commits both at once
+    int start1, size1, start2, size2;
+    analysisFifo.prepareToWrite(inputBuffer.getNumSamples(), start1, size1, start2, size2);
+    
+    if (analysingBlock)
     {
-        // Create temporary buffers for FFT
-        float* inputData = inputFifo.data();
-        float* outputData = outputFifo.data();
+        if (size1 > 0)
+            downmixInto(inputRing.data() + start1, inputBuffer, 0, size1);
+        if (size2 > 0)
+            downmixInto(inputRing.data() + start2, inputBuffer, size1, size2);
+    }
+    
+    // The meters need the channels themselves - a plain copy, all the filtering happens on the worker
+    if (meteringBlock)
+    {
+        int numChannels = 0;
+        if (size1 > 0)
+            numChannels = copyChannelsInto(inputChannelRings, start1, inputBuffer, 0, size1);
+        if (size2 > 0)
+            numChannels = copyChannelsInto(inputChannelRings, start2, inputBuffer, size1, size2);
+        inputMeterChannels.store(numChannels, std::memory_order_relaxed);
+    }
+    
+    pendingInputSamples = size1 + size2;
+}
+
+void SpectrumAnalyzer::captureOutput(const juce::AudioBuffer<float>& outputBuffer) noexcept
+{
+    if (!capturingBlock)
+        return;
+    
+    const int numSamples = juce::jmin(outputBuffer.getNumSamples(), pendingInputSamples);
+    
+    int start1, size1, start2, size2;
+    analysisFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+    
+    if (analysingBlock)
+    {
+        if (size1 > 0)
+            downmixInto(outputRing.data() + start1, outputBuffer, 0, size1);
+        if (size2 > 0)
+            downmixInto(outputRing.data() + start2, outputBuffer, size1, size2);
+    }
+    
+    if (meteringBlock)
+    {
+        int numChannels = 0;
+        if (size1 > 0)
+            numChannels = copyChannelsInto(outputChannelRings, start1, outputBuffer, 0, size1);
+        if (size2 > 0)
+            numChannels = copyChannelsInto(outputChannelRings, start2, outputBuffer, size1, size2);
+        outputMeterChannels.store(numChannels, std::memory_order_relaxed);
+    }
+    
+    analysisFifo.finishedWrite(size1 + size2);
+    
+    pendingInputSamples = 0;
+}
+
+void SpectrumAnalyzer::setStftSettings(int fftOrder, float overlap)
+{
+    requestedStftOrder.store(juce::jlimit(MIN_STFT_ORDER, MAX_STFT_ORDER, fftOrder));
+    requestedStftOverlap.store(juce::jlimit(MIN_STFT_OVERLAP, MAX_STFT_OVERLAP, overlap));
+    stftSettingsChanged.store(true);
+}
+
+void SpectrumAnalyzer::setMultiResolutionEnabled(bool enabled)
+{
+    multiResolutionRequested.store(enabled);
+    stftSettingsChanged.store(true);
+}
+
+void SpectrumAnalyzer::applyPendingStftSettings()
+{
+    stftSettingsChanged.store(false);
+    
+    const float overlap = requestedStftOverlap.load();
+    multiResolutionActive = multiResolutionRequested.load();
+    
+    std::vector<float> frequencies;
+    
+    if (multiResolutionActive)
+    {
+        // Band FFT sizes follow the sample rate; the top band stays calibrated to the original 2048-point
+        // frame and the lower bands are normalised for their decimation (see MultiResolutionAnalyzer)
+        multiResolution.prepare(sampleRate, overlap, FFT_SIZE);
+        frameDurationSeconds = multiResolution.getFrameDurationSeconds();
+        frequencies = multiResolution.getFrequencies();
         
-        juce::AudioBuffer<float> inputFFTBuffer(&inputData, 1, FFT_SIZE);
-        juce::AudioBuffer<float> outputFFTBuffer(&outputData, 1, FFT_SIZE);
+        stftSize = multiResolution.getBandFftSize();
+        inputFifo.clear();
+        outputFifo.clear();
+    }
+    else
+    {
+        const int order = requestedStftOrder.load();
+        if (stft == nullptr || stft->getOrder() != order)
+            stft = std::make_unique<DynamicEQ::StereoFFT>(order);
         
-        performFFT(inputFFTBuffer, inputSpectrum);
-        performFFT(outputFFTBuffer, outputSpectrum);
+        stftSize = stft->getSize();
+        hopSize = juce::jmax(1, juce::roundToInt(stftSize * (1.0f - overlap)));
+        frameDurationSeconds = static_cast<float>(hopSize / sampleRate);
         
-        // Update peak hold
-        updatePeakHold(inputSpectrum, inputPeakHold);
-        updatePeakHold(outputSpectrum, outputPeakHold);
+        // Keep levels calibrated to the original 2048-point frame whatever the size
+        magnitudeScale = static_cast<float>(FFT_SIZE) / static_cast<float>(stftSize);
         
-        nextFFTBlockReady = false;
+        inputFifo.assign(static_cast<size_t>(stftSize), 0.0f);
+        outputFifo.assign(static_cast<size_t>(stftSize), 0.0f);
+        fifoIndex = 0;
         
-        // VTR3 Feature extraction (if enabled)
-        if (featureExtractionEnabled.load())
-        {
-            featureUpdateCounter++;
-            if (featureUpdateCounter >= featureUpdateInterval)
-            {
-                extractAndStoreFeatures();
-                featureUpdateCounter = 0;
-            }
-        }
+        frequencies.resize(static_cast<size_t>(stftSize / 2));
+        for (size_t bin = 0; bin < frequencies.size(); ++bin)
+            frequencies[bin] = static_cast<float>(bin * sampleRate / stftSize);
     }
+    
+    // Feature updates are counted in STFT frames (one frame per hop)
+    featureUpdateInterval = juce::jmax(1, juce::roundToInt(1.0f / (requestedFeatureUpdateRateHz.load() * frameDurationSeconds)));
+    featureUpdateCounter = 0;
+    
+    featureHistory.assign(static_cast<size_t>(FFT_SIZE), 0.0f);
+    featureHistoryIndex = 0;
+    
+    const size_t spectrumSize = frequencies.size();
+    inputSpectrum.assign(spectrumSize, -120.0f);
+    outputSpectrum.assign(spectrumSize, -120.0f);
+    inputPeakTimer.assign(spectrumSize, 0.0f);
+    outputPeakTimer.assign(spectrumSize, 0.0f);
+    inputPeakHold.assign(spectrumSize, -120.0f);
+    outputPeakHold.assign(spectrumSize, -120.0f);
+    spectrumFrequencies = std::move(frequencies);
 }
 
-void SpectrumAnalyzer::performFFT(const juce::AudioBuffer<float>& buffer, std::vector<float>& spectrumData)
+int SpectrumAnalyzer::useTimeSlice()
 {
-    std::lock_guard<std::mutex> lock(spectrumMutex);
+    if (warmUpPending.exchange(false))
+    {
+        // Whatever is left in the ring predates the pause - skip it and rebuild the history
+        analysisSamplesToSkip = analysisFifo.getNumReady();
+        stftSettingsChanged.store(true);
+    }
     
-    // Copy data to FFT buffer
-    std::vector<float> fftData(FFT_SIZE * 2, 0.0f);
+    if (meterWarmUpPending.exchange(false))
+    {
+        // Same for the meters, which then start a fresh measurement
+        meterSamplesToSkip = analysisFifo.getNumReady();
+        inputMeter.reset();
+        outputMeter.reset();
+        
+        if (loudnessMatcher != nullptr)
+            loudnessMatcher->restart();
+    }
     
-    // Copy audio data to real part of FFT buffer
-    for (int i = 0; i < FFT_SIZE; ++i)
+    if (loudnessResetPending.exchange(false))
     {
-        fftData[i] = buffer.getSample(0, i);
+        inputMeter.reset();
+        outputMeter.reset();
+        
+        if (loudnessMatcher != nullptr)
+            loudnessMatcher->restart();
     }
     
-    // Apply Hann window
-    applyHannWindow(fftData);
+    const uint32_t ballisticsVersion = requestedBallistics.getVersion();
+    if (ballisticsVersion != appliedBallisticsVersion)
+    {
+        appliedBallisticsVersion = ballisticsVersion;
+        const auto ballistics = requestedBallistics.load();
+        inputMeter.setBallistics(ballistics);
+        outputMeter.setBallistics(ballistics);
+    }
+    
+    const bool settingsChanged = stftSettingsChanged.load();
+    if (settingsChanged)
+        applyPendingStftSettings();
+    
+    // Column maps depend on both the subscribers' layouts and the spectrum's frequency axis
+    if (columnLayoutsChanged.exchange(false) || settingsChanged)
+        rebuildColumnMaps();
+    
+    const int numReady = analysisFifo.getNumReady();
+    if (numReady == 0)
+        return needsCapture() ? WORKER_IDLE_WAIT_MS : WORKER_DORMANT_WAIT_MS;
+    
+    int start1, size1, start2, size2;
+    analysisFifo.prepareToRead(numReady, start1, size1, start2, size2);
     
-    // Perform FFT
-    fft.performFrequencyOnlyForwardTransform(fftData.data());
+    int numMetered = 0;
+    if (size1 > 0)
+        numMetered += consumeRing(start1, size1);
+    if (size2 > 0)
+        numMetered += consumeRing(start2, size2);
     
-    // Convert to magnitude spectrum
-    const int spectrumSize = FFT_SIZE / 2;
-    for (int i = 0; i < spectrumSize; ++i)
+    analysisFifo.finishedRead(size1 + size2);
+    
+    if (numMetered > 0)
     {
-        const float magnitude = fftData[i];
-        
-        // Convert to dB with floor to prevent log(0)
-        const float magnitudeDB = magnitude > 0.0f ? 
-            juce::Decibels::gainToDecibels(magnitude) : 
-            -120.0f; // -120dB floor
+        const auto& inputReadings = inputMeter.getReadings();
+        const auto& outputReadings = outputMeter.getReadings();
+        inputMeterReadings.store(inputReadings);
+        outputMeterReadings.store(outputReadings);
         
-        spectrumData[i] = magnitudeDB;
+        if (loudnessMatcher != nullptr)
+            loudnessMatcher->update(inputReadings.shortTermLUFS, outputReadings.shortTermLUFS, numMetered / sampleRate);
     }
+    
+    // Come straight back if the audio thread pushed more while we were busy
+    return analysisFifo.getNumReady() > 0 ? 0 : WORKER_IDLE_WAIT_MS;
+}
+
+int SpectrumAnalyzer::consumeRing(int start, int numSamples)
+{
+    const int analysisSkip = juce::jmin(numSamples, analysisSamplesToSkip);
+    analysisSamplesToSkip -= analysisSkip;
+    if (needsAnalysis() && analysisSkip < numSamples)
+        appendToFrame(inputRing.data() + start + analysisSkip, outputRing.data() + start + analysisSkip, numSamples - analysisSkip);
+    
+    const int meterSkip = juce::jmin(numSamples, meterSamplesToSkip);
+    meterSamplesToSkip -= meterSkip;
+    if (!hasSubscribers(Consumer::Meters) || meterSkip == numSamples)
+        return 0;
+    
+    updateMeters(start + meterSkip, numSamples - meterSkip);
+    return numSamples - meterSkip;
 }
 
-void SpectrumAnalyzer::applyHannWindow(std::vector<float>& data)
+void SpectrumAnalyzer::updateMeters(int start, int numSamples)
 {
-    // Apply Hann window manually
-    for (int i = 0; i < FFT_SIZE; ++i)
+    std::array<const float*, DynamicEQ::MeteringEngine::MAX_CHANNELS> inputChannels, outputChannels;
+    for (size_t channel = 0; channel < inputChannels.size(); ++channel)
     {
-        const float windowValue = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / (FFT_SIZE - 1)));
-        data[i] *= windowValue;
+        inputChannels[channel] = inputChannelRings[channel].data() + start;
+        outputChannels[channel] = outputChannelRings[channel].data() + start;
     }
+    
+    inputMeter.process(inputChannels.data(), inputMeterChannels.load(std::memory_order_relaxed), numSamples);
+    outputMeter.process(outputChannels.data(), outputMeterChannels.load(std::memory_order_relaxed), numSamples);
 }
 
-void SpectrumAnalyzer::updatePeakHold(std::vector<float>& spectrum, std::vector<float>& peakHold)
+void SpectrumAnalyzer::appendToFrame(const float* inputSamples, const float* outputSamples, int numSamples)
 {
-    for (size_t i = 0; i < spectrum.size(); ++i)
+    while (numSamples > 0)
     {
-        if (spectrum[i] > peakHold[i])
+        const int samplesUntilFrame = multiResolutionActive ? multiResolution.getSamplesUntilNextFrame()
+                                                            : stftSize - fifoIndex;
+        const int numToCopy = juce::jmin(numSamples, samplesUntilFrame);
+        
+        appendToFeatureHistory(inputSamples, numToCopy);
+        
+        if (multiResolutionActive)
         {
-            // New peak detected
-            peakHold[i] = spectrum[i];
-            
-            // Reset timer for this bin
-            if (i < inputPeakTimer.size())
-                inputPeakTimer[i] = PEAK_HOLD_TIME_SECONDS;
-            if (i < outputPeakTimer.size())
-                outputPeakTimer[i] = PEAK_HOLD_TIME_SECONDS;
+            multiResolution.push(inputSamples, outputSamples, numToCopy);
         }
         else
         {
-            // Decay peak hold
-            auto& timer = (peakHold.data() == inputPeakHold.data()) ? inputPeakTimer : outputPeakTimer;
-            
-            if (i < timer.size())
-            {
-                timer[i] -= peakDecayRate;
-                if (timer[i] <= 0.0f)
-                {
-                    // Peak hold time expired, start decaying
-                    peakHold[i] = juce::jmax(peakHold[i] - 0.5f, spectrum[i]); // 0.5dB/update decay
-                    timer[i] = 0.0f;
-                }
-            }
+            juce::FloatVectorOperations::copy(inputFifo.data() + fifoIndex, inputSamples, numToCopy);
+            juce::FloatVectorOperations::copy(outputFifo.data() + fifoIndex, outputSamples, numToCopy);
+            fifoIndex += numToCopy;
         }
+        
+        inputSamples += numToCopy;
+        outputSamples += numToCopy;
+        numSamples -= numToCopy;
+        
+        if (numToCopy == samplesUntilFrame)
+            processFrame();
     }
 }
 
-std::vector<float> SpectrumAnalyzer::getInputSpectrum() const
-{
-    std::lock_guard<std::mutex> lock(spectrumMutex);
-    return inputPeakHold; // Return peak hold data for better visualization
-}
-
-std::vector<float> SpectrumAnalyzer::getOutputSpectrum() const
+void SpectrumAnalyzer::appendToFeatureHistory(const float* inputSamples, int numSamples) noexcept
 {
-    std::lock_guard<std::mutex> lock(spectrumMutex);
-    return outputPeakHold; // Return peak hold data for better visualization
+    // Only the newest FFT_SIZE samples matter
+    if (numSamples > FFT_SIZE)
+    {
+        inputSamples += numSamples - FFT_SIZE;
+        numSamples = FFT_SIZE;
+    }
+    
+    const int firstPart = juce::jmin(numSamples, FFT_SIZE - featureHistoryIndex);
+    juce::FloatVectorOperations::copy(featureHistory.data() + featureHistoryIndex, inputSamples, firstPart);
+    juce::FloatVectorOperations::copy(featureHistory.data(), inputSamples + firstPart, numSamples - firstPart);
+    featureHistoryIndex = (featureHistoryIndex + numSamples) % FFT_SIZE;
 }
 
-// VTR3 Feature extraction methods
-std::vector<float> SpectrumAnalyzer::extractFeatures(const std::vector<float>& audioData, double sampleRate)
+void SpectrumAnalyzer::processFrame()
 {
-    // Use the FeatureExtractor which supports Python backend
-    if (featureExtractor)
+    // Spectrum work only while a display is listening - the multi-resolution frame is consumed either
+    // way, otherwise it never stops asking for one
+    if (!hasSubscribers(Consumer::Spectrum))
     {
-        std::cout << "SpectrumAnalyzer: Using FeatureExtractor backend" << std::endl;
-        juce::Logger::writeToLog("SpectrumAnalyzer: Using FeatureExtractor (with Python support)");
-        return featureExtractor->extractFeatures(audioData);
+        if (multiResolutionActive)
+            multiResolution.consumeFrame();
     }
-    
-    // Use Essentia-based feature extraction if available
-#ifdef HAVE_ESSENTIA
-    if (currentBackend == FeatureExtractionBackend::ESSENTIA_BASED && essentiaExtractor)
+    else
     {
-        return essentiaExtractor->extractFeatures(audioData, sampleRate);
+        if (multiResolutionActive)
+        {
+            multiResolution.computeFrame(inputSpectrum.data(), outputSpectrum.data());
+        }
+        else
+        {
+            stft->perform(inputFifo.data(), outputFifo.data(), magnitudeScale, inputSpectrum.data(), outputSpectrum.data());
+        }
+        
+        updatePeakHold(inputSpectrum, inputPeakHold, inputPeakTimer);
+        updatePeakHold(outputSpectrum, outputPeakHold, outputPeakTimer);
+        publishSpectrumFrame();
     }
-#endif
     
-    // Fall back to JUCE-based implementation
-    std::vector<float> features(TOTAL_FEATURES);
+    // VTR3 Feature extraction (if subscribed)
+    if (hasSubscribers(Consumer::Features))
+    {
+        featureUpdateCounter++;
+        if (featureUpdateCounter >= featureUpdateInterval)
+        {
+            postFeatureFrame();
+            featureUpdateCounter = 0;
+        }
+    }
     
-    // Frame-by-frame processing like librosa
-    const int hopLength = 512;  // librosa default
-    const int frameSize = FFT_SIZE;
+    if (!multiResolutionActive)
+    {
+        // Slide the history by one hop so consecutive frames overlap
+        const int keep = stftSize - hopSize;
+        std::memmove(inputFifo.data(), inputFifo.data() + hopSize, sizeof(float) * static_cast<size_t>(keep));
+        std::memmove(outputFifo.data(), outputFifo.data() + hopSize, sizeof(float) * static_cast<size_t>(keep));
+        fifoIndex = keep;
+    }
+}
+
+void SpectrumAnalyzer::updatePeakHold(const std::vector<float>& spectrum, std::vector<float>& peakHold, std::vector<float>& peakTimer)
+{
+    // Timing is per STFT frame so the hold/decay speed is independent of FFT size and overlap
+    const float decayPerFrame = PEAK_DECAY_DB_PER_SECOND * frameDurationSeconds;
     
-    // Calculate number of frames
-    int numFrames = 0;
-    if (audioData.size() >= frameSize)
+    for (size_t i = 0; i < spectrum.size(); ++i)
     {
-        numFrames = (audioData.size() - frameSize) / hopLength + 1;
+        if (spectrum[i] > peakHold[i])
+        {
+            // New peak detected - hold it
+            peakHold[i] = spectrum[i];
+            peakTimer[i] = PEAK_HOLD_TIME_SECONDS;
+        }
+        else if (peakTimer[i] > 0.0f)
+        {
+            peakTimer[i] -= frameDurationSeconds;
+        }
+        else
+        {
+            // Peak hold time expired, start decaying
+            peakHold[i] = juce::jmax(peakHold[i] - decayPerFrame, spectrum[i]);
+        }
     }
+}
+
+void SpectrumAnalyzer::publishSpectrumFrame()
+{
+    // Copy-assignment reuses each slot's capacity, so this only allocates after a resolution change
+    auto& frame = spectrumFrames.getWriteBuffer();
+    frame.frequencies = spectrumFrequencies;
+    frame.inputSpectrum = inputPeakHold; // Peak hold data for better visualization
+    frame.outputSpectrum = outputPeakHold;
+    for (int slot = 0; slot < MAX_COLUMN_LAYOUTS; ++slot)
+    {
+        auto& columns = frame.columns[static_cast<size_t>(slot)];
+        reduceToColumns(slot, columns);
+        
+        if (columns.layout.keepHistory)
+            appendToColumnHistory(slot, columns);
+    }
+    
+    frame.sequence = publishedSequence.load(std::memory_order_relaxed) + 1;
     
-    if (numFrames == 0)
+    spectrumFrames.publish();
+    publishedSequence.store(frame.sequence, std::memory_order_release);
+}
+
+void SpectrumAnalyzer::rebuildColumnMaps()
+{
+    std::array<ColumnLayout, MAX_COLUMN_LAYOUTS> layouts;
     {
-        // Not enough data, return zeros
-        std::fill(features.begin(), features.end(), 0.0f);
-        return features;
+        std::lock_guard<std::mutex> lock(columnLayoutMutex);
+        layouts = requestedColumnLayouts;
     }
     
-    // Collect features from all frames
-    std::vector<float> allSpectralCentroids;
-    std::vector<float> allSpectralBandwidths;
-    std::vector<float> allSpectralRolloffs;
-    std::vector<float> allRMSValues;
-    std::vector<std::vector<float>> allMFCCFrames;
+    const auto& frequencies = spectrumFrequencies;
+    const int numPoints = static_cast<int>(frequencies.size());
     
-    for (int frameIdx = 0; frameIdx < numFrames; ++frameIdx)
+    for (int slot = 0; slot < MAX_COLUMN_LAYOUTS; ++slot)
     {
-        int startIdx = frameIdx * hopLength;
-        
-        // Extract frame
-        std::vector<float> frame(frameSize, 0.0f);
-        for (int i = 0; i < frameSize && (startIdx + i) < audioData.size(); ++i)
-        {
-            frame[i] = audioData[startIdx + i];
-        }
+        auto& map = columnMaps[static_cast<size_t>(slot)];
+        map.layout = layouts[static_cast<size_t>(slot)];
+        map.sources.clear();
         
-        // Calculate RMS for this frame
-        float frameRMS = extractRMSEnergy(frame);
-        allRMSValues.push_back(frameRMS);
+        const auto& layout = map.layout;
+        if (layout.numColumns <= 0 || numPoints < 2 || layout.minFrequency <= 0.0f || layout.maxFrequency <= layout.minFrequency)
+            continue;
         
-        // Compute power spectrum for this frame
-        std::vector<float> powerSpectrum = computePowerSpectrum(frame);
+        map.sources.resize(static_cast<size_t>(layout.numColumns));
         
-        // Extract spectral features for this frame
-        float centroid = extractSpectralCentroid(powerSpectrum, sampleRate);
-        float bandwidth = extractSpectralBandwidth(powerSpectrum, sampleRate);
-        float rolloff = extractSpectralRolloff(powerSpectrum, sampleRate);
+        const double logMin = std::log(static_cast<double>(layout.minFrequency));
+        const double logRange = std::log(static_cast<double>(layout.maxFrequency)) - logMin;
+        const double halfSmoothing = 0.5 * layout.smoothingOctaves * std::log(2.0);
         
-        allSpectralCentroids.push_back(centroid);
-        allSpectralBandwidths.push_back(bandwidth);
-        allSpectralRolloffs.push_back(rolloff);
+        for (int column = 0; column < layout.numColumns; ++column)
+        {
+            // Column edges on the log axis, widened to the smoothing bandwidth if that is larger
+            const double centreLog = logMin + logRange * (column + 0.5) / layout.numColumns;
+            const double lowLog = juce::jmin(logMin + logRange * column / layout.numColumns, centreLog - halfSmoothing);
+            const double highLog = juce::jmax(logMin + logRange * (column + 1) / layout.numColumns, centreLog + halfSmoothing);
+            
+            const auto lowPoint = std::lower_bound(frequencies.begin(), frequencies.end(), static_cast<float>(std::exp(lowLog)));
+            const auto highPoint = std::lower_bound(frequencies.begin(), frequencies.end(), static_cast<float>(std::exp(highLog)));
+            
+            auto& source = map.sources[static_cast<size_t>(column)];
+            
+            if (highPoint > lowPoint)
+            {
+                source.firstPoint = static_cast<int>(lowPoint - frequencies.begin());
+                source.lastPoint = static_cast<int>(highPoint - frequencies.begin()) - 1;
+                source.fraction = 0.0f;
+            }
+            else
+            {
+                // Column narrower than the point spacing - interpolate at its centre instead
+                const float centreFrequency = static_cast<float>(std::exp(centreLog));
+                const int upper = juce::jlimit(1, numPoints - 1, static_cast<int>(lowPoint - frequencies.begin()));
+                const float lowerFrequency = frequencies[static_cast<size_t>(upper - 1)];
+                const float upperFrequency = frequencies[static_cast<size_t>(upper)];
+                
+                source.firstPoint = upper - 1;
+                source.lastPoint = -1;
+                source.fraction = juce::jlimit(0.0f, 1.0f, (centreFrequency - lowerFrequency) / (upperFrequency - lowerFrequency));
+            }
+        }
+    }
+}
+
+void SpectrumAnalyzer::reduceToColumns(int slot, SpectrumColumns& columns) const noexcept
+{
+    const auto& map = columnMaps[static_cast<size_t>(slot)];
+    const size_t numColumns = map.sources.size();
+    
+    // Resizing keeps each slot's capacity, so steady state does not allocate
+    columns.layout = map.layout;
+    for (auto* values : { &columns.inputMin, &columns.inputMax, &columns.inputMean,
+                          &columns.outputMin, &columns.outputMax, &columns.outputMean })
+        values->resize(numColumns);
+    
+    const auto& inputValues = map.layout.usePeakHold ? inputPeakHold : inputSpectrum;
+    const auto& outputValues = map.layout.usePeakHold ? outputPeakHold : outputSpectrum;
+    
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+        const auto& source = map.sources[column];
         
-        // Extract MFCC for this frame
-        std::vector<float> mfccFrame;
-        if (currentBackend == FeatureExtractionBackend::LIBXTRACT_BASED && featureExtractor)
+        if (source.lastPoint >= source.firstPoint)
         {
-            // Use LibXtract approach via FeatureExtractor
-            mfccFrame = featureExtractor->extractMFCC(frame, NUM_MFCC_COEFFS);
+            float inputMin = inputValues[static_cast<size_t>(source.firstPoint)], inputMax = inputMin, inputSum = 0.0f;
+            float outputMin = outputValues[static_cast<size_t>(source.firstPoint)], outputMax = outputMin, outputSum = 0.0f;
+            
+            for (int point = source.firstPoint; point <= source.lastPoint; ++point)
+            {
+                const float inputValue = inputValues[static_cast<size_t>(point)];
+                const float outputValue = outputValues[static_cast<size_t>(point)];
+                inputMin = juce::jmin(inputMin, inputValue);
+                inputMax = juce::jmax(inputMax, inputValue);
+                inputSum += inputValue;
+                outputMin = juce::jmin(outputMin, outputValue);
+                outputMax = juce::jmax(outputMax, outputValue);
+                outputSum += outputValue;
+            }
+            
+            const float numPoints = static_cast<float>(source.lastPoint - source.firstPoint + 1);
+            columns.inputMin[column] = inputMin;
+            columns.inputMax[column] = inputMax;
+            columns.inputMean[column] = inputSum / numPoints;
+            columns.outputMin[column] = outputMin;
+            columns.outputMax[column] = outputMax;
+            columns.outputMean[column] = outputSum / numPoints;
         }
         else
         {
-            // Use traditional approach with power spectrum
-            mfccFrame = extractMFCC(powerSpectrum, sampleRate);
+            const size_t lower = static_cast<size_t>(source.firstPoint);
+            const float inputValue = inputValues[lower] + source.fraction * (inputValues[lower + 1] - inputValues[lower]);
+            const float outputValue = outputValues[lower] + source.fraction * (outputValues[lower + 1] - outputValues[lower]);
+            columns.inputMin[column] = columns.inputMax[column] = columns.inputMean[column] = inputValue;
+            columns.outputMin[column] = columns.outputMax[column] = columns.outputMean[column] = outputValue;
         }
-        allMFCCFrames.push_back(mfccFrame);
     }
+}
+
+void SpectrumAnalyzer::appendToColumnHistory(int slot, const SpectrumColumns& columns)
+{
+    auto& history = columnHistories[static_cast<size_t>(slot)];
+    const size_t numColumns = static_cast<size_t>(columns.layout.numColumns);
     
-    // Average RMS across all frames (index 0)
-    float avgRMS = 0.0f;
-    for (float rms : allRMSValues)
+    std::lock_guard<std::mutex> lock(history.mutex);
+    
+    if (history.layout != columns.layout)
     {
-        avgRMS += rms;
+        // Rows reduced for the old layout cannot be drawn any more (resizing keeps the capacity)
+        history.layout = columns.layout;
+        history.inputMax.resize(numColumns * COLUMN_HISTORY_FRAMES);
+        history.outputMax.resize(numColumns * COLUMN_HISTORY_FRAMES);
+        history.readRow = history.numRows = 0;
     }
-    avgRMS /= allRMSValues.size();
-    features[0] = avgRMS;
     
-    // Average spectral centroid across all frames (index 1)
-    float avgCentroid = 0.0f;
-    for (float centroid : allSpectralCentroids)
+    if (numColumns == 0 || columns.inputMax.size() != numColumns)
+        return;
+    
+    // A reader that fell this far behind loses the oldest rows
+    if (history.numRows == COLUMN_HISTORY_FRAMES)
     {
-        avgCentroid += centroid;
+        history.readRow = (history.readRow + 1) % COLUMN_HISTORY_FRAMES;
+        --history.numRows;
     }
-    avgCentroid /= allSpectralCentroids.size();
-    features[1] = avgCentroid;
     
-    // Average MFCC coefficients across all frames (indices 2-14)
-    for (int mfccIdx = 0; mfccIdx < NUM_MFCC_COEFFS; ++mfccIdx)
+    const size_t offset = static_cast<size_t>((history.readRow + history.numRows) % COLUMN_HISTORY_FRAMES) * numColumns;
+    std::copy(columns.inputMax.begin(), columns.inputMax.end(), history.inputMax.begin() + static_cast<std::ptrdiff_t>(offset));
+    std::copy(columns.outputMax.begin(), columns.outputMax.end(), history.outputMax.begin() + static_cast<std::ptrdiff_t>(offset));
+    ++history.numRows;
+}
+
+const SpectrumAnalyzer::SpectrumFrame& SpectrumAnalyzer::acquireSpectrumFrame() noexcept
+{
+    return spectrumFrames.acquire();
+}
+
+int SpectrumAnalyzer::readColumnHistory(int slot, const ColumnLayout& layout, const ColumnHistoryCallback& onFrame)
+{
+    if (slot < 0 || slot >= MAX_COLUMN_LAYOUTS)
+        return 0;
+    
+    auto& history = columnHistories[static_cast<size_t>(slot)];
+    std::lock_guard<std::mutex> lock(history.mutex);
+    
+    // Until the worker has published a frame for a new layout, there is nothing to draw for it
+    if (history.layout != layout)
+        return 0;
+    
+    const size_t numColumns = static_cast<size_t>(layout.numColumns);
+    const int numRows = history.numRows;
+    
+    for (int i = 0; i < numRows; ++i)
     {
-        float avgMFCC = 0.0f;
-        for (const auto& mfccFrame : allMFCCFrames)
-        {
-            if (mfccIdx < mfccFrame.size())
-            {
-                avgMFCC += mfccFrame[mfccIdx];
-            }
-        }
-        avgMFCC /= allMFCCFrames.size();
-        features[2 + mfccIdx] = avgMFCC;
+        const size_t offset = static_cast<size_t>((history.readRow + i) % COLUMN_HISTORY_FRAMES) * numColumns;
+        onFrame(history.inputMax.data() + offset, history.outputMax.data() + offset);
     }
     
-    // Average spectral bandwidth across all frames (index 15)
-    float avgBandwidth = 0.0f;
-    for (float bandwidth : allSpectralBandwidths)
+    history.readRow = (history.readRow + numRows) % COLUMN_HISTORY_FRAMES;
+    history.numRows = 0;
+    return numRows;
+}
+
+// VTR3 Feature extraction methods
+std::vector<float> SpectrumAnalyzer::extractFeatures(const std::vector<float>& audioData, double sampleRate)
+{
+    // Use the FeatureExtractor which supports Python backend
+    if (featureExtractor)
     {
-        avgBandwidth += bandwidth;
+        std::cout << "SpectrumAnalyzer: Using FeatureExtractor backend" << std::endl;
+        juce::Logger::writeToLog("SpectrumAnalyzer: Using FeatureExtractor (with Python support)");
+        return featureExtractor->extractFeatures(audioData, sampleRate);
     }
-    avgBandwidth /= allSpectralBandwidths.size();
-    features[15] = avgBandwidth;
     
-    // Average spectral rolloff across all frames (index 16)
-    float avgRolloff = 0.0f;
-    for (float rolloff : allSpectralRolloffs)
+    // Use Essentia-based feature extraction if available
+#ifdef HAVE_ESSENTIA
+    if (currentBackend == FeatureExtractionBackend::ESSENTIA_BASED && essentiaExtractor)
+    {
+        return essentiaExtractor->extractFeatures(audioData, sampleRate);
+    }
+#endif
+    
+    // Fall back to the native librosa-compatible pipeline - the result is already in training order.
+    // Tables are built on first use, on the extracting thread
+    if (!featurePipeline.isPrepared() || featurePipeline.getSettings().sampleRate != sampleRate)
     {
-        avgRolloff += rolloff;
+        FeaturePipeline::Settings pipelineSettings;
+        pipelineSettings.sampleRate = sampleRate;
+        pipelineSettings.fftSize = FFT_SIZE;
+        pipelineSettings.numMelFilters = NUM_MEL_FILTERS;
+        pipelineSettings.minFrequency = static_cast<float>(FMIN);
+        pipelineSettings.maxFrequency = static_cast<float>(FMAX);
+        pipelineSettings.hopLength = 512;  // librosa default
+        featurePipeline.prepare(pipelineSettings);
     }
-    avgRolloff /= allSpectralRolloffs.size();
-    features[16] = avgRolloff;
     
-    return features;
+    featurePipeline.reset();
+    featurePipeline.processSignal(audioData.data(), audioData.size());
+    return featurePipeline.getFeatures();
 }
 
 std::vector<float> SpectrumAnalyzer::extractMFCC(const std::vector<float>& powerSpectrum, double sampleRate)
@@ -517,180 +982,64 @@ float SpectrumAnalyzer::extractRMSEnergy(const std::vector<float>& audioData)
 
 std::vector<float> SpectrumAnalyzer::computeMelFilterbank(const std::vector<float>& powerSpectrum, double sampleRate)
 {
-    std::vector<float> melEnergies(NUM_MEL_FILTERS, 0.0f);
-    
-    // Frequency range for mel filters - using librosa defaults
-    double minFreq = FMIN;         // 0.0 Hz
-    double maxFreq = FMAX;         // 22050.0 Hz (or sampleRate/2 if smaller)
-    maxFreq = std::min(maxFreq, sampleRate / 2.0);
-    
-    // Convert to mel scale
-    float minMel = melScale(minFreq);
-    float maxMel = melScale(maxFreq);
-    
-    // Create mel filter bank - librosa uses NUM_MEL_FILTERS + 2 points
-    // to define NUM_MEL_FILTERS triangular filters
-    for (int m = 0; m < NUM_MEL_FILTERS; ++m)
-    {
-        // Calculate mel frequencies for this filter
-        // librosa creates n_mels + 2 points to define n_mels triangular filters
-        float leftMel = minMel + (m * (maxMel - minMel)) / (NUM_MEL_FILTERS + 1);
-        float centerMel = minMel + ((m + 1) * (maxMel - minMel)) / (NUM_MEL_FILTERS + 1);
-        float rightMel = minMel + ((m + 2) * (maxMel - minMel)) / (NUM_MEL_FILTERS + 1);
-        
-        // Convert back to linear frequency
-        float leftFreq = invMelScale(leftMel);
-        float centerFreq = invMelScale(centerMel);
-        float rightFreq = invMelScale(rightMel);
-        
-        // Convert frequencies to bin indices - librosa uses: bin = freq * n_fft / sr
-        // For power spectrum size N, the FFT size is 2 * (N - 1)
-        int fftSize = 2 * (powerSpectrum.size() - 1);
-        int leftBin = static_cast<int>((leftFreq * fftSize) / sampleRate);
-        int centerBin = static_cast<int>((centerFreq * fftSize) / sampleRate);
-        int rightBin = static_cast<int>((rightFreq * fftSize) / sampleRate);
-        
-        // Ensure bins are within bounds
-        leftBin = std::max(0, std::min(leftBin, static_cast<int>(powerSpectrum.size()) - 1));
-        centerBin = std::max(0, std::min(centerBin, static_cast<int>(powerSpectrum.size()) - 1));
-        rightBin = std::max(0, std::min(rightBin, static_cast<int>(powerSpectrum.size()) - 1));
-        
-        // Apply triangular filter
-        for (int i = leftBin; i <= rightBin; ++i)
-        {
-            float weight = 0.0f;
-            
-            if (i <= centerBin)
-            {
-                // Rising edge
-                if (centerBin > leftBin)
-                {
-                    weight = static_cast<float>(i - leftBin) / (centerBin - leftBin);
-                }
-            }
-            else
-            {
-                // Falling edge
-                if (rightBin > centerBin)
-                {
-                    weight = static_cast<float>(rightBin - i) / (rightBin - centerBin);
-                }
-            }
-            
-            melEnergies[m] += weight * powerSpectrum[i];
-        }
-    }
+    // Sparse Slaney filterbank, built once per sample rate and FFT size (librosa defaults)
+    MelFilterbank::Config config;
+    config.sampleRate = sampleRate;
+    config.fftSize = 2 * static_cast<int>(powerSpectrum.size() - 1);
+    config.numFilters = NUM_MEL_FILTERS;
+    config.minFrequency = static_cast<float>(FMIN);
+    config.maxFrequency = static_cast<float>(FMAX);
     
+    std::vector<float> melEnergies(NUM_MEL_FILTERS, 0.0f);
+    MelFilterbank::getShared(config)->apply(powerSpectrum.data(), melEnergies.data());
     return melEnergies;
 }
 
 std::vector<float> SpectrumAnalyzer::computeDCT(const std::vector<float>& melEnergies)
 {
+    // Cached orthonormal DCT-II, as scipy.fftpack.dct(x, type=2, norm='ortho') used by librosa
     std::vector<float> dctCoeffs(NUM_MFCC_COEFFS, 0.0f);
-    
-    const int N = melEnergies.size();
-    
-    // librosa uses DCT type-II with 'ortho' normalization
-    // scipy.fftpack.dct(x, type=2, norm='ortho')
-    for (int k = 0; k < NUM_MFCC_COEFFS; ++k)
-    {
-        double sum = 0.0;
-        
-        for (int n = 0; n < N; ++n)
-        {
-            double angle = juce::MathConstants<double>::pi * k * (n + 0.5) / N;
-            sum += melEnergies[n] * std::cos(angle);
-        }
-        
-        // Apply orthogonal normalization (librosa default)
-        float norm_factor;
-        if (k == 0)
-        {
-            norm_factor = std::sqrt(1.0f / N);  // First coefficient
-        }
-        else
-        {
-            norm_factor = std::sqrt(2.0f / N);  // Other coefficients
-        }
-        
-        dctCoeffs[k] = norm_factor * sum;
-    }
-    
+    DctMatrix::getShared(NUM_MFCC_COEFFS, static_cast<int>(melEnergies.size()))->apply(melEnergies.data(), dctCoeffs.data());
     return dctCoeffs;
 }
 
-// Helper methods
-float SpectrumAnalyzer::melScale(float frequency)
-{
-    return 2595.0f * std::log10(1.0f + frequency / 700.0f);
-}
-
-float SpectrumAnalyzer::invMelScale(float mel)
+// VTR3 Feature storage and management methods
+void SpectrumAnalyzer::postFeatureFrame()
 {
-    return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
+    // Skip this update while the previous frame is still being extracted rather than wait for it
+    if (featureFramePending.load())
+        return;
+    
+    // The newest FFT_SIZE input samples, oldest first
+    const auto oldest = featureHistory.begin() + featureHistoryIndex;
+    std::copy(featureHistory.begin(), oldest, std::copy(oldest, featureHistory.end(), featureFrame.begin()));
+    featureFrameSampleRate = sampleRate;
+    
+    featureFramePending.store(true);
+    liveFeatureThread.notify();
 }
 
-std::vector<float> SpectrumAnalyzer::computePowerSpectrum(const std::vector<float>& audioData)
+void SpectrumAnalyzer::LiveFeatureThread::run()
 {
-    // Ensure we have enough data for FFT
-    std::vector<float> paddedData = audioData;
-    paddedData.resize(FFT_SIZE, 0.0f);
-    
-    // Calculate Hann window sum for normalization (librosa compatibility)
-    float windowSum = 0.0f;
-    for (int i = 0; i < FFT_SIZE; ++i)
-    {
-        const float windowValue = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * i / (FFT_SIZE - 1)));
-        windowSum += windowValue;
-    }
-    
-    // Apply Hann window
-    applyHannWindow(paddedData);
-    
-    // Prepare FFT data (real + imaginary)
-    std::vector<float> fftData(FFT_SIZE * 2, 0.0f);
-    
-    // Copy real part
-    for (int i = 0; i < FFT_SIZE; ++i)
-    {
-        fftData[i] = paddedData[i];
-    }
-    
-    // Perform FFT
-    fft.performFrequencyOnlyForwardTransform(fftData.data());
-    
-    // Convert to power spectrum (magnitude squared)
-    // JUCE's performFrequencyOnlyForwardTransform returns magnitude values
-    // For librosa compatibility, we need magnitude squared (power) with proper normalization
-    std::vector<float> powerSpectrum(FFT_SIZE / 2 + 1);  // +1 for DC and Nyquist
-    
-    // Normalization factor for Hann window: 2 / windowSum (factor of 2 for one-sided spectrum)
-    const float normalizationFactor = 2.0f / windowSum;
-    
-    for (int i = 0; i < FFT_SIZE / 2 + 1; ++i)
+    while (!threadShouldExit())
     {
-        if (i < FFT_SIZE / 2)
+        if (!owner.featureFramePending.load())
         {
-            float magnitude = fftData[i] * normalizationFactor;
-            powerSpectrum[i] = magnitude * magnitude;  // magnitude^2 = power
-        }
-        else
-        {
-            powerSpectrum[i] = 0.0f;  // Nyquist bin
+            wait(-1);
+            continue;
         }
+        
+        owner.extractAndStoreFeatures();
+        owner.featureFramePending.store(false);
     }
-    
-    return powerSpectrum;
 }
 
-// VTR3 Feature storage and management methods
 void SpectrumAnalyzer::extractAndStoreFeatures()
 {
-    // Extract features from current audio buffer in FIFO
-    std::vector<float> audioData(inputFifo.begin(), inputFifo.end());
+    VTR_ASSERT_NOT_REALTIME("feature extraction");
     
     // Extract features
-    std::vector<float> features = extractFeatures(audioData, sampleRate);
+    std::vector<float> features = extractFeatures(featureFrame, featureFrameSampleRate);
     
     // Store features thread-safely
     {
@@ -713,45 +1062,43 @@ bool SpectrumAnalyzer::hasNewFeatures() const
 
 void SpectrumAnalyzer::enableFeatureExtraction(bool enable)
 {
-    featureExtractionEnabled.store(enable);
-    if (enable)
+    // Counts as a Features subscriber while enabled
+    if (featureExtractionEnabled.exchange(enable) == enable)
+        return;
+    
+    if (!enable)
+    {
+        removeSubscriber(Consumer::Features);
+        return;
+    }
+    
     {
         // Initialize features storage
         std::lock_guard<std::mutex> lock(spectrumMutex);
         latestFeatures.resize(TOTAL_FEATURES, 0.0f);
         newFeaturesAvailable.store(false);
-        featureUpdateCounter = 0;
     }
+    
+    // Started once and kept until destruction, so disabling never waits for an extraction in progress
+    liveFeatureThread.startThread(juce::Thread::Priority::low);
+    addSubscriber(Consumer::Features);
 }
 
 void SpectrumAnalyzer::setFeatureUpdateRate(float rateHz)
 {
-    featureUpdateRateHz = rateHz;
-    // Calculate update interval based on rate
-    // Assuming FFT updates at UPDATE_RATE_HZ (30Hz)
-    featureUpdateInterval = static_cast<int>(UPDATE_RATE_HZ / rateHz);
-    featureUpdateInterval = std::max(1, featureUpdateInterval); // At least every FFT
+    // The worker turns the rate into an interval in STFT frames with the other STFT settings
+    requestedFeatureUpdateRateHz.store(juce::jmax(0.1f, rateHz));
+    stftSettingsChanged.store(true);
 }
 
 void SpectrumAnalyzer::setFeatureExtractionBackend(FeatureExtractionBackend backend)
 {
     currentBackend = backend;
     
-    // Update feature extractor backend
+    // Update feature extractor backend (starts the Python warm-up if needed)
     if (featureExtractor)
     {
-        FeatureExtractor::Backend extractorBackend = FeatureExtractor::Backend::JUCE_BASED;
-        
-        if (backend == FeatureExtractionBackend::LIBXTRACT_BASED)
-        {
-            extractorBackend = FeatureExtractor::Backend::LIBXTRACT_BASED;
-        }
-        else if (backend == FeatureExtractionBackend::PYTHON_LIBROSA)
-        {
-            extractorBackend = FeatureExtractor::Backend::PYTHON_LIBROSA;
-        }
-        
-        featureExtractor->setBackend(extractorBackend);
+        featureExtractor->setBackend(toExtractorBackend(backend));
     }
     
 #ifdef HAVE_ESSENTIA
@@ -769,4 +1116,25 @@ void SpectrumAnalyzer::setFeatureExtractionBackend(FeatureExtractionBackend back
     }
     juce::ignoreUnused(backend);
 #endif
+}
+
+bool SpectrumAnalyzer::isFeatureBackendReady() const noexcept
+{
+    return featureExtractor == nullptr || featureExtractor->isBackendReady();
+}
+
+bool SpectrumAnalyzer::waitForFeatureBackend(int timeoutMs, const std::function<bool()>& shouldStop)
+{
+    return featureExtractor == nullptr || featureExtractor->waitForBackend(timeoutMs, shouldStop);
+}
+
+FeatureExtractor::Backend SpectrumAnalyzer::toExtractorBackend(FeatureExtractionBackend backend) noexcept
+{
+    switch (backend)
+    {
+        case FeatureExtractionBackend::LIBXTRACT_BASED:  return FeatureExtractor::Backend::LIBXTRACT_BASED;
+        case FeatureExtractionBackend::PYTHON_LIBROSA:   return FeatureExtractor::Backend::PYTHON_LIBROSA;
+        case FeatureExtractionBackend::EXTERNAL_PROCESS: return FeatureExtractor::Backend::EXTERNAL_PROCESS;
+        default:                                         return FeatureExtractor::Backend::JUCE_BASED;
+    }
 }
\ No newline at end of file
@@ -4,24 +4,146 @@
 #include <juce_dsp/juce_dsp.h>
 #include <array>
 #include <atomic>
+#include <functional>
 
 #ifdef HAVE_ESSENTIA
 #include "VTR/EssentiaFeatureExtractor.h"
 #endif
 
 #include "VTR/FeatureExtractor.h"
+#include "VTR/FeaturePipeline.h"
+#include "DSP/StereoFFT.h"
+#include "DSP/MultiResolutionAnalyzer.h"
+#include "DSP/TripleBuffer.h"
+#include "DSP/MeteringEngine.h"
+#include "DSP/LoudnessMatcher.h"
+#include "DSP/SeqLock.h"
 
-class SpectrumAnalyzer
+/**
+ * Input/output spectrum analyzer
+ * The audio thread only pushes samples into a wait-free SPSC ring; windowing, FFT, dB conversion,
+ * peak hold and metering run on a shared analysis worker thread
+ */
+class SpectrumAnalyzer : private juce::TimeSliceClient
 {
 public:
     SpectrumAnalyzer();
+    ~SpectrumAnalyzer() override;
     
     void prepare(double sampleRate, int samplesPerBlock);
-    void processBlock(const juce::AudioBuffer<float>& inputBuffer, const juce::AudioBuffer<float>& outputBuffer);
     
-    // Get spectrum data for visualization
-    std::vector<float> getInputSpectrum() const;
-    std::vector<float> getOutputSpectrum() const;
+    /** What a consumer of the analysis needs - each kind is only computed while it has subscribers */
+    enum class Consumer
+    {
+        Spectrum, // spectrum frames for the displays
+        Features, // live VTR feature extraction
+        Meters    // input/output loudness, true-peak and level meters
+    };
+    
+    /** Log-spaced pixel columns a display wants the spectrum reduced to */
+    struct ColumnLayout
+    {
+        int numColumns = 0;             // usually the component width in pixels
+        float minFrequency = 20.0f;     // left edge of column 0
+        float maxFrequency = 20000.0f;  // right edge of the last column
+        float smoothingOctaves = 0.0f;  // e.g. 1/3 or 1/6 widens each column to that bandwidth
+        bool usePeakHold = true;        // false reduces the instantaneous spectrum (e.g. for a spectrogram)
+        bool keepHistory = false;       // also queue every frame's column maxima for readColumnHistory
+        
+        bool operator==(const ColumnLayout& other) const noexcept
+        {
+            return numColumns == other.numColumns && minFrequency == other.minFrequency
+                && maxFrequency == other.maxFrequency && smoothingOctaves == other.smoothingOctaves
+                && usePeakHold == other.usePeakHold && keepHistory == other.keepHistory;
+        }
+        bool operator!=(const ColumnLayout& other) const noexcept { return !(*this == other); }
+    };
+    
+    /** dB spectra (peak-held unless the layout says otherwise) reduced to one min/max/mean per column */
+    struct SpectrumColumns
+    {
+        ColumnLayout layout; // what the values below were computed for
+        std::vector<float> inputMin, inputMax, inputMean;
+        std::vector<float> outputMin, outputMax, outputMean;
+    };
+    
+    static constexpr int MAX_COLUMN_LAYOUTS = 4;
+    
+    /** RAII registration of a consumer; analysis for its kind stops when the last one is released */
+    class Subscription
+    {
+    public:
+        Subscription() = default;
+        Subscription(SpectrumAnalyzer& analyzerToUse, Consumer consumerToUse);
+        Subscription(Subscription&& other) noexcept;
+        Subscription& operator=(Subscription&& other) noexcept;
+        ~Subscription();
+        
+        void reset();
+        bool isActive() const noexcept { return analyzer != nullptr; }
+        
+        // Spectrum subscribers can have the worker reduce each frame to their pixel columns;
+        // the result is SpectrumFrame::columns[getColumnSlot()] (-1 until a layout is set)
+        void setColumnLayout(const ColumnLayout& layout);
+        int getColumnSlot() const noexcept { return columnSlot; }
+        
+    private:
+        SpectrumAnalyzer* analyzer = nullptr;
+        Consumer consumer = Consumer::Spectrum;
+        int columnSlot = -1;
+        
+        JUCE_DECLARE_NON_COPYABLE(Subscription)
+    };
+    
+    // Message thread - keep the returned object alive for as long as the data is wanted
+    Subscription subscribe(Consumer consumer) { return Subscription(*this, consumer); }
+    bool hasSubscribers(Consumer consumer) const noexcept;
+    
+    // Audio thread - call captureInput before processing and captureOutput after, once per block.
+    // Both return immediately while nothing is subscribed
+    void captureInput(const juce::AudioBuffer<float>& inputBuffer) noexcept;
+    void captureOutput(const juce::AudioBuffer<float>& outputBuffer) noexcept;
+    
+    /** One published analysis result - point i of each spectrum sits at frequencies[i] */
+    struct SpectrumFrame
+    {
+        uint64_t sequence = 0; // 0 until the first frame is published
+        std::vector<float> frequencies;
+        std::vector<float> inputSpectrum;  // peak-held dB
+        std::vector<float> outputSpectrum; // peak-held dB
+        std::array<SpectrumColumns, MAX_COLUMN_LAYOUTS> columns;
+    };
+    
+    // Spectrum data for visualization (message thread only) - no lock, no copy. The frame stays
+    // valid until the next acquire, so use it within the current paint/timer callback
+    const SpectrumFrame& acquireSpectrumFrame() noexcept;
+    uint64_t getSpectrumSequence() const noexcept { return publishedSequence.load(std::memory_order_acquire); }
+    
+    // Message thread, for keepHistory layouts: passes the input and output column maxima of every frame
+    // queued for the slot since the last call to onFrame, oldest first, and returns how many there were
+    using ColumnHistoryCallback = std::function<void(const float* inputMax, const float* outputMax)>;
+    int readColumnHistory(int slot, const ColumnLayout& layout, const ColumnHistoryCallback& onFrame);
+    
+    // Meter readings (any thread) - kept current by the analysis worker while Meters has subscribers
+    using MeterReadings = DynamicEQ::MeteringEngine::Readings;
+    MeterReadings getInputMeterReadings() const noexcept { return inputMeterReadings.load(); }
+    MeterReadings getOutputMeterReadings() const noexcept { return outputMeterReadings.load(); }
+    
+    // Peak/RMS time constants and the loudness reset (message thread) - applied by the worker on its next slice
+    void setMeterBallistics(const DynamicEQ::MeteringEngine::Ballistics& ballistics) { requestedBallistics.store(ballistics); }
+    void resetLoudness() { loudnessResetPending.store(true); }
+    
+    // Fed the short-term loudness of both taps whenever the meters run - set once, before prepare
+    void setLoudnessMatcher(DynamicEQ::LoudnessMatcher* matcher) { loudnessMatcher = matcher; }
+    
+    // Display STFT configuration - applied by the analysis worker on its next slice
+    void setStftSettings(int fftOrder, float overlap);
+    int getStftSize() const { return 1 << requestedStftOrder.load(); }
+    float getStftOverlap() const { return requestedStftOverlap.load(); }
+    
+    // Multi-resolution mode: octave sub-band FFTs fused onto a log-frequency grid (the STFT order is ignored)
+    void setMultiResolutionEnabled(bool enabled);
+    bool isMultiResolutionEnabled() const { return multiResolutionRequested.load(); }
     
     // VTR3 Feature extraction methods
     std::vector<float> extractFeatures(const std::vector<float>& audioData, double sampleRate);
@@ -42,11 +164,20 @@ public:
     // Public access to sample rate for frequency calculations
     double getSampleRate() const { return sampleRate; }
     
-    // Configuration
+    // Configuration (FFT_SIZE is the feature extraction frame; the display STFT is configurable)
     static constexpr int FFT_SIZE = 2048;
     static constexpr int FFT_ORDER = 11; // 2^11 = 2048
     static constexpr float UPDATE_RATE_HZ = 30.0f;
     static constexpr float PEAK_HOLD_TIME_SECONDS = 2.0f;
+    static constexpr float PEAK_DECAY_DB_PER_SECOND = 10.0f;
+    
+    // Display STFT limits: 1k-32k FFT, 50-87.5% overlap
+    static constexpr int MIN_STFT_ORDER = 10;
+    static constexpr int MAX_STFT_ORDER = 15;
+    static constexpr int DEFAULT_STFT_ORDER = 12;
+    static constexpr float MIN_STFT_OVERLAP = 0.5f;
+    static constexpr float MAX_STFT_OVERLAP = 0.875f;
+    static constexpr float DEFAULT_STFT_OVERLAP = 0.5f;
     
     // VTR3 Feature extraction constants - matching librosa defaults
     static constexpr int NUM_MEL_FILTERS = 128;  // librosa default
@@ -58,63 +189,203 @@ public:
     // Feature extraction backend selection
     enum class FeatureExtractionBackend
     {
-        JUCE_BASED,
+        JUCE_BASED,       // native, librosa-compatible (FeaturePipeline)
         ESSENTIA_BASED,
         LIBXTRACT_BASED,
-        PYTHON_LIBROSA
+        PYTHON_LIBROSA,
+        EXTERNAL_PROCESS  // librosa in the standalone extractor, run as a child process
     };
     
     void setFeatureExtractionBackend(FeatureExtractionBackend backend);
-    FeatureExtractionBackend getFeatureExtractionBackend() const { return currentBackend; }
+    FeatureExtractionBackend getFeatureExtractionBackend() const { return currentBackend.load(); }
+    
+    // False while the Python backend is still warming up in the background
+    bool isFeatureBackendReady() const noexcept;
+    
+    // Waits for that warm-up, up to timeoutMs or until shouldStop returns true (see FeatureExtractor::waitForBackend)
+    bool waitForFeatureBackend(int timeoutMs, const std::function<bool()>& shouldStop);
     
 private:
-    void performFFT(const juce::AudioBuffer<float>& buffer, std::vector<float>& spectrumData);
-    void applyHannWindow(std::vector<float>& data);
-    void updatePeakHold(std::vector<float>& spectrum, std::vector<float>& peakHold);
+    // Subscription bookkeeping
+    void addSubscriber(Consumer consumer);
+    void removeSubscriber(Consumer consumer);
+    bool needsAnalysis() const noexcept;
+    bool needsCapture() const noexcept;
+    
+    // Analysis worker
+    int useTimeSlice() override;
+    int consumeRing(int start, int numSamples);
+    void updateMeters(int start, int numSamples);
+    void appendToFrame(const float* inputSamples, const float* outputSamples, int numSamples);
+    void appendToFeatureHistory(const float* inputSamples, int numSamples) noexcept;
+    void processFrame();
+    void applyPendingStftSettings();
+    static void downmixInto(float* destination, const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+    static int copyChannelsInto(std::array<std::vector<float>, DynamicEQ::MeteringEngine::MAX_CHANNELS>& rings, int ringStart,
+                                const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+    void publishSpectrumFrame();
+    void rebuildColumnMaps();
+    void reduceToColumns(int slot, SpectrumColumns& columns) const noexcept;
+    void appendToColumnHistory(int slot, const SpectrumColumns& columns);
+    
+    // Column layout slots (message thread)
+    int claimColumnSlot();
+    void releaseColumnSlot(int slot);
+    void setColumnLayout(int slot, const ColumnLayout& layout);
+    void updatePeakHold(const std::vector<float>& spectrum, std::vector<float>& peakHold, std::vector<float>& peakTimer);
     
     // VTR3 Helper methods
-    float melScale(float frequency);
-    float invMelScale(float mel);
-    std::vector<float> computePowerSpectrum(const std::vector<float>& audioData);
+    void postFeatureFrame();
     void extractAndStoreFeatures();
+    static FeatureExtractor::Backend toExtractorBackend(FeatureExtractionBackend backend) noexcept;
+    
+    // Feature extraction STFT (fallback when there is no FeatureExtractor), only touched by the extracting thread
+    FeaturePipeline featurePipeline;
+    
+    // Display analysis (analysis worker only) - input and output share one complex transform
+    std::unique_ptr<DynamicEQ::StereoFFT> stft;
+    DynamicEQ::MultiResolutionAnalyzer multiResolution;
+    bool multiResolutionActive = false;
+    int stftSize = 0;
+    int hopSize = 0;
+    float magnitudeScale = 1.0f;
+    std::atomic<int> requestedStftOrder{DEFAULT_STFT_ORDER};
+    std::atomic<float> requestedStftOverlap{DEFAULT_STFT_OVERLAP};
+    std::atomic<bool> multiResolutionRequested{true};
+    std::atomic<bool> stftSettingsChanged{true};
+    
+    // Audio thread -> analysis worker ring (input and output share one set of indices). The mono
+    // downmix is only written for analysis and the per-channel copies only for the meters
+    juce::AbstractFifo analysisFifo { RING_SIZE_DEFAULT };
+    std::vector<float> inputRing, outputRing;
+    std::array<std::vector<float>, DynamicEQ::MeteringEngine::MAX_CHANNELS> inputChannelRings, outputChannelRings;
+    std::atomic<int> inputMeterChannels{0}, outputMeterChannels{0};
+    int pendingInputSamples = 0;
+    bool capturingBlock = false; // audio thread only - keeps captureInput/captureOutput paired
+    bool analysingBlock = false;
+    bool meteringBlock = false;
+    
+    /** One low-priority worker shared by every analyzer instance in the process */
+    struct AnalysisThread : public juce::TimeSliceThread
+    {
+        AnalysisThread() : juce::TimeSliceThread("VTR Spectrum Analysis") { startThread(juce::Thread::Priority::low); }
+        ~AnalysisThread() override { stopThread(2000); }
+    };
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+    
+    static constexpr int RING_SIZE_DEFAULT = FFT_SIZE * 4;
+    static constexpr double RING_LENGTH_SECONDS = 0.5;
+    static constexpr int WORKER_IDLE_WAIT_MS = 10;
+    static constexpr int WORKER_DORMANT_WAIT_MS = 100;
+    
+    // Subscriber counts per Consumer, plus a request to drop stale history when analysis restarts
+    static constexpr int NUM_CONSUMER_KINDS = 3;
+    std::array<std::atomic<int>, NUM_CONSUMER_KINDS> subscriberCounts {};
+    std::atomic<bool> warmUpPending{false};
+    std::atomic<bool> meterWarmUpPending{false};
+    
+    // Ring samples the worker passes over because they were written before their consumer started
+    int analysisSamplesToSkip = 0;
+    int meterSamplesToSkip = 0;
     
-    // FFT processing
-    juce::dsp::FFT fft;
+    // BS.1770 metering (analysis worker only) and its published readings
+    DynamicEQ::MeteringEngine inputMeter, outputMeter;
+    DynamicEQ::SeqLock<MeterReadings> inputMeterReadings, outputMeterReadings;
+    DynamicEQ::SeqLock<DynamicEQ::MeteringEngine::Ballistics> requestedBallistics;
+    uint32_t appliedBallisticsVersion = 0;
+    std::atomic<bool> loudnessResetPending{false};
+    DynamicEQ::LoudnessMatcher* loudnessMatcher = nullptr;
     
-    // Audio data buffers
+    // Sliding STFT history (the newest stftSize samples of each stream)
     std::vector<float> inputFifo, outputFifo;
-    std::vector<float> inputFFTData, outputFFTData;
+    
+    // Newest FFT_SIZE input samples for live feature extraction, a ring starting at featureHistoryIndex.
+    // Independent of the display resolution, so live features see the same frame length as offline ones
+    std::vector<float> featureHistory;
+    int featureHistoryIndex = 0;
+    
+    // featureHistory unrolled oldest first, handed to the live feature thread. Written by the analysis
+    // worker only while featureFramePending is false, read by the feature thread while it is true
+    std::vector<float> featureFrame;
+    double featureFrameSampleRate = 44100.0;
+    std::atomic<bool> featureFramePending{false};
+    
+    /** Extracts live features off the analysis worker - an extraction can wait for the one a reference
+        analysis holds, and the spectrum and meters must keep running meanwhile */
+    struct LiveFeatureThread : public juce::Thread
+    {
+        explicit LiveFeatureThread(SpectrumAnalyzer& ownerToUse) : juce::Thread("VTR Live Features"), owner(ownerToUse) {}
+        void run() override;
+        SpectrumAnalyzer& owner;
+    };
+    LiveFeatureThread liveFeatureThread { *this };
     
     // Spectrum data with peak hold
     std::vector<float> inputSpectrum, outputSpectrum;
+    std::vector<float> spectrumFrequencies;
+    
+    /** Worker-side recipe for one column: a range of spectrum points, or an interpolation when lastPoint < firstPoint */
+    struct ColumnSource
+    {
+        int firstPoint = 0;
+        int lastPoint = 0;
+        float fraction = 0.0f;
+    };
+    
+    struct ColumnMap
+    {
+        ColumnLayout layout;
+        std::vector<ColumnSource> sources;
+    };
+    
+    // Column layouts requested by subscribers, and the maps the worker built from them
+    std::mutex columnLayoutMutex;
+    std::array<ColumnLayout, MAX_COLUMN_LAYOUTS> requestedColumnLayouts;
+    std::array<bool, MAX_COLUMN_LAYOUTS> columnSlotInUse {};
+    std::atomic<bool> columnLayoutsChanged{false};
+    std::array<ColumnMap, MAX_COLUMN_LAYOUTS> columnMaps;
+    
+    /** Recent frames of a keepHistory slot - numRows rows of layout.numColumns values, the oldest at readRow */
+    struct ColumnHistory
+    {
+        std::mutex mutex; // analysis worker <-> GUI, held for one row copy or one read
+        ColumnLayout layout;
+        std::vector<float> inputMax, outputMax;
+        int readRow = 0;
+        int numRows = 0;
+    };
+    std::array<ColumnHistory, MAX_COLUMN_LAYOUTS> columnHistories;
+    static constexpr int COLUMN_HISTORY_FRAMES = 256; // several refresh ticks even at the shortest hop
+    
+    // Analysis worker -> GUI hand-off
+    DynamicEQ::TripleBuffer<SpectrumFrame> spectrumFrames;
+    std::atomic<uint64_t> publishedSequence{0};
     std::vector<float> inputPeakHold, outputPeakHold;
     std::vector<float> inputPeakTimer, outputPeakTimer;
     
     // Thread safety
-    mutable std::mutex spectrumMutex;
+    mutable std::mutex spectrumMutex; // guards the latest features (analysis worker <-> GUI)
     
     // Configuration
     double sampleRate = 44100.0;
     int fifoIndex = 0;
-    bool nextFFTBlockReady = false;
     
-    // Peak hold decay
-    float peakDecayRate = 0.0f;
+    // Peak hold timing per STFT frame
+    float frameDurationSeconds = 0.0f;
     
     // VTR3 Feature extraction state
     std::vector<float> latestFeatures;
     std::atomic<bool> newFeaturesAvailable{false};
     std::atomic<bool> featureExtractionEnabled{false};
-    float featureUpdateRateHz = 10.0f; // 10 Hz default
-    int featureUpdateCounter = 0;
+    std::atomic<float> requestedFeatureUpdateRateHz{10.0f}; // 10 Hz default, applied with the STFT settings
+    int featureUpdateCounter = 0; // analysis worker only
     int featureUpdateInterval = 1;
     
-    // Feature extraction backend
+    // Feature extraction backend - the native path matches librosa, so the embedded interpreter is opt-in.
+    // Set on the message thread, read by the extracting threads
+    std::atomic<FeatureExtractionBackend> currentBackend { FeatureExtractionBackend::JUCE_BASED };
 #ifdef HAVE_ESSENTIA
-    FeatureExtractionBackend currentBackend = FeatureExtractionBackend::PYTHON_LIBROSA;
     std::unique_ptr<EssentiaFeatureExtractor> essentiaExtractor;
-#else
-    FeatureExtractionBackend currentBackend = FeatureExtractionBackend::PYTHON_LIBROSA;
 #endif
     
     // Feature extractor for backend switching
@@ -3,9 +3,6 @@
 SpectrumDisplay::SpectrumDisplay(SpectrumAnalyzer& analyzer)
     : spectrumAnalyzer(analyzer)
 {
-    // Start timer for 30Hz updates
-    startTimer(static_cast<int>(1000.0f / UPDATE_RATE_HZ));
-    
     // Make this component paint over other components
     setAlwaysOnTop(false);
     setInterceptsMouseClicks(false, false);
@@ -14,7 +11,7 @@ SpectrumDisplay::SpectrumDisplay(SpectrumAnalyzer& analyzer)
 void SpectrumDisplay::paint(juce::Graphics& g)
 {
     // Draw test lines if no audio data available
-    if (inputSpectrum.empty() && outputSpectrum.empty())
+    if (!hasSpectrumData)
     {
         g.setColour(juce::Colours::yellow);
         g.drawText("Spectrum Display Active (No Audio)", getLocalBounds(), juce::Justification::centred);
@@ -23,33 +20,72 @@ void SpectrumDisplay::paint(juce::Graphics& g)
     
     // Set alpha for secondary display priority
     g.setOpacity(alpha);
+    spectrumLayer.draw(g, getLocalBounds().toFloat());
+}
+
+void SpectrumDisplay::renderSpectrumLayer()
+{
+    const auto& frame = spectrumAnalyzer.acquireSpectrumFrame();
+    lastSpectrumSequence = frame.sequence;
+    hasSpectrumData = !frame.inputSpectrum.empty() || !frame.outputSpectrum.empty();
     
-    // Draw input spectrum
-    if ((displayMode == DisplayMode::Input || displayMode == DisplayMode::Both) && !inputSpectrum.empty())
+    if (!hasSpectrumData)
     {
-        juce::Path inputPath = createSpectrumPath(inputSpectrum, true);
-        g.setColour(inputColor);
-        g.strokePath(inputPath, juce::PathStrokeType(3.0f)); // Thicker line
+        repaint();
+        return;
     }
     
-    // Draw output spectrum
-    if ((displayMode == DisplayMode::Output || displayMode == DisplayMode::Both) && !outputSpectrum.empty())
+    // Column maxima keep narrow peaks visible, as drawing every bin did
+    const auto* columns = columnPath.findColumns(spectrumSubscription, frame);
+    juce::Path inputPath, outputPath;
+    
+    if ((displayMode == DisplayMode::Input || displayMode == DisplayMode::Both) && !frame.inputSpectrum.empty())
+        inputPath = columns != nullptr ? ColumnPath::createPath(columns->inputMax, getLocalBounds().toFloat(), MIN_MAGNITUDE_DB, MAX_MAGNITUDE_DB)
+                                       : createSpectrumPath(frame.inputSpectrum, frame.frequencies, true);
+    
+    if ((displayMode == DisplayMode::Output || displayMode == DisplayMode::Both) && !frame.outputSpectrum.empty())
+        outputPath = columns != nullptr ? ColumnPath::createPath(columns->outputMax, getLocalBounds().toFloat(), MIN_MAGNITUDE_DB, MAX_MAGNITUDE_DB)
+                                        : createSpectrumPath(frame.outputSpectrum, frame.frequencies, false);
+    
+    // Stroking is the expensive part, so it runs on the render thread
+    spectrumLayer.render([inputPath, outputPath, inputColour = inputColor, outputColour = outputColor](juce::Graphics& g)
     {
-        juce::Path outputPath = createSpectrumPath(outputSpectrum, false);
-        g.setColour(outputColor);
+        g.setColour(inputColour);
+        g.strokePath(inputPath, juce::PathStrokeType(3.0f)); // Thicker line
+        
+        g.setColour(outputColour);
         g.strokePath(outputPath, juce::PathStrokeType(3.0f)); // Thicker line
-    }
+    });
 }
 
 void SpectrumDisplay::resized()
 {
-    // Component resized, paths will be recreated on next paint
+    // One column per pixel - the analyzer rebuilds its map for the new width
+    columnPath.update(spectrumSubscription, getWidth());
+    renderSpectrumLayer();
+}
+
+void SpectrumDisplay::visibilityChanged()
+{
+    // Only keep the analyzer busy while this display can actually be seen
+    if (isVisible())
+    {
+        if (!spectrumSubscription.isActive())
+        {
+            spectrumSubscription = spectrumAnalyzer.subscribe(SpectrumAnalyzer::Consumer::Spectrum);
+            columnPath.update(spectrumSubscription, getWidth());
+        }
+    }
+    else
+    {
+        spectrumSubscription.reset();
+    }
 }
 
 void SpectrumDisplay::setDisplayMode(DisplayMode mode)
 {
     displayMode = mode;
-    repaint();
+    renderSpectrumLayer();
 }
 
 void SpectrumDisplay::setAlpha(float newAlpha)
@@ -58,22 +94,22 @@ void SpectrumDisplay::setAlpha(float newAlpha)
     repaint();
 }
 
-void SpectrumDisplay::timerCallback()
+void SpectrumDisplay::refresh(double elapsedSeconds)
 {
-    updateSpectrumData();
+    juce::ignoreUnused(elapsedSeconds);
+    
+    if (isShowing())
+        updateSpectrumData();
 }
 
 void SpectrumDisplay::updateSpectrumData()
 {
-    // Get fresh spectrum data
-    inputSpectrum = spectrumAnalyzer.getInputSpectrum();
-    outputSpectrum = spectrumAnalyzer.getOutputSpectrum();
-    
-    // Trigger repaint
-    repaint();
+    // Only re-render when the analyzer has published a new frame
+    if (spectrumAnalyzer.getSpectrumSequence() != lastSpectrumSequence)
+        renderSpectrumLayer();
 }
 
-juce::Path SpectrumDisplay::createSpectrumPath(const std::vector<float>& spectrum, bool isInput)
+juce::Path SpectrumDisplay::createSpectrumPath(const std::vector<float>& spectrum, const std::vector<float>& frequencies, bool isInput)
 {
     juce::ignoreUnused(isInput);
     juce::Path path;
@@ -88,11 +124,11 @@ juce::Path SpectrumDisplay::createSpectrumPath(const std::vector<float>& spectru
     // Start path
     bool pathStarted = false;
     
-    // Convert spectrum data to path
-    for (size_t i = 1; i < spectrum.size(); ++i) // Skip DC component
+    // Convert spectrum data to path - frequencies come from the analyzer (linear bins or its log grid)
+    const size_t numPoints = juce::jmin(spectrum.size(), frequencies.size());
+    for (size_t i = 0; i < numPoints; ++i)
     {
-        // Calculate frequency for this bin
-        const float frequency = (static_cast<float>(i) * static_cast<float>(spectrumAnalyzer.getSampleRate())) / (2.0f * SpectrumAnalyzer::FFT_SIZE);
+        const float frequency = frequencies[i];
         
         // Skip frequencies outside our range
         if (frequency < MIN_FREQUENCY || frequency > MAX_FREQUENCY)
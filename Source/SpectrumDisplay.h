@@ -2,8 +2,11 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "SpectrumAnalyzer.h"
+#include "ColumnPath.h"
+#include "VisualizerRenderer.h"
+#include "RefreshScheduler.h"
 
-class SpectrumDisplay : public juce::Component, private juce::Timer
+class SpectrumDisplay : public juce::Component, public RefreshScheduler::Client
 {
 public:
     enum class DisplayMode
@@ -17,34 +20,41 @@ public:
     
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void visibilityChanged() override;
     
     void setDisplayMode(DisplayMode mode);
     void setAlpha(float alpha);
     
 private:
-    void timerCallback() override;
+    void refresh(double elapsedSeconds) override;
     void updateSpectrumData();
-    juce::Path createSpectrumPath(const std::vector<float>& spectrum, bool isInput);
+    void renderSpectrumLayer();
+    juce::Path createSpectrumPath(const std::vector<float>& spectrum, const std::vector<float>& frequencies, bool isInput);
     
     float frequencyToX(float frequency) const;
     float magnitudeToY(float magnitudeDB) const;
     
     SpectrumAnalyzer& spectrumAnalyzer;
+    SpectrumAnalyzer::Subscription spectrumSubscription; // held while visible
+    ColumnPath columnPath { MIN_FREQUENCY, MAX_FREQUENCY, SPECTRUM_SMOOTHING_OCTAVES }; // one column per pixel
     
     // Display settings
     DisplayMode displayMode = DisplayMode::Both;
     float alpha = 0.3f; // Secondary display priority
     
-    // Spectrum data
-    std::vector<float> inputSpectrum;
-    std::vector<float> outputSpectrum;
+    // Sequence number of the last spectrum frame drawn
+    uint64_t lastSpectrumSequence = 0;
+    bool hasSpectrumData = false;
+    
+    // Spectrum paths are stroked on the shared render thread; paint() blits the result
+    VisualizerRenderer::Layer spectrumLayer { *this };
     
     // Visual parameters
     static constexpr float MIN_FREQUENCY = 20.0f;
     static constexpr float MAX_FREQUENCY = 20000.0f;
     static constexpr float MIN_MAGNITUDE_DB = -40.0f;
     static constexpr float MAX_MAGNITUDE_DB = 40.0f;
-    static constexpr float UPDATE_RATE_HZ = 30.0f;
+    static constexpr float SPECTRUM_SMOOTHING_OCTAVES = 0.0f; // e.g. 1.0f / 6.0f for sixth-octave smoothing
     
     // Colors (more visible for testing)
     juce::Colour inputColor = juce::Colour(0xFF00FF00);   // Bright green
@@ -1,35 +1,43 @@
 #include "ExternalFeatureExtractor.h"
-#include <nlohmann/json.hpp>
+#include <juce_core/juce_core.h>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
-#include <unistd.h>
-#include <signal.h>
-#include <sys/wait.h>
-#include <chrono>
-#include <sstream>
-#include <iomanip>
+#include <thread>
 
 #ifdef _WIN32
     #include <windows.h>
-    #include <io.h>
-    #define popen _popen
-    #define pclose _pclose
 #else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <signal.h>
     #include <spawn.h>
+    #include <sys/mman.h>
+    #include <sys/socket.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
     extern char **environ;
 #endif
 
 namespace VTR {
 
-using json = nlohmann::json;
-
-// Base64 encoding table
-static const char base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+struct ExternalFeatureExtractor::ProcessHandles
+{
+#ifdef _WIN32
+    HANDLE input = nullptr;   // write end of the child's stdin
+    HANDLE output = nullptr;  // read end of the child's stdout
+    HANDLE process = nullptr;
+#else
+    int socket = -1;          // our end of the socket pair that is the child's stdin and stdout
+    pid_t pid = -1;
+#endif
+};
 
-ExternalFeatureExtractor::ExternalFeatureExtractor()
-    : process(std::make_unique<ProcessHandles>())
+ExternalFeatureExtractor::ExternalFeatureExtractor(std::string executablePathToUse)
+    : process(std::make_unique<ProcessHandles>()),
+      executablePath(std::move(executablePathToUse))
 {
-    startProcess();
 }
 
 ExternalFeatureExtractor::~ExternalFeatureExtractor()
@@ -126,11 +134,39 @@ std::string ExternalFeatureExtractor::getExecutablePath()
 bool ExternalFeatureExtractor::startProcess()
 {
     std::lock_guard<std::mutex> lock(processMutex);
-    
+    return startProcessLocked();
+}
+
+void ExternalFeatureExtractor::stopProcess()
+{
+    std::lock_guard<std::mutex> lock(processMutex);
+    stopProcessLocked(true);
+    releaseSharedAudio();
+}
+
+void ExternalFeatureExtractor::setTimeouts(const Timeouts& newTimeouts)
+{
+    std::lock_guard<std::mutex> lock(processMutex);
+    timeouts = newTimeouts;
+}
+
+std::string ExternalFeatureExtractor::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(processMutex);
+    return lastError;
+}
+
+ExternalFeatureExtractor::Deadline ExternalFeatureExtractor::deadlineAfter(int milliseconds)
+{
+    return std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+}
+
+bool ExternalFeatureExtractor::startProcessLocked()
+{
     if (processRunning)
         return true;
     
-    std::string execPath = getExecutablePath();
+    const std::string execPath = executablePath.empty() ? getExecutablePath() : executablePath;
     if (execPath.empty())
     {
         setError("Feature extractor executable not found");
@@ -138,25 +174,31 @@ bool ExternalFeatureExtractor::startProcess()
     }
     
 #ifdef _WIN32
-    // Windows implementation using CreateProcess
     SECURITY_ATTRIBUTES saAttr;
     saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
     saAttr.bInheritHandle = TRUE;
     saAttr.lpSecurityDescriptor = NULL;
     
-    HANDLE hChildStdinRd, hChildStdinWr, hChildStdoutRd, hChildStdoutWr;
+    HANDLE hChildStdinRd = nullptr, hChildStdinWr = nullptr, hChildStdoutRd = nullptr, hChildStdoutWr = nullptr;
     
     if (!CreatePipe(&hChildStdinRd, &hChildStdinWr, &saAttr, 0) ||
         !CreatePipe(&hChildStdoutRd, &hChildStdoutWr, &saAttr, 0))
     {
+        for (HANDLE handle : { hChildStdinRd, hChildStdinWr, hChildStdoutRd, hChildStdoutWr })
+            if (handle != nullptr)
+                CloseHandle(handle);
         setError("Failed to create pipes");
         return false;
     }
     
-    STARTUPINFO siStartInfo;
-    ZeroMemory(&siStartInfo, sizeof(STARTUPINFO));
-    siStartInfo.cb = sizeof(STARTUPINFO);
-    siStartInfo.hStdError = hChildStdoutWr;
+    // Our ends must not be inherited, or the child never sees end-of-file on its stdin
+    SetHandleInformation(hChildStdinWr, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(hChildStdoutRd, HANDLE_FLAG_INHERIT, 0);
+    
+    STARTUPINFOA siStartInfo;
+    ZeroMemory(&siStartInfo, sizeof(STARTUPINFOA));
+    siStartInfo.cb = sizeof(STARTUPINFOA);
+    siStartInfo.hStdError = GetStdHandle(STD_ERROR_HANDLE); // kept off the protocol pipe
     siStartInfo.hStdOutput = hChildStdoutWr;
     siStartInfo.hStdInput = hChildStdinRd;
     siStartInfo.dwFlags |= STARTF_USESTDHANDLES;
@@ -164,76 +206,75 @@ bool ExternalFeatureExtractor::startProcess()
     PROCESS_INFORMATION piProcInfo;
     ZeroMemory(&piProcInfo, sizeof(PROCESS_INFORMATION));
     
-    std::string cmdLine = execPath + " --daemon";
-    if (!CreateProcess(NULL, const_cast<char*>(cmdLine.c_str()), NULL, NULL, TRUE, 0, NULL, NULL, &siStartInfo, &piProcInfo))
-    {
-        setError("Failed to start process");
-        return false;
-    }
+    std::string cmdLine = "\"" + execPath + "\" --daemon";
+    const bool started = CreateProcessA(NULL, &cmdLine[0], NULL, NULL, TRUE, CREATE_NO_WINDOW, NULL, NULL, &siStartInfo, &piProcInfo);
     
     CloseHandle(hChildStdinRd);
     CloseHandle(hChildStdoutWr);
     
-    process->stdinPipe = _fdopen(_open_osfhandle((intptr_t)hChildStdinWr, 0), "wb");
-    process->stdoutPipe = _fdopen(_open_osfhandle((intptr_t)hChildStdoutRd, 0), "rb");
-    process->pid = piProcInfo.dwProcessId;
-    
-#else
-    // POSIX implementation using pipe() and fork()
-    int stdinPipe[2];
-    int stdoutPipe[2];
-    
-    if (pipe(stdinPipe) != 0 || pipe(stdoutPipe) != 0)
+    if (!started)
     {
-        setError("Failed to create pipes");
+        CloseHandle(hChildStdinWr);
+        CloseHandle(hChildStdoutRd);
+        setError("Failed to start process");
         return false;
     }
     
-    pid_t pid = fork();
-    if (pid < 0)
+    CloseHandle(piProcInfo.hThread);
+    process->input = hChildStdinWr;
+    process->output = hChildStdoutRd;
+    process->process = piProcInfo.hProcess;
+#else
+    // One socket pair for both directions: unlike a pipe, writes to it can be kept from raising SIGPIPE
+    // in the host when the child dies
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
     {
-        setError("Failed to fork process");
+        setError("Failed to create the extractor socket");
         return false;
     }
-    else if (pid == 0)
-    {
-        // Child process
-        close(stdinPipe[1]);  // Close write end of stdin pipe
-        close(stdoutPipe[0]); // Close read end of stdout pipe
-        
-        // Redirect stdin/stdout
-        dup2(stdinPipe[0], STDIN_FILENO);
-        dup2(stdoutPipe[1], STDOUT_FILENO);
-        dup2(stdoutPipe[1], STDERR_FILENO);
-        
-        // Close unused descriptors
-        close(stdinPipe[0]);
-        close(stdoutPipe[1]);
-        
-        // Execute the Python extractor
-        execl(execPath.c_str(), "vtr-feature-extractor", "--daemon", nullptr);
-        
-        // If we get here, exec failed
-        exit(1);
-    }
-    else
+    
+    // Neither end may leak into other children; the dup2s below clear the flag on the child's stdin/stdout
+    fcntl(sockets[0], F_SETFD, FD_CLOEXEC);
+    fcntl(sockets[1], F_SETFD, FD_CLOEXEC);
+   #ifdef SO_NOSIGPIPE
+    int noSigPipe = 1;
+    setsockopt(sockets[0], SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+   #endif
+    
+    // posix_spawn rather than fork - the host is multithreaded. stderr stays with the host so warnings
+    // cannot corrupt the protocol
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, sockets[1], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, sockets[1], STDOUT_FILENO);
+    
+    char* const argv[] = { const_cast<char*>(execPath.c_str()), const_cast<char*>("--daemon"), nullptr };
+    pid_t pid = -1;
+    const int spawnResult = posix_spawn(&pid, execPath.c_str(), &actions, nullptr, argv, environ);
+    
+    posix_spawn_file_actions_destroy(&actions);
+    close(sockets[1]);
+    
+    if (spawnResult != 0)
     {
-        // Parent process
-        close(stdinPipe[0]);  // Close read end of stdin pipe
-        close(stdoutPipe[1]); // Close write end of stdout pipe
-        
-        process->stdinPipe = fdopen(stdinPipe[1], "wb");
-        process->stdoutPipe = fdopen(stdoutPipe[0], "rb");
-        process->pid = pid;
+        close(sockets[0]);
+        setError("Failed to start " + execPath + ": " + std::strerror(spawnResult));
+        return false;
     }
+    
+    process->socket = sockets[0];
+    process->pid = pid;
 #endif
     
     // Wait for ready signal
-    json response;
-    if (!receiveMessage(response) || response["status"] != "ready")
+    ResponseHeader response;
+    std::vector<float> unusedFeatures;
+    std::string unusedMessage;
+    if (!receiveResponse(response, unusedFeatures, unusedMessage, deadlineAfter(timeouts.startMs)) || response.status != STATUS_READY)
     {
-        setError("Failed to receive ready signal from extractor");
-        stopProcess();
+        setError("Feature extractor did not report ready within " + std::to_string(timeouts.startMs) + " ms");
+        stopProcessLocked(false);
         return false;
     }
     
@@ -242,232 +283,314 @@ bool ExternalFeatureExtractor::startProcess()
     return true;
 }
 
-void ExternalFeatureExtractor::stopProcess()
+void ExternalFeatureExtractor::stopProcessLocked(bool graceful)
 {
-    std::lock_guard<std::mutex> lock(processMutex);
-    
-    if (!processRunning)
+#ifdef _WIN32
+    if (process->process == nullptr)
         return;
+#else
+    if (process->pid <= 0)
+        return;
+#endif
     
-    // Send exit command
-    json exitCmd;
-    exitCmd["command"] = "exit";
-    sendMessage(exitCmd);
-    
-    // Close pipes
-    if (process->stdinPipe)
+    // Exit command, then end-of-file - either one makes a healthy child leave its request loop
+    if (graceful && processRunning)
     {
-        fclose(process->stdinPipe);
-        process->stdinPipe = nullptr;
+        RequestHeader exitCmd;
+        exitCmd.command = COMMAND_EXIT;
+        sendRequest(exitCmd, nullptr, deadlineAfter(timeouts.exitMs));
     }
     
-    if (process->stdoutPipe)
+    const int waitMs = graceful ? timeouts.exitMs : 0;
+    
+#ifdef _WIN32
+    CloseHandle(process->input);
+    CloseHandle(process->output);
+    
+    if (WaitForSingleObject(process->process, static_cast<DWORD>(waitMs)) != WAIT_OBJECT_0)
     {
-        fclose(process->stdoutPipe);
-        process->stdoutPipe = nullptr;
+        TerminateProcess(process->process, 1);
+        WaitForSingleObject(process->process, INFINITE);
     }
     
-    // Wait for process to exit
-    if (process->pid > 0)
+    CloseHandle(process->process);
+#else
+    close(process->socket);
+    
+    const auto deadline = deadlineAfter(waitMs);
+    int status = 0;
+    while (waitpid(process->pid, &status, WNOHANG) == 0)
     {
-#ifdef _WIN32
-        HANDLE hProcess = OpenProcess(PROCESS_TERMINATE | SYNCHRONIZE, FALSE, process->pid);
-        if (hProcess)
+        if (std::chrono::steady_clock::now() >= deadline)
         {
-            WaitForSingleObject(hProcess, 5000);
-            CloseHandle(hProcess);
+            // SIGKILL cannot be ignored, so this wait is short
+            kill(process->pid, SIGKILL);
+            waitpid(process->pid, &status, 0);
+            break;
         }
-#else
-        int status;
-        waitpid(process->pid, &status, 0);
-#endif
-        process->pid = -1;
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
     }
+#endif
     
+    *process = ProcessHandles();
     processRunning = false;
     DBG("External feature extractor stopped");
 }
 
-std::string ExternalFeatureExtractor::base64Encode(const std::vector<float>& data)
+float* ExternalFeatureExtractor::acquireSharedAudio(size_t numSamples)
 {
-    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data());
-    size_t len = data.size() * sizeof(float);
+#ifdef _WIN32
+    juce::ignoreUnused(numSamples);
+    return nullptr;
+#else
+    if (sharedAudio.data != nullptr && sharedAudio.capacity >= numSamples)
+        return sharedAudio.data;
     
-    std::string encoded;
-    encoded.reserve(((len + 2) / 3) * 4);
+    // The child may still have the old segment mapped, so a larger one gets a fresh name rather
+    // than being resized in place
+    releaseSharedAudio();
     
-    for (size_t i = 0; i < len; i += 3)
+    // Grow in 1M-sample steps so references of similar length share a segment
+    constexpr size_t growthStep = 1 << 20;
+    const size_t capacity = ((numSamples + growthStep - 1) / growthStep) * growthStep;
+    const size_t bytes = capacity * sizeof(float);
+    
+    // Short enough for macOS's 31-character limit on shm names
+    const std::string name = "vtr-fx-" + std::to_string(getpid()) + "-" + std::to_string(++sharedAudioGeneration);
+    const std::string path = "/" + name;
+    
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        return nullptr;
+    
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0)
     {
-        unsigned char b1 = bytes[i];
-        unsigned char b2 = (i + 1 < len) ? bytes[i + 1] : 0;
-        unsigned char b3 = (i + 2 < len) ? bytes[i + 2] : 0;
-        
-        encoded += base64_table[b1 >> 2];
-        encoded += base64_table[((b1 & 0x03) << 4) | (b2 >> 4)];
-        encoded += (i + 1 < len) ? base64_table[((b2 & 0x0f) << 2) | (b3 >> 6)] : '=';
-        encoded += (i + 2 < len) ? base64_table[b3 & 0x3f] : '=';
+        close(fd);
+        shm_unlink(path.c_str());
+        return nullptr;
     }
     
-    return encoded;
+    void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        close(fd);
+        shm_unlink(path.c_str());
+        return nullptr;
+    }
+    
+    sharedAudio.name = name;
+    sharedAudio.data = static_cast<float*>(mapped);
+    sharedAudio.capacity = capacity;
+    sharedAudio.fd = fd;
+    return sharedAudio.data;
+#endif
 }
 
-bool ExternalFeatureExtractor::sendMessage(const json& message)
+void ExternalFeatureExtractor::releaseSharedAudio()
 {
-    if (!process->stdinPipe)
-        return false;
+#ifndef _WIN32
+    if (sharedAudio.data != nullptr)
+        munmap(sharedAudio.data, sharedAudio.capacity * sizeof(float));
     
-    std::string msgStr = message.dump();
-    uint32_t msgLen = static_cast<uint32_t>(msgStr.length());
+    if (sharedAudio.fd >= 0)
+    {
+        close(sharedAudio.fd);
+        shm_unlink(("/" + sharedAudio.name).c_str());
+    }
+#endif
     
-    // Write 4-byte length prefix
-    if (fwrite(&msgLen, sizeof(uint32_t), 1, process->stdinPipe) != 1)
-        return false;
+    sharedAudio = SharedAudioBuffer();
+}
+
+bool ExternalFeatureExtractor::writeExactly(const void* data, size_t numBytes, Deadline deadline)
+{
+    const auto* bytes = static_cast<const char*>(data);
     
-    // Write message
-    if (fwrite(msgStr.c_str(), 1, msgLen, process->stdinPipe) != msgLen)
-        return false;
+#ifdef _WIN32
+    // Anonymous pipes have no timed writes; the child reads requests as soon as it is idle, so only a
+    // child that is hung mid-extraction can hold this up
+    juce::ignoreUnused(deadline);
+    while (numBytes > 0)
+    {
+        DWORD written = 0;
+        const DWORD chunk = static_cast<DWORD>(std::min<size_t>(numBytes, 1 << 20));
+        if (!WriteFile(process->input, bytes, chunk, &written, nullptr) || written == 0)
+            return false;
+        bytes += written;
+        numBytes -= written;
+    }
+#else
+   #ifdef MSG_NOSIGNAL
+    constexpr int sendFlags = MSG_NOSIGNAL;
+   #else
+    constexpr int sendFlags = 0; // SO_NOSIGPIPE is set on the socket instead
+   #endif
+    
+    while (numBytes > 0)
+    {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        pollfd descriptor { process->socket, POLLOUT, 0 };
+        const int ready = poll(&descriptor, 1, static_cast<int>(std::max<int64_t>(0, remaining.count())));
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready <= 0)
+            return false;
+        
+        const ssize_t sent = send(process->socket, bytes, numBytes, sendFlags);
+        if (sent < 0 && (errno == EINTR || errno == EAGAIN))
+            continue;
+        if (sent <= 0)
+            return false;
+        bytes += sent;
+        numBytes -= static_cast<size_t>(sent);
+    }
+#endif
     
-    fflush(process->stdinPipe);
     return true;
 }
 
-bool ExternalFeatureExtractor::receiveMessage(json& message, int timeoutMs)
+bool ExternalFeatureExtractor::readExactly(void* data, size_t numBytes, Deadline deadline)
 {
-    if (!process->stdoutPipe)
-        return false;
+    auto* bytes = static_cast<char*>(data);
     
-    // Read 4-byte length prefix
-    uint32_t msgLen;
-    if (fread(&msgLen, sizeof(uint32_t), 1, process->stdoutPipe) != 1)
-        return false;
+    while (numBytes > 0)
+    {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        
+#ifdef _WIN32
+        // Anonymous pipes cannot be waited on, so poll for data
+        DWORD available = 0;
+        if (!PeekNamedPipe(process->output, nullptr, 0, nullptr, &available, nullptr))
+            return false;
+        
+        if (available == 0)
+        {
+            if (remaining.count() <= 0)
+                return false;
+            Sleep(1);
+            continue;
+        }
+        
+        DWORD received = 0;
+        if (!ReadFile(process->output, bytes, static_cast<DWORD>(std::min<size_t>(numBytes, available)), &received, nullptr) || received == 0)
+            return false;
+#else
+        pollfd descriptor { process->socket, POLLIN, 0 };
+        const int ready = poll(&descriptor, 1, static_cast<int>(std::max<int64_t>(0, remaining.count())));
+        if (ready < 0 && errno == EINTR)
+            continue;
+        if (ready <= 0)
+            return false;
+        
+        const ssize_t received = recv(process->socket, bytes, numBytes, 0);
+        if (received < 0 && (errno == EINTR || errno == EAGAIN))
+            continue;
+        if (received <= 0)
+            return false; // the child closed its end
+#endif
+        
+        bytes += received;
+        numBytes -= static_cast<size_t>(received);
+    }
     
-    // Sanity check
-    if (msgLen > 10 * 1024 * 1024) // 10MB max
+    return true;
+}
+
+bool ExternalFeatureExtractor::sendRequest(const RequestHeader& header, const float* inlineSamples, Deadline deadline)
+{
+    if (!writeExactly(&header, sizeof(RequestHeader), deadline))
         return false;
     
-    // Read message
-    std::vector<char> buffer(msgLen + 1);
-    if (fread(buffer.data(), 1, msgLen, process->stdoutPipe) != msgLen)
-        return false;
+    // Raw float32 frames follow the header when the audio is not in shared memory
+    if (inlineSamples != nullptr && header.numSamples > 0)
+        return writeExactly(inlineSamples, static_cast<size_t>(header.numSamples) * sizeof(float), deadline);
     
-    buffer[msgLen] = '\0';
+    return true;
+}
+
+bool ExternalFeatureExtractor::receiveResponse(ResponseHeader& header, std::vector<float>& features, std::string& message, Deadline deadline)
+{
+    if (!readExactly(&header, sizeof(ResponseHeader), deadline))
+        return false;
     
-    try
+    if (header.magic != PROTOCOL_MAGIC || header.version != PROTOCOL_VERSION)
     {
-        message = json::parse(buffer.data());
-        return true;
+        setError("Feature extractor speaks a different protocol version");
+        return false;
     }
-    catch (const json::exception& e)
+    
+    // Sanity check
+    if (header.numFeatures > MAX_RESPONSE_FEATURES || header.messageLength > MAX_RESPONSE_MESSAGE)
     {
-        setError("Failed to parse JSON response: " + std::string(e.what()));
+        setError("Malformed response from the feature extractor");
         return false;
     }
+    
+    features.resize(header.numFeatures);
+    message.resize(header.messageLength);
+    return readExactly(features.data(), features.size() * sizeof(float), deadline)
+        && readExactly(&message[0], message.size(), deadline);
 }
 
-std::vector<float> ExternalFeatureExtractor::extractAllFeatures(const float* audioData, 
-                                                               size_t numSamples, 
-                                                               double sampleRate)
+std::vector<float> ExternalFeatureExtractor::extractFeatures(const std::vector<float>& audioData, double sampleRate)
 {
-    if (!processRunning && !startProcess())
-    {
-        DBG("Failed to start feature extractor process");
-        return std::vector<float>(17, 0.0f);
-    }
-    
     std::lock_guard<std::mutex> lock(processMutex);
+    lastError.clear();
     
-    // Prepare audio data
-    std::vector<float> audioVec(audioData, audioData + numSamples);
+    if (!startProcessLocked())
+    {
+        DBG("Failed to start feature extractor process: " << lastError);
+        return {};
+    }
     
     // Create request
-    json request;
-    request["audio_data"] = base64Encode(audioVec);
-    request["sr"] = static_cast<int>(sampleRate);
-    
-    // Send request
-    if (!sendMessage(request))
+    RequestHeader request;
+    request.command = COMMAND_EXTRACT;
+    request.sampleRate = static_cast<uint32_t>(sampleRate);
+    request.numSamples = audioData.size();
+    
+    // The audio goes through shared memory when possible - one memcpy instead of a pipe transfer
+    const float* inlineSamples = audioData.data();
+    if (float* shared = acquireSharedAudio(audioData.size()))
     {
-        DBG("Failed to send message to feature extractor");
-        return std::vector<float>(17, 0.0f);
+        std::copy(audioData.begin(), audioData.end(), shared);
+        request.flags |= FLAG_SHARED_MEMORY;
+        std::strncpy(request.shmName, sharedAudio.name.c_str(), SHM_NAME_SIZE - 1);
+        inlineSamples = nullptr;
     }
     
-    // Receive response
-    json response;
-    if (!receiveMessage(response))
+    const auto deadline = deadlineAfter(timeouts.requestMs);
+    ResponseHeader response;
+    std::vector<float> features;
+    std::string message;
+    
+    if (!sendRequest(request, inlineSamples, deadline) || !receiveResponse(response, features, message, deadline))
     {
-        DBG("Failed to receive response from feature extractor");
-        return std::vector<float>(17, 0.0f);
+        // Part of the request or the response may still be in flight, so nothing more can be read from this
+        // child reliably. It is killed and the next request starts a fresh one
+        if (lastError.empty())
+            setError("Feature extractor did not answer within " + std::to_string(timeouts.requestMs) + " ms or exited");
+        DBG("Feature extraction failed: " << lastError);
+        stopProcessLocked(false);
+        return {};
     }
     
-    // Check response status
-    if (response["status"] != "success")
+    // An error response was read in full, so the stream is still in step and the child stays up
+    if (response.status != STATUS_SUCCESS)
     {
-        std::string error = response.value("message", "Unknown error");
-        DBG("Feature extraction failed: " << error);
-        return std::vector<float>(17, 0.0f);
+        setError(message.empty() ? std::string("Unknown error") : message);
+        DBG("Feature extraction failed: " << lastError);
+        return {};
     }
     
-    // Extract features
-    std::vector<float> features = response["features"].get<std::vector<float>>();
-    
-    if (features.size() != 17)
+    if (features.size() != FEATURE_VECTOR_SIZE)
     {
-        DBG("Unexpected number of features: " << features.size());
-        return std::vector<float>(17, 0.0f);
+        setError("Unexpected number of features: " + std::to_string(features.size()));
+        return {};
     }
     
     return features;
 }
 
-std::vector<float> ExternalFeatureExtractor::extractFeatures(const float* audioData, 
-                                                            size_t numSamples, 
-                                                            double sampleRate)
-{
-    return extractAllFeatures(audioData, numSamples, sampleRate);
-}
-
-float ExternalFeatureExtractor::extractSpectralCentroid(const float* audioData, 
-                                                       size_t numSamples, 
-                                                       double sampleRate)
-{
-    auto features = extractAllFeatures(audioData, numSamples, sampleRate);
-    return features[0]; // spectral_centroid is first
-}
-
-float ExternalFeatureExtractor::extractSpectralBandwidth(const float* audioData, 
-                                                        size_t numSamples, 
-                                                        double sampleRate)
-{
-    auto features = extractAllFeatures(audioData, numSamples, sampleRate);
-    return features[1]; // spectral_bandwidth is second
-}
-
-float ExternalFeatureExtractor::extractSpectralRolloff(const float* audioData, 
-                                                      size_t numSamples, 
-                                                      double sampleRate)
-{
-    auto features = extractAllFeatures(audioData, numSamples, sampleRate);
-    return features[2]; // spectral_rolloff is third
-}
-
-std::vector<float> ExternalFeatureExtractor::extractMFCC(const float* audioData, 
-                                                        size_t numSamples, 
-                                                        double sampleRate, 
-                                                        int numCoefficients)
-{
-    auto features = extractAllFeatures(audioData, numSamples, sampleRate);
-    
-    // MFCCs are indices 3-15 (13 coefficients)
-    int actualCoeffs = std::min(numCoefficients, 13);
-    return std::vector<float>(features.begin() + 3, features.begin() + 3 + actualCoeffs);
-}
-
-float ExternalFeatureExtractor::extractRMS(const float* audioData, 
-                                          size_t numSamples, 
-                                          double sampleRate)
-{
-    auto features = extractAllFeatures(audioData, numSamples, sampleRate);
-    return features[16]; // rms_energy is last
-}
-
-} // namespace VTR
\ No newline at end of file
+} // namespace VTR
@@ -1,86 +1,135 @@
 #pragma once
 
-#include "FeatureExtractor.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
-#include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
-#include <atomic>
+#include <string>
+#include <vector>
 
 namespace VTR {
 
 /**
- * External feature extractor that communicates with standalone Python executable
- * Uses JSON protocol over stdin/stdout pipes
+ * Feature extraction in the standalone extractor executable (standalone_extractor/), run as a child process
+ * so the host never loads Python. FeatureExtractor uses it for Backend::EXTERNAL_PROCESS
+ * Binary protocol over the child's stdin/stdout: fixed little-endian headers, with the audio handed over in a
+ * POSIX shared-memory segment (raw float32 after the header where that is unavailable). Every read, write and
+ * wait is bounded; a child that hangs or breaks the protocol is killed and the next request starts a new one
  */
-class ExternalFeatureExtractor : public FeatureExtractor
+class ExternalFeatureExtractor
 {
 public:
-    ExternalFeatureExtractor();
-    ~ExternalFeatureExtractor() override;
-
-    // FeatureExtractor interface
-    std::vector<float> extractFeatures(const float* audioData, 
-                                     size_t numSamples, 
-                                     double sampleRate) override;
-    
-    float extractSpectralCentroid(const float* audioData, 
-                                 size_t numSamples, 
-                                 double sampleRate) override;
-    
-    float extractSpectralBandwidth(const float* audioData, 
-                                  size_t numSamples, 
-                                  double sampleRate) override;
-    
-    float extractSpectralRolloff(const float* audioData, 
-                                size_t numSamples, 
-                                double sampleRate) override;
-    
-    std::vector<float> extractMFCC(const float* audioData, 
-                                  size_t numSamples, 
-                                  double sampleRate, 
-                                  int numCoefficients = 13) override;
-    
-    float extractRMS(const float* audioData, 
-                    size_t numSamples, 
-                    double sampleRate) override;
-
-    // Process management
+    // An empty path is looked up with getExecutablePath() each time the process starts
+    explicit ExternalFeatureExtractor(std::string executablePathToUse = {});
+    ~ExternalFeatureExtractor();
+
+    /** The 17 features in FeatureExtractor::extractFeatures order, starting the child if it is not running.
+        Empty if the child cannot be started or the request fails - getLastError() says why */
+    std::vector<float> extractFeatures(const std::vector<float>& audioData, double sampleRate);
+
+    // Process management - extractFeatures starts the process on demand
     bool startProcess();
     void stopProcess();
     bool isProcessRunning() const { return processRunning.load(); }
-    
+
+    struct Timeouts
+    {
+        int startMs = 60000;   // until the child reports ready (interpreter start-up and the librosa import)
+        int requestMs = 60000; // one extraction, including numba's compilation on the first one
+        int exitMs = 2000;     // before a child that ignores the exit command is killed
+    };
+
+    void setTimeouts(const Timeouts& newTimeouts);
+    std::string getLastError() const;
+
     // Get path to the external executable
     static std::string getExecutablePath();
 
 private:
-    // Process communication
-    struct ProcessHandles {
-        FILE* stdinPipe = nullptr;
-        FILE* stdoutPipe = nullptr;
-        pid_t pid = -1;
-    };
-    
+    using Deadline = std::chrono::steady_clock::time_point;
+    static Deadline deadlineAfter(int milliseconds);
+
+    // Platform pipe/socket and process handles, defined in the .cpp
+    struct ProcessHandles;
+
     std::unique_ptr<ProcessHandles> process;
     std::atomic<bool> processRunning{false};
-    std::mutex processMutex;
-    
-    // Message sending/receiving
-    bool sendMessage(const nlohmann::json& message);
-    bool receiveMessage(nlohmann::json& message, int timeoutMs = 5000);
-    
-    // Helper to extract all features at once (more efficient)
-    std::vector<float> extractAllFeatures(const float* audioData, 
-                                         size_t numSamples, 
-                                         double sampleRate);
-    
-    // Base64 encoding for audio data
-    static std::string base64Encode(const std::vector<float>& data);
-    
+    mutable std::mutex processMutex; // one request at a time; guards everything below
+    std::string executablePath;
+    Timeouts timeouts;
+
+    // Binary protocol, mirrored in standalone_extractor/feature_extractor.py. Headers are written as-is,
+    // so both ends are assumed little-endian
+    static constexpr uint32_t PROTOCOL_MAGIC = 0x58525456; // "VTRX"
+    static constexpr uint16_t PROTOCOL_VERSION = 2;
+    static constexpr uint16_t COMMAND_EXTRACT = 1;
+    static constexpr uint16_t COMMAND_EXIT = 2;
+    static constexpr uint16_t STATUS_SUCCESS = 0;
+    static constexpr uint16_t STATUS_ERROR = 1;
+    static constexpr uint16_t STATUS_READY = 2;
+    static constexpr uint16_t STATUS_EXIT = 3;
+    static constexpr uint32_t FLAG_SHARED_MEMORY = 1; // samples are in shmName, not after the header
+    static constexpr size_t SHM_NAME_SIZE = 32;
+    static constexpr uint32_t MAX_RESPONSE_FEATURES = 64;
+    static constexpr uint32_t MAX_RESPONSE_MESSAGE = 64 * 1024;
+    static constexpr size_t FEATURE_VECTOR_SIZE = 17;
+
+    struct RequestHeader {
+        uint32_t magic = PROTOCOL_MAGIC;
+        uint16_t version = PROTOCOL_VERSION;
+        uint16_t command = COMMAND_EXTRACT;
+        uint32_t sampleRate = 0;
+        uint32_t flags = 0;
+        uint64_t numSamples = 0;
+        char shmName[SHM_NAME_SIZE] = {}; // without the leading '/', NUL-padded
+    };
+
+    struct ResponseHeader {
+        uint32_t magic = 0;
+        uint16_t version = 0;
+        uint16_t status = 0;
+        uint32_t numFeatures = 0;   // float32 values following the header
+        uint32_t messageLength = 0; // UTF-8 error text following the features
+    };
+
+    static_assert(sizeof(RequestHeader) == 56, "RequestHeader layout is part of the protocol");
+    static_assert(sizeof(ResponseHeader) == 16, "ResponseHeader layout is part of the protocol");
+
+    // The rest expects processMutex to be held
+    bool startProcessLocked();
+
+    // Asks the child to exit, then kills it if it is still there after timeouts.exitMs (at once when not graceful)
+    void stopProcessLocked(bool graceful);
+
+    // Message sending/receiving. inlineSamples (numSamples of them) follow the header when given. A false
+    // return leaves the stream in an unknown state - the caller restarts the child to get back in step
+    bool sendRequest(const RequestHeader& header, const float* inlineSamples, Deadline deadline);
+    bool receiveResponse(ResponseHeader& header, std::vector<float>& features, std::string& message, Deadline deadline);
+
+    // False on timeout or when the child has gone
+    bool writeExactly(const void* data, size_t numBytes, Deadline deadline);
+    bool readExactly(void* data, size_t numBytes, Deadline deadline);
+
+    // Shared-memory segment the audio is copied into. Reused across requests and replaced by a larger
+    // one (under a new name) when a longer reference arrives
+    struct SharedAudioBuffer {
+        std::string name;
+        float* data = nullptr;
+        size_t capacity = 0; // in samples
+        int fd = -1;
+    };
+
+    SharedAudioBuffer sharedAudio;
+    uint32_t sharedAudioGeneration = 0;
+
+    // Null if shared memory is unavailable; the request then carries the samples inline
+    float* acquireSharedAudio(size_t numSamples);
+    void releaseSharedAudio();
+
     // Error handling
     std::string lastError;
     void setError(const std::string& error) { lastError = error; }
 };
 
-} // namespace VTR
\ No newline at end of file
+} // namespace VTR
@@ -1,4 +1,6 @@
 #include "FeatureExtractor.h"
+#include "ExternalFeatureExtractor.h"
+#include "../DSP/RealtimeGuard.h"
 #include <juce_audio_formats/juce_audio_formats.h>
 #include <juce_core/juce_core.h>
 #include <algorithm>
@@ -14,12 +16,16 @@ FeatureExtractor::FeatureExtractor()
     , window_(nullptr)
     , libxtractInitialized_(false)
 #endif
-    , pythonExtractor_(nullptr)
+    , externalExtractor_(std::make_unique<VTR::ExternalFeatureExtractor>())
 {
 }
 
 FeatureExtractor::~FeatureExtractor()
 {
+    // Interpreter start-up cannot be interrupted - a warm-up in progress finishes on its own thread,
+    // which holds the shared state, and drops the backend when it sees the flag. WarmUpThreads joins it
+    pythonWarmUp_->cancelled.store(true);
+    
 #ifdef HAVE_LIBXTRACT
     if (window_)
     {
@@ -31,6 +37,8 @@ FeatureExtractor::~FeatureExtractor()
 
 void FeatureExtractor::initialize(double sampleRate, int fftSize, Backend backend)
 {
+    VTR_ASSERT_NOT_REALTIME("FeatureExtractor::initialize");
+    
     sampleRate_ = sampleRate;
     fftSize_ = fftSize;
     currentBackend_ = backend;
@@ -43,6 +51,8 @@ void FeatureExtractor::initialize(double sampleRate, int fftSize, Backend backen
     workBuffer_.resize(fftSize * 2);
     fftBuffer_.resize(fftSize);
     
+    pipeline_.prepare(pipelineSettingsFor(sampleRate));
+    
 #ifdef HAVE_LIBXTRACT
     if (backend == Backend::LIBXTRACT_BASED)
     {
@@ -56,24 +66,11 @@ void FeatureExtractor::initialize(double sampleRate, int fftSize, Backend backen
     }
 #endif
     
-    // Initialize Python backend if requested
+    // The Python backend warms up in the background; only the first request starts it, so sample
+    // rate changes do not restart the interpreter
     if (backend == Backend::PYTHON_LIBROSA)
     {
-        std::cout << "Initializing Python backend..." << std::endl;
-        juce::Logger::writeToLog("FeatureExtractor: Initializing Python backend...");
-        pythonExtractor_ = std::make_unique<PythonFeatureExtractor>();
-        if (!pythonExtractor_->initialize())
-        {
-            std::cerr << "Python librosa backend initialization failed, falling back to JUCE" << std::endl;
-            juce::Logger::writeToLog("FeatureExtractor: Python initialization FAILED - falling back to JUCE");
-            pythonExtractor_.reset();
-            currentBackend_ = Backend::JUCE_BASED;
-        }
-        else
-        {
-            std::cout << "✅ Python librosa backend initialized successfully!" << std::endl;
-            juce::Logger::writeToLog("FeatureExtractor: Python backend initialized SUCCESSFULLY");
-        }
+        startPythonWarmUp();
     }
     
     isInitialized_ = true;
@@ -91,52 +88,247 @@ void FeatureExtractor::setBackend(Backend backend)
             initializeLibXtract();
         }
 #endif
+        
+        if (backend == Backend::PYTHON_LIBROSA)
+        {
+            startPythonWarmUp();
+        }
+    }
+}
+
+FeatureExtractor::ExtractionCounts FeatureExtractor::getExtractionCounts() const noexcept
+{
+    ExtractionCounts counts;
+    counts.python = pythonExtractions_.load();
+    counts.external = externalExtractions_.load();
+    counts.native = nativeExtractions_.load();
+    return counts;
+}
+
+void FeatureExtractor::startPythonWarmUp()
+{
+    auto expected = WarmUpState::Idle;
+    if (!pythonWarmUp_->state.compare_exchange_strong(expected, WarmUpState::WarmingUp))
+    {
+        return;
+    }
+    
+    juce::Logger::writeToLog("FeatureExtractor: Warming up Python backend in the background...");
+    pythonWarmUp_->finished.reset();
+    
+    warmUpThreads_->launch(pythonWarmUp_);
+}
+
+FeatureExtractor::WarmUpThreads::~WarmUpThreads()
+{
+    for (auto& entry : threads)
+        entry.first.join();
+}
+
+void FeatureExtractor::WarmUpThreads::launch(std::shared_ptr<PythonWarmUp> warmUp)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    
+    // Reap the warm-ups that have finished, so a long session of plugin instances does not collect threads
+    for (auto entry = threads.begin(); entry != threads.end();)
+    {
+        if (entry->second->finished.wait(0))
+        {
+            entry->first.join();
+            entry = threads.erase(entry);
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+    
+    try
+    {
+        threads.emplace_back(std::thread([warmUp] { warmUpPython(*warmUp); }), warmUp);
+    }
+    catch (const std::system_error&)
+    {
+        warmUp->state.store(WarmUpState::Failed);
+        warmUp->finished.signal();
+    }
+}
+
+bool FeatureExtractor::isBackendReady() const noexcept
+{
+    if (currentBackend_ != Backend::PYTHON_LIBROSA)
+    {
+        return true;
+    }
+    
+    const auto state = pythonWarmUp_->state.load();
+    return state == WarmUpState::Ready || state == WarmUpState::Failed;
+}
+
+bool FeatureExtractor::waitForBackend(int timeoutMs, const std::function<bool()>& shouldStop)
+{
+    VTR_ASSERT_NOT_REALTIME("FeatureExtractor::waitForBackend");
+    
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(juce::jmax(0, timeoutMs));
+    while (!isBackendReady() && juce::Time::getMillisecondCounter() < deadline)
+    {
+        if (shouldStop != nullptr && shouldStop())
+            break;
+        
+        pythonWarmUp_->finished.wait(WARM_UP_POLL_MS);
     }
+    
+    return isBackendReady();
+}
+
+void FeatureExtractor::warmUpPython(PythonWarmUp& warmUp)
+{
+    // Loads the VTRPythonBackend module (and libpython) for the first time in this process
+    auto backend = std::make_unique<PythonBackend>();
+    bool warmedUp = backend->open() && !warmUp.cancelled.load();
+    
+    if (warmedUp)
+    {
+        // librosa compiles its numba kernels on first use - pay for that here, not on the first reference
+        std::vector<float> dummy(static_cast<size_t>(44100 * WARM_UP_SECONDS));
+        for (size_t i = 0; i < dummy.size(); ++i)
+        {
+            dummy[i] = 0.5f * std::sin(juce::MathConstants<float>::twoPi * 440.0f * static_cast<float>(i) / 44100.0f);
+        }
+        
+        warmedUp = backend->extractFeatures(dummy, 44100.0).size() == FEATURE_VECTOR_SIZE;
+    }
+    
+    if (warmUp.cancelled.load())
+    {
+        warmUp.state.store(WarmUpState::Failed);
+    }
+    else if (warmedUp)
+    {
+        warmUp.backend = std::move(backend);
+        warmUp.state.store(WarmUpState::Ready);
+        juce::Logger::writeToLog("FeatureExtractor: Python backend ready");
+    }
+    else
+    {
+        warmUp.state.store(WarmUpState::Failed);
+        juce::Logger::writeToLog("FeatureExtractor: Python warm-up FAILED - extraction falls back to the native backend");
+    }
+    
+    warmUp.finished.signal();
+}
+
+FeaturePipeline::Settings FeatureExtractor::pipelineSettingsFor(double sampleRate) const
+{
+    FeaturePipeline::Settings pipelineSettings;
+    pipelineSettings.sampleRate = sampleRate;
+    pipelineSettings.fftSize = fftSize_;
+    pipelineSettings.numMelFilters = NUM_MEL_FILTERS;
+    pipelineSettings.maxFrequency = static_cast<float>(sampleRate / 2.0);
+    pipelineSettings.hopLength = HOP_LENGTH;
+    return pipelineSettings;
 }
 
 std::vector<float> FeatureExtractor::extractFeatures(const std::vector<float>& audioData)
 {
+    return extractFeatures(audioData, sampleRate_);
+}
+
+std::vector<float> FeatureExtractor::extractFeatures(const std::vector<float>& audioData, double sampleRate)
+{
+    VTR_ASSERT_NOT_REALTIME("FeatureExtractor::extractFeatures");
+    
     if (!isInitialized_)
     {
         std::cerr << "FeatureExtractor not initialized!" << std::endl;
         return std::vector<float>(FEATURE_VECTOR_SIZE, 0.0f);
     }
     
+    // Read once - the backend can be switched from the message thread while this runs
+    const Backend backend = currentBackend_.load();
+    
+    // The child process is started, and restarted after a failure, by the extractor itself
+    if (backend == Backend::EXTERNAL_PROCESS && externalExtractor_ != nullptr)
+    {
+        auto result = externalExtractor_->extractFeatures(audioData, sampleRate);
+        if (result.size() == FEATURE_VECTOR_SIZE)
+        {
+            externalExtractions_.fetch_add(1);
+            return result;
+        }
+        juce::Logger::writeToLog("FeatureExtractor: External extractor failed (" + juce::String(externalExtractor_->getLastError())
+                                 + ") - using native librosa-compatible backend");
+    }
     // Use Python librosa backend if available (100% compatibility!)
-    if (currentBackend_ == Backend::PYTHON_LIBROSA && pythonExtractor_)
-    {
-        std::cout << "DEBUG: Using Python librosa backend!" << std::endl;
-        std::cout << "DEBUG: Audio data size: " << audioData.size() << std::endl;
-        juce::Logger::writeToLog("FeatureExtractor: Using Python librosa backend!");
-        auto result = pythonExtractor_->extractFeatures(audioData, sampleRate_);
-        std::cout << "DEBUG: Python backend returned " << result.size() << " features" << std::endl;
-        juce::Logger::writeToLog("FeatureExtractor: Python returned " + juce::String(result.size()) + " features");
-        return result;
+    else if (backend == Backend::PYTHON_LIBROSA)
+    {
+        // Sub-interpreters with their own GIL cannot import numpy, so the embedded interpreter serves one
+        // extraction at a time. A caller that finds it busy, still warming up or without a usable module runs
+        // librosa in a child process of its own rather than waiting
+        std::vector<float> result;
+        const auto warmUpState = pythonWarmUp_->state.load();
+        const bool pythonReady = warmUpState == WarmUpState::Ready;
+        if (pythonReady && pythonWarmUp_->backend->tryExtractFeatures(audioData, sampleRate, result))
+        {
+            juce::Logger::writeToLog("FeatureExtractor: Python returned " + juce::String(result.size()) + " features");
+            if (result.size() == FEATURE_VECTOR_SIZE)
+            {
+                pythonExtractions_.fetch_add(1);
+                return result;
+            }
+        }
+        else if (externalExtractor_ != nullptr)
+        {
+            juce::Logger::writeToLog(pythonReady ? "FeatureExtractor: Python interpreter busy - using the external extractor"
+                                     : warmUpState == WarmUpState::WarmingUp ? "FeatureExtractor: Python backend still warming up - using the external extractor"
+                                     : "FeatureExtractor: Python backend unavailable - using the external extractor");
+            result = externalExtractor_->extractFeatures(audioData, sampleRate);
+            if (result.size() == FEATURE_VECTOR_SIZE)
+            {
+                externalExtractions_.fetch_add(1);
+                return result;
+            }
+        }
+        juce::Logger::writeToLog("FeatureExtractor: Python extraction failed - using native librosa-compatible backend");
     }
     else
     {
-        juce::Logger::writeToLog("FeatureExtractor: Using JUCE backend (Python not available)");
+        juce::Logger::writeToLog("FeatureExtractor: Using native librosa-compatible backend");
     }
     
-    std::vector<float> features(FEATURE_VECTOR_SIZE);
-    
-    // Extract individual features based on backend
-    // IMPORTANT: Order must match Python training data!
-    // Training order: [spectral_centroid, spectral_bandwidth, spectral_rolloff, mfcc1-13, rms_energy]
-    features[0] = extractSpectralCentroid(audioData);             // spectral_centroid
-    features[1] = extractSpectralBandwidth(audioData);            // spectral_bandwidth
-    features[2] = extractSpectralRolloff(audioData);              // spectral_rolloff
+    nativeExtractions_.fetch_add(1);
     
-    // Extract MFCCs (indices 3-15)
-    auto mfccs = extractMFCC(audioData, NUM_MFCC_COEFFS);
-    for (int i = 0; i < NUM_MFCC_COEFFS && i < mfccs.size(); ++i)
+#ifdef HAVE_LIBXTRACT
+    if (backend == Backend::LIBXTRACT_BASED && libxtractInitialized_)
     {
-        features[3 + i] = mfccs[i];
+        std::vector<float> features(FEATURE_VECTOR_SIZE);
+        
+        // IMPORTANT: Order must match Python training data!
+        // Training order: [spectral_centroid, spectral_bandwidth, spectral_rolloff, mfcc1-13, rms_energy]
+        features[0] = extractSpectralCentroid(audioData);
+        features[1] = extractSpectralBandwidth(audioData);
+        features[2] = extractSpectralRolloff(audioData);
+        
+        auto mfccs = extractMFCC(audioData, NUM_MFCC_COEFFS);
+        for (int i = 0; i < NUM_MFCC_COEFFS && i < mfccs.size(); ++i)
+        {
+            features[3 + i] = mfccs[i];
+        }
+        
+        features[16] = extractRMSEnergy(audioData);
+        return features;
     }
+#endif
     
-    features[16] = extractRMSEnergy(audioData);                   // rms_energy
+    // librosa's centred frames across the whole signal, averaged per feature like extract_features.py.
+    // One transform per frame feeds every feature, already in training order
+    if (sampleRate == pipeline_.getSettings().sampleRate)
+        return pipeline_.extractFeatures(audioData.data(), audioData.size());
     
-    return features;
+    const std::lock_guard<std::mutex> lock(otherRateMutex_);
+    if (!otherRatePipeline_.isPrepared() || otherRatePipeline_.getSettings().sampleRate != sampleRate)
+        otherRatePipeline_.prepare(pipelineSettingsFor(sampleRate));
+    return otherRatePipeline_.extractFeatures(audioData.data(), audioData.size());
 }
 
 std::vector<float> FeatureExtractor::extractMFCC(const std::vector<float>& audioData, int numCoeffs)
@@ -233,6 +425,8 @@ float FeatureExtractor::extractRMSEnergy(const std::vector<float>& audioData)
 
 std::vector<float> FeatureExtractor::loadAudioFile(const std::string& filePath, double targetSampleRate)
 {
+    VTR_ASSERT_NOT_REALTIME("audio file I/O");
+    
     juce::AudioFormatManager formatManager;
     formatManager.registerBasicFormats();
     
@@ -314,24 +508,19 @@ std::vector<float> FeatureExtractor::computePowerSpectrum(const std::vector<floa
     // Apply Hann window
     applyHannWindow(paddedData);
     
-    // Prepare FFT data (interleaved real/imaginary)
+    // Prepare FFT data (real input in the first half)
     std::fill(workBuffer_.begin(), workBuffer_.end(), 0.0f);
-    for (int i = 0; i < fftSize_; ++i)
-    {
-        workBuffer_[i * 2] = paddedData[i];     // Real part
-        workBuffer_[i * 2 + 1] = 0.0f;          // Imaginary part
-    }
+    std::copy(paddedData.begin(), paddedData.begin() + fftSize_, workBuffer_.begin());
     
     // Perform FFT
     fft_->performFrequencyOnlyForwardTransform(workBuffer_.data());
     
-    // Compute power spectrum
+    // Compute power spectrum - the frequency-only transform leaves magnitudes in the first half
     std::vector<float> powerSpectrum(fftSize_ / 2 + 1);
     for (int i = 0; i < powerSpectrum.size(); ++i)
     {
-        float real = workBuffer_[i * 2];
-        float imag = workBuffer_[i * 2 + 1];
-        powerSpectrum[i] = real * real + imag * imag;
+        float magnitude = workBuffer_[i];
+        powerSpectrum[i] = magnitude * magnitude;
     }
     
     return powerSpectrum;
@@ -420,85 +609,24 @@ float FeatureExtractor::extractSpectralRolloff_JUCE(const std::vector<float>& po
 
 std::vector<float> FeatureExtractor::computeMelFilterbank_JUCE(const std::vector<float>& powerSpectrum)
 {
-    std::vector<float> melEnergies(NUM_MEL_FILTERS, 0.0f);
-    
-    float minFreq = 0.0f;
-    float maxFreq = sampleRate_ / 2.0f;
-    float minMel = melScale(minFreq);
-    float maxMel = melScale(maxFreq);
-    
-    for (int m = 0; m < NUM_MEL_FILTERS; ++m)
-    {
-        float leftMel = minMel + (m * (maxMel - minMel)) / (NUM_MEL_FILTERS + 1);
-        float centerMel = minMel + ((m + 1) * (maxMel - minMel)) / (NUM_MEL_FILTERS + 1);
-        float rightMel = minMel + ((m + 2) * (maxMel - minMel)) / (NUM_MEL_FILTERS + 1);
-        
-        float leftFreq = invMelScale(leftMel);
-        float centerFreq = invMelScale(centerMel);
-        float rightFreq = invMelScale(rightMel);
-        
-        int fftSize = 2 * (powerSpectrum.size() - 1);
-        int leftBin = static_cast<int>((leftFreq * fftSize) / sampleRate_);
-        int centerBin = static_cast<int>((centerFreq * fftSize) / sampleRate_);
-        int rightBin = static_cast<int>((rightFreq * fftSize) / sampleRate_);
-        
-        leftBin = std::max(0, std::min(leftBin, static_cast<int>(powerSpectrum.size()) - 1));
-        centerBin = std::max(0, std::min(centerBin, static_cast<int>(powerSpectrum.size()) - 1));
-        rightBin = std::max(0, std::min(rightBin, static_cast<int>(powerSpectrum.size()) - 1));
-        
-        for (int i = leftBin; i <= rightBin; ++i)
-        {
-            float weight = 0.0f;
-            
-            if (i <= centerBin && centerBin > leftBin)
-            {
-                weight = static_cast<float>(i - leftBin) / (centerBin - leftBin);
-            }
-            else if (i > centerBin && rightBin > centerBin)
-            {
-                weight = static_cast<float>(rightBin - i) / (rightBin - centerBin);
-            }
-            
-            melEnergies[m] += weight * powerSpectrum[i];
-        }
-    }
+    MelFilterbank::Config config;
+    config.sampleRate = sampleRate_;
+    config.fftSize = 2 * static_cast<int>(powerSpectrum.size() - 1);
+    config.numFilters = NUM_MEL_FILTERS;
+    config.maxFrequency = static_cast<float>(sampleRate_ / 2.0);
     
+    std::vector<float> melEnergies(NUM_MEL_FILTERS, 0.0f);
+    MelFilterbank::getShared(config)->apply(powerSpectrum.data(), melEnergies.data());
     return melEnergies;
 }
 
 std::vector<float> FeatureExtractor::computeDCT_JUCE(const std::vector<float>& melEnergies)
 {
     std::vector<float> dctCoeffs(NUM_MFCC_COEFFS, 0.0f);
-    
-    const int N = melEnergies.size();
-    
-    for (int k = 0; k < NUM_MFCC_COEFFS; ++k)
-    {
-        double sum = 0.0;
-        
-        for (int n = 0; n < N; ++n)
-        {
-            double angle = juce::MathConstants<double>::pi * k * (n + 0.5) / N;
-            sum += melEnergies[n] * std::cos(angle);
-        }
-        
-        float normFactor = (k == 0) ? std::sqrt(1.0f / N) : std::sqrt(2.0f / N);
-        dctCoeffs[k] = normFactor * sum;
-    }
-    
+    DctMatrix::getShared(NUM_MFCC_COEFFS, static_cast<int>(melEnergies.size()))->apply(melEnergies.data(), dctCoeffs.data());
     return dctCoeffs;
 }
 
-float FeatureExtractor::melScale(float frequency)
-{
-    return 2595.0f * std::log10(1.0f + frequency / 700.0f);
-}
-
-float FeatureExtractor::invMelScale(float mel)
-{
-    return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
-}
-
 #ifdef HAVE_LIBXTRACT
 // LibXtract initialization and implementations
 
@@ -2,6 +2,10 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 
@@ -9,7 +13,10 @@
 #include <xtract/libxtract.h>
 #endif
 
-#include "PythonFeatureExtractor.h"
+#include "PythonBackend.h"
+#include "ParallelFeaturePipeline.h"
+
+namespace VTR { class ExternalFeatureExtractor; }
 
 /**
  * Independent feature extraction class for VTR audio processing
@@ -20,25 +27,62 @@ class FeatureExtractor
 public:
     enum class Backend
     {
-        JUCE_BASED,
+        JUCE_BASED,     // Native reimplementation of the librosa features (FeaturePipeline)
         LIBXTRACT_BASED,
-        PYTHON_LIBROSA  // Direct Python librosa integration
+        PYTHON_LIBROSA, // Direct Python librosa integration
+        EXTERNAL_PROCESS // librosa in the standalone extractor executable, run as a child process
     };
     
     FeatureExtractor();
     ~FeatureExtractor();
     
     // Initialize with processing parameters
-    void initialize(double sampleRate, int fftSize = 512, Backend backend = Backend::JUCE_BASED);
+    void initialize(double sampleRate, int fftSize = 2048, Backend backend = Backend::JUCE_BASED);
     
     // Set backend for feature extraction
     void setBackend(Backend backend);
-    Backend getBackend() const { return currentBackend_; }
+    Backend getBackend() const { return currentBackend_.load(); }
+    
+    // The Python backend is brought up on its own thread - interpreter, librosa import and one dummy
+    // extraction - so initialize and setBackend never wait for it
+    enum class WarmUpState
+    {
+        Idle,
+        WarmingUp,
+        Ready,
+        Failed      // extraction falls back to the native backend
+    };
+    
+    void startPythonWarmUp();
+    WarmUpState getPythonWarmUpState() const noexcept { return pythonWarmUp_->state.load(); }
+    
+    // False only while the selected backend is still warming up
+    bool isBackendReady() const noexcept;
     
-    // Extract complete feature vector (17 dimensions)
+    // Waits for a warm-up in progress in short slices, giving up after timeoutMs or as soon as shouldStop
+    // returns true. Returns isBackendReady(). extractFeatures itself never waits - a call that arrives
+    // during warm-up goes to the external extractor
+    bool waitForBackend(int timeoutMs, const std::function<bool()>& shouldStop);
+    
+    // Extract complete feature vector (17 dimensions) - JUCE backend averages centred frames across the whole signal
     // Order: [spectral_centroid, spectral_bandwidth, spectral_rolloff, mfcc_1...mfcc_13, rms_energy]
     std::vector<float> extractFeatures(const std::vector<float>& audioData);
     
+    // The same for audio at its own rate rather than the one given to initialize - a reference file is
+    // resampled to 44.1k whatever rate the host runs at
+    std::vector<float> extractFeatures(const std::vector<float>& audioData, double sampleRate);
+    
+    // Extractions each path has served so far. With PYTHON_LIBROSA, a call that finds the interpreter busy
+    // with another extraction goes to a child process of its own instead of waiting for the GIL
+    struct ExtractionCounts
+    {
+        int python = 0;
+        int external = 0;
+        int native = 0;
+    };
+    
+    ExtractionCounts getExtractionCounts() const noexcept;
+    
     // Individual feature extraction methods
     std::vector<float> extractMFCC(const std::vector<float>& audioData, int numCoeffs = 13);
     float extractSpectralCentroid(const std::vector<float>& audioData);
@@ -60,11 +104,9 @@ private:
     float extractSpectralBandwidth_JUCE(const std::vector<float>& powerSpectrum);
     float extractSpectralRolloff_JUCE(const std::vector<float>& powerSpectrum, float rolloffPercent);
     
-    // JUCE mel filterbank and DCT
+    // JUCE mel filterbank and DCT (shared, cached tables)
     std::vector<float> computeMelFilterbank_JUCE(const std::vector<float>& powerSpectrum);
     std::vector<float> computeDCT_JUCE(const std::vector<float>& melEnergies);
-    float melScale(float frequency);
-    float invMelScale(float mel);
     
 #ifdef HAVE_LIBXTRACT
     // LibXtract initialization and implementations
@@ -79,11 +121,21 @@ private:
     double sampleRate_;
     int fftSize_;
     bool isInitialized_;
-    Backend currentBackend_;
+    std::atomic<Backend> currentBackend_; // switched from the message thread while extractions run
     
     // FFT processing
     std::unique_ptr<juce::dsp::FFT> fft_;
     
+    // Shared STFT stage behind extractFeatures - librosa-compatible, one transform per frame for all 17 features,
+    // frames spread over one worker per core
+    ParallelFeaturePipeline pipeline_;
+    
+    // The same for audio at another rate, so a reference extraction never swaps the tables of the live one
+    std::mutex otherRateMutex_;
+    ParallelFeaturePipeline otherRatePipeline_;
+    
+    FeaturePipeline::Settings pipelineSettingsFor(double sampleRate) const;
+    
 #ifdef HAVE_LIBXTRACT
     // LibXtract state
     double* window_;
@@ -95,8 +147,46 @@ private:
     bool libxtractInitialized_;
 #endif
     
-    // Python librosa backend
-    std::unique_ptr<PythonFeatureExtractor> pythonExtractor_;
+    /** Python librosa backend (a separately loaded module) and its warm-up. Shared with the warm-up thread,
+        so the extractor can be destroyed without waiting for interpreter start-up to finish */
+    struct PythonWarmUp
+    {
+        std::unique_ptr<PythonBackend> backend; // set by the warm-up thread before it publishes Ready
+        std::atomic<WarmUpState> state { WarmUpState::Idle };
+        std::atomic<bool> cancelled { false };  // the extractor is gone - skip the dummy extraction
+        juce::WaitableEvent finished { true };
+    };
+    
+    static void warmUpPython(PythonWarmUp& warmUp);
+    
+    /** The warm-up threads of every extractor in the process. Interpreter start-up cannot be interrupted,
+        so an extractor that goes away leaves its warm-up running here; the last extractor to go joins
+        them, before the module that runs them can be unloaded */
+    class WarmUpThreads
+    {
+    public:
+        WarmUpThreads() = default;
+        ~WarmUpThreads();
+        
+        void launch(std::shared_ptr<PythonWarmUp> warmUp);
+        
+    private:
+        std::mutex mutex;
+        std::vector<std::pair<std::thread, std::shared_ptr<PythonWarmUp>>> threads;
+        
+        JUCE_DECLARE_NON_COPYABLE(WarmUpThreads)
+    };
+    
+    std::shared_ptr<PythonWarmUp> pythonWarmUp_ = std::make_shared<PythonWarmUp>();
+    juce::SharedResourcePointer<WarmUpThreads> warmUpThreads_;
+    
+    // For EXTERNAL_PROCESS and busy PYTHON_LIBROSA calls. Made with the extractor, so a backend switch never
+    // replaces it under a running extraction; the child itself starts with the first extraction that needs it
+    std::unique_ptr<VTR::ExternalFeatureExtractor> externalExtractor_;
+    
+    std::atomic<int> pythonExtractions_ { 0 };
+    std::atomic<int> externalExtractions_ { 0 };
+    std::atomic<int> nativeExtractions_ { 0 };
     
     // Working buffers
     std::vector<float> workBuffer_;
@@ -104,6 +194,9 @@ private:
     
     // Constants
     static constexpr int NUM_MFCC_COEFFS = 13;
-    static constexpr int NUM_MEL_FILTERS = 26;
+    static constexpr int NUM_MEL_FILTERS = 128;  // librosa default
     static constexpr int FEATURE_VECTOR_SIZE = 17;
+    static constexpr int HOP_LENGTH = 512;  // librosa default
+    static constexpr int WARM_UP_SECONDS = 1;  // dummy signal that triggers librosa's numba compilation
+    static constexpr int WARM_UP_POLL_MS = 100;  // waitForBackend's slice between shouldStop checks
 };
\ No newline at end of file
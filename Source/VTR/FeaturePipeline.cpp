@@ -0,0 +1,318 @@
+#include "FeaturePipeline.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void FeaturePipeline::prepare(const Settings& newSettings)
+{
+    settings_ = newSettings;
+    settings_.maxFrequency = juce::jmin(settings_.maxFrequency, static_cast<float>(settings_.sampleRate / 2.0));
+
+    const int fftSize = settings_.fftSize;
+    numBins_ = fftSize / 2 + 1;
+    fft_ = std::make_unique<juce::dsp::FFT>(static_cast<int>(std::log2(fftSize)));
+
+    // Periodic Hann, as scipy.signal.get_window('hann', n_fft) used by librosa.stft
+    window_.resize(static_cast<size_t>(fftSize));
+    for (int i = 0; i < fftSize; ++i)
+        window_[static_cast<size_t>(i)] = static_cast<float>(0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / fftSize));
+
+    binFrequencies_.resize(static_cast<size_t>(numBins_));
+    for (int i = 0; i < numBins_; ++i)
+        binFrequencies_[static_cast<size_t>(i)] = i * settings_.sampleRate / fftSize;
+
+    // The frequency-only transform works in place on 2 * fftSize floats
+    fftBuffer_.assign(static_cast<size_t>(fftSize) * 2, 0.0f);
+    frameBuffer_.assign(static_cast<size_t>(fftSize), 0.0f);
+
+    MelFilterbank::Config melConfig;
+    melConfig.sampleRate = settings_.sampleRate;
+    melConfig.fftSize = fftSize;
+    melConfig.numFilters = settings_.numMelFilters;
+    melConfig.minFrequency = settings_.minFrequency;
+    melConfig.maxFrequency = settings_.maxFrequency;
+    melFilterbank_ = MelFilterbank::getShared(melConfig);
+    dct_ = DctMatrix::getShared(NUM_MFCC_COEFFS, settings_.numMelFilters);
+
+    powerBatch_.assign(static_cast<size_t>(numBins_) * BATCH_FRAMES, 0.0f);
+
+    reset();
+}
+
+void FeaturePipeline::Accumulator::clear() noexcept
+{
+    featureSums.fill(0.0);
+    numFrames = 0;
+    melDb.clear();
+    melDbBlockFrames.clear();
+    maxMelDb = std::numeric_limits<float>::lowest();
+}
+
+void FeaturePipeline::reset() noexcept
+{
+    accumulator_.clear();
+    batchFrames_ = 0;
+}
+
+void FeaturePipeline::processFrame(const float* samples, int numSamples)
+{
+    const int count = juce::jlimit(0, settings_.fftSize, numSamples);
+    std::copy(samples, samples + count, frameBuffer_.begin());
+    std::fill(frameBuffer_.begin() + count, frameBuffer_.end(), 0.0f);
+
+    analyseFrame(frameBuffer_.data(), accumulator_);
+    flushBatch(accumulator_);
+}
+
+int FeaturePipeline::processSignal(const float* samples, size_t numSamples)
+{
+    const int numFramesToProcess = countFrames(numSamples);
+
+    // The whole mel history up front, so the frame loop does not reallocate
+    reserve(accumulator_, accumulator_.numFrames + numFramesToProcess);
+    processFrames(samples, numSamples, 0, numFramesToProcess, accumulator_);
+    return numFramesToProcess;
+}
+
+int FeaturePipeline::countFrames(size_t numSamples) const noexcept
+{
+    const size_t frameSize = static_cast<size_t>(settings_.fftSize);
+    const size_t hop = static_cast<size_t>(juce::jmax(1, settings_.hopLength));
+
+    if (settings_.center)
+        return static_cast<int>(1 + numSamples / hop);
+
+    if (numSamples >= frameSize)
+        return static_cast<int>(1 + (numSamples - frameSize) / hop);
+
+    return 0;
+}
+
+void FeaturePipeline::reserve(Accumulator& accumulator, int numFrames) const
+{
+    const size_t numBlocks = static_cast<size_t>((numFrames + BATCH_FRAMES - 1) / BATCH_FRAMES) + 1;
+    accumulator.melDb.reserve(numBlocks * static_cast<size_t>(settings_.numMelFilters) * BATCH_FRAMES);
+    accumulator.melDbBlockFrames.reserve(numBlocks);
+}
+
+void FeaturePipeline::processFrames(const float* samples, size_t numSamples, int firstFrame, int numFrames, Accumulator& accumulator)
+{
+    jassert(isPrepared());
+    jassert(batchFrames_ == 0);
+
+    const size_t frameSize = static_cast<size_t>(settings_.fftSize);
+    const size_t hop = static_cast<size_t>(juce::jmax(1, settings_.hopLength));
+
+    // Centred frame t starts fftSize / 2 before sample t * hop. Frames that overhang either end are
+    // assembled in frameBuffer_, everything else is analysed straight from the input
+    const std::ptrdiff_t offset = settings_.center ? static_cast<std::ptrdiff_t>(frameSize / 2) : 0;
+
+    for (int frame = firstFrame; frame < firstFrame + numFrames; ++frame)
+    {
+        const std::ptrdiff_t start = static_cast<std::ptrdiff_t>(static_cast<size_t>(frame) * hop) - offset;
+
+        if (start >= 0 && static_cast<size_t>(start) + frameSize <= numSamples)
+        {
+            analyseFrame(samples + start, accumulator);
+        }
+        else
+        {
+            for (size_t i = 0; i < frameSize; ++i)
+                frameBuffer_[i] = getPaddedSample(samples, numSamples, start + static_cast<std::ptrdiff_t>(i));
+
+            analyseFrame(frameBuffer_.data(), accumulator);
+        }
+
+        if (batchFrames_ == BATCH_FRAMES)
+            flushBatch(accumulator);
+    }
+
+    flushBatch(accumulator);
+}
+
+float FeaturePipeline::getPaddedSample(const float* samples, size_t numSamples, std::ptrdiff_t index) const noexcept
+{
+    const auto length = static_cast<std::ptrdiff_t>(numSamples);
+    if (index >= 0 && index < length)
+        return samples[index];
+
+    if (settings_.padMode == PadMode::Constant || length == 0)
+        return 0.0f;
+
+    if (length == 1)
+        return samples[0];
+
+    // numpy's reflect (edge sample not repeated), applied as often as the padding needs
+    const std::ptrdiff_t period = 2 * (length - 1);
+    std::ptrdiff_t reflected = index % period;
+    if (reflected < 0)
+        reflected += period;
+    if (reflected >= length)
+        reflected = period - reflected;
+
+    return samples[reflected];
+}
+
+void FeaturePipeline::analyseFrame(const float* samples, Accumulator& accumulator) noexcept
+{
+    const int fftSize = settings_.fftSize;
+
+    // RMS of the raw frame
+    double sumSquares = 0.0;
+    for (int i = 0; i < fftSize; ++i)
+        sumSquares += static_cast<double>(samples[i]) * samples[i];
+
+    juce::FloatVectorOperations::multiply(fftBuffer_.data(), samples, window_.data(), fftSize);
+    juce::FloatVectorOperations::clear(fftBuffer_.data() + fftSize, fftSize);
+    fft_->performFrequencyOnlyForwardTransform(fftBuffer_.data(), true);
+
+    // Magnitudes drive the shape features and the power spectrum goes to the mel stage, like librosa's
+    // power=1 and power=2 spectrograms. Centroid and bandwidth come from one pass over the bins,
+    // with the variance as E[f^2] - E[f]^2
+    float* powerColumn = powerBatch_.data() + batchFrames_;
+    double totalMagnitude = 0.0;
+    double weightedSum = 0.0;
+    double weightedSquareSum = 0.0;
+    for (int i = 0; i < numBins_; ++i)
+    {
+        const float magnitude = fftBuffer_[static_cast<size_t>(i)];
+        const double frequency = binFrequencies_[static_cast<size_t>(i)];
+        powerColumn[static_cast<size_t>(i) * BATCH_FRAMES] = magnitude * magnitude;
+        totalMagnitude += magnitude;
+        weightedSum += frequency * magnitude;
+        weightedSquareSum += frequency * frequency * magnitude;
+    }
+
+    // Silent frames give zeros, as librosa's normalisation leaves them empty
+    double centroid = 0.0, bandwidth = 0.0, rolloff = 0.0;
+    if (totalMagnitude > 0.0)
+    {
+        centroid = weightedSum / totalMagnitude;
+        bandwidth = std::sqrt(juce::jmax(0.0, weightedSquareSum / totalMagnitude - centroid * centroid));
+
+        const double threshold = settings_.rolloffPercent * totalMagnitude;
+        double cumulativeMagnitude = 0.0;
+        rolloff = binFrequencies_.back();
+        for (int i = 0; i < numBins_; ++i)
+        {
+            cumulativeMagnitude += fftBuffer_[static_cast<size_t>(i)];
+            if (cumulativeMagnitude >= threshold)
+            {
+                rolloff = binFrequencies_[static_cast<size_t>(i)];
+                break;
+            }
+        }
+    }
+
+    accumulator.featureSums[CENTROID_INDEX] += centroid;
+    accumulator.featureSums[BANDWIDTH_INDEX] += bandwidth;
+    accumulator.featureSums[ROLLOFF_INDEX] += rolloff;
+    accumulator.featureSums[RMS_INDEX] += std::sqrt(sumSquares / fftSize);
+    ++accumulator.numFrames;
+    ++batchFrames_;
+}
+
+void FeaturePipeline::flushBatch(Accumulator& accumulator)
+{
+    if (batchFrames_ == 0)
+        return;
+
+    const int numMelFilters = settings_.numMelFilters;
+    const size_t blockStart = accumulator.melDb.size();
+    accumulator.melDb.resize(blockStart + static_cast<size_t>(numMelFilters) * BATCH_FRAMES);
+
+    float* block = accumulator.melDb.data() + blockStart;
+    melFilterbank_->applyBatch(powerBatch_.data(), block, batchFrames_, BATCH_FRAMES);
+
+    // power_to_db with ref = 1 and amin = 1e-10; the top_db floor waits for the whole signal
+    for (int m = 0; m < numMelFilters; ++m)
+    {
+        float* melRow = block + static_cast<size_t>(m) * BATCH_FRAMES;
+        for (int frame = 0; frame < batchFrames_; ++frame)
+        {
+            melRow[frame] = 10.0f * std::log10(std::max(melRow[frame], POWER_FLOOR));
+            accumulator.maxMelDb = std::max(accumulator.maxMelDb, melRow[frame]);
+        }
+    }
+
+    accumulator.melDbBlockFrames.push_back(batchFrames_);
+    batchFrames_ = 0;
+}
+
+std::vector<float> FeaturePipeline::getFeatures() const
+{
+    std::vector<float> features(FEATURE_VECTOR_SIZE, 0.0f);
+    if (accumulator_.numFrames == 0)
+        return features;
+
+    const float floorDb = settings_.topDb > 0.0f ? accumulator_.maxMelDb - settings_.topDb : std::numeric_limits<float>::lowest();
+
+    auto sums = accumulator_.featureSums;
+    addMfccSums(accumulator_, floorDb, sums);
+
+    for (size_t i = 0; i < features.size(); ++i)
+        features[i] = static_cast<float>(sums[i] / accumulator_.numFrames);
+
+    return features;
+}
+
+std::vector<float> FeaturePipeline::getFeatures(const std::vector<Accumulator>& partials) const
+{
+    std::vector<float> features(FEATURE_VECTOR_SIZE, 0.0f);
+
+    int numFrames = 0;
+    float maxMelDb = std::numeric_limits<float>::lowest();
+    for (const auto& partial : partials)
+    {
+        numFrames += partial.numFrames;
+        maxMelDb = std::max(maxMelDb, partial.maxMelDb);
+    }
+
+    if (numFrames == 0)
+        return features;
+
+    const float floorDb = settings_.topDb > 0.0f ? maxMelDb - settings_.topDb : std::numeric_limits<float>::lowest();
+
+    // Each partial is summed on its own and the totals added in order, so the result only depends on
+    // how the frames were split, not on who analysed them
+    std::array<double, FEATURE_VECTOR_SIZE> sums {};
+    for (const auto& partial : partials)
+    {
+        auto partialSums = partial.featureSums;
+        addMfccSums(partial, floorDb, partialSums);
+
+        for (size_t i = 0; i < sums.size(); ++i)
+            sums[i] += partialSums[i];
+    }
+
+    for (size_t i = 0; i < features.size(); ++i)
+        features[i] = static_cast<float>(sums[i] / numFrames);
+
+    return features;
+}
+
+void FeaturePipeline::addMfccSums(const Accumulator& accumulator, float floorDb, std::array<double, FEATURE_VECTOR_SIZE>& sums) const
+{
+    const int numMelFilters = settings_.numMelFilters;
+    std::vector<float> clippedBlock(static_cast<size_t>(numMelFilters) * BATCH_FRAMES);
+    std::vector<float> mfccBlock(static_cast<size_t>(NUM_MFCC_COEFFS) * BATCH_FRAMES);
+
+    for (size_t blockIndex = 0; blockIndex < accumulator.melDbBlockFrames.size(); ++blockIndex)
+    {
+        const int blockFrames = accumulator.melDbBlockFrames[blockIndex];
+        const float* block = accumulator.melDb.data() + blockIndex * static_cast<size_t>(numMelFilters) * BATCH_FRAMES;
+
+        for (int m = 0; m < numMelFilters; ++m)
+            juce::FloatVectorOperations::max(clippedBlock.data() + static_cast<size_t>(m) * BATCH_FRAMES,
+                                             block + static_cast<size_t>(m) * BATCH_FRAMES, floorDb, blockFrames);
+
+        dct_->applyBatch(clippedBlock.data(), mfccBlock.data(), blockFrames, BATCH_FRAMES);
+
+        for (int k = 0; k < NUM_MFCC_COEFFS; ++k)
+        {
+            const float* mfccRow = mfccBlock.data() + static_cast<size_t>(k) * BATCH_FRAMES;
+            for (int frame = 0; frame < blockFrames; ++frame)
+                sums[static_cast<size_t>(MFCC_INDEX + k)] += mfccRow[frame];
+        }
+    }
+}
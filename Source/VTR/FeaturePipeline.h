@@ -0,0 +1,146 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "MelFilterbank.h"
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ * Native version of the librosa features behind the 17-dimensional VTR vector: spectral_centroid,
+ * spectral_bandwidth, spectral_rolloff, mfcc and rms with their default arguments, averaged over frames
+ * as vtr-model/extract_features.py does. Expected to match librosa within 1e-3 relative on the spectral
+ * shape and RMS features and 0.05 absolute on the MFCCs (see vtr-model/export_feature_vectors.py)
+ *
+ * Every frame is windowed and transformed once and feeds all accumulators; the mel filterbank and DCT
+ * run over batches of frames. Only the per-signal mel history grows with the input - tables and frame
+ * buffers are set up in prepare
+ *
+ * Frames can also be analysed in ranges into separate Accumulators and reduced afterwards, which is how
+ * ParallelFeaturePipeline spreads one signal over several pipelines
+ */
+class FeaturePipeline
+{
+public:
+    // How centred framing extends the signal by fftSize / 2 at both ends. librosa used reflect up to
+    // 0.9 and constant (zeros) from 0.10
+    enum class PadMode
+    {
+        Constant,
+        Reflect
+    };
+
+    struct Settings
+    {
+        double sampleRate = 44100.0;
+        int fftSize = 2048;                // power of two, also the RMS frame length
+        int numMelFilters = 128;
+        float minFrequency = 0.0f;
+        float maxFrequency = 22050.0f;     // clamped to Nyquist
+        float rolloffPercent = 0.85f;
+        float topDb = 80.0f;               // power_to_db floor below the loudest mel bin, 0 disables it
+
+        // Framing for processSignal
+        int hopLength = 512;
+        bool center = true;
+        PadMode padMode = PadMode::Reflect;
+    };
+
+    // Training order: [spectral_centroid, spectral_bandwidth, spectral_rolloff, mfcc1-13, rms_energy]
+    static constexpr int NUM_MFCC_COEFFS = 13;
+    static constexpr int FEATURE_VECTOR_SIZE = 17;
+    static constexpr int CENTROID_INDEX = 0;
+    static constexpr int BANDWIDTH_INDEX = 1;
+    static constexpr int ROLLOFF_INDEX = 2;
+    static constexpr int MFCC_INDEX = 3;
+    static constexpr int RMS_INDEX = 16;
+
+    // Running sums of one run of frames. The MFCC sums stay empty until the reduction, as the top_db
+    // floor depends on every frame of the signal
+    struct Accumulator
+    {
+        std::array<double, FEATURE_VECTOR_SIZE> featureSums {};
+        int numFrames = 0;
+
+        // Mel energies in dB, one numMelFilters x BATCH_FRAMES block per batch
+        std::vector<float> melDb;
+        std::vector<int> melDbBlockFrames;
+        float maxMelDb = std::numeric_limits<float>::lowest();
+
+        void clear() noexcept;
+    };
+
+    FeaturePipeline() = default;
+
+    void prepare(const Settings& newSettings);
+    bool isPrepared() const noexcept { return fft_ != nullptr; }
+    const Settings& getSettings() const noexcept { return settings_; }
+
+    // Clears the accumulators and the mel history - the tables are kept
+    void reset() noexcept;
+
+    // Analyses one frame; shorter input is zero-padded to the FFT size
+    void processFrame(const float* samples, int numSamples);
+
+    // Analyses the whole signal, frames hopLength samples apart. Uncentred framing only takes complete
+    // frames; centred framing pads both ends and yields 1 + numSamples / hopLength frames. Returns the frame count
+    int processSignal(const float* samples, size_t numSamples);
+
+    // Frame count processSignal would produce for a signal of this length
+    int countFrames(size_t numSamples) const noexcept;
+
+    // Frames [firstFrame, firstFrame + numFrames) of processSignal's framing, added to the given accumulator.
+    // Does not allocate once the accumulator is reserved for that many frames
+    void processFrames(const float* samples, size_t numSamples, int firstFrame, int numFrames, Accumulator& accumulator);
+    void reserve(Accumulator& accumulator, int numFrames) const;
+
+    int getNumFrames() const noexcept { return accumulator_.numFrames; }
+
+    // Means over the processed frames in training order, zeros if there were none
+    std::vector<float> getFeatures() const;
+
+    // Means over several accumulators, reduced in the order given - the same partials always give the same bits
+    std::vector<float> getFeatures(const std::vector<Accumulator>& partials) const;
+
+    // Frames per mel filterbank and DCT batch
+    static constexpr int BATCH_FRAMES = 32;
+
+private:
+    static constexpr float POWER_FLOOR = 1.0e-10f; // power_to_db's amin
+
+    // Spectrum, shape features and RMS of one fftSize frame; its power spectrum is queued for the next batch
+    void analyseFrame(const float* samples, Accumulator& accumulator) noexcept;
+
+    // Mel energies in dB for the queued frames, appended to the accumulator's history
+    void flushBatch(Accumulator& accumulator);
+
+    // Adds the MFCC sums of one accumulator, with mel bins floored at floorDb
+    void addMfccSums(const Accumulator& accumulator, float floorDb, std::array<double, FEATURE_VECTOR_SIZE>& sums) const;
+
+    float getPaddedSample(const float* samples, size_t numSamples, std::ptrdiff_t index) const noexcept;
+
+    Settings settings_;
+    int numBins_ = 0;
+    std::unique_ptr<juce::dsp::FFT> fft_;
+    std::vector<float> window_;
+    std::vector<double> binFrequencies_;
+
+    // Shared with every other pipeline of the same configuration
+    std::shared_ptr<const MelFilterbank> melFilterbank_;
+    std::shared_ptr<const DctMatrix> dct_;
+
+    // Per-frame working buffers
+    std::vector<float> frameBuffer_; // assembles frames that need padding
+    std::vector<float> fftBuffer_;
+
+    // Power spectra of the queued frames, row-major with BATCH_FRAMES columns
+    std::vector<float> powerBatch_;
+    int batchFrames_ = 0;
+
+    // Frames from processFrame and processSignal
+    Accumulator accumulator_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FeaturePipeline)
+};
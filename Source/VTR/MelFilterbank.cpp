@@ -0,0 +1,197 @@
+#include "MelFilterbank.h"
+#include <cmath>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    // Slaney scale constants (librosa.hz_to_mel with htk=False)
+    constexpr double LINEAR_HZ_PER_MEL = 200.0 / 3.0;
+    constexpr double MIN_LOG_HZ = 1000.0;
+    constexpr double MIN_LOG_MEL = MIN_LOG_HZ / LINEAR_HZ_PER_MEL;
+    const double LOG_STEP = std::log(6.4) / 27.0;
+
+    // One instance per key for as long as someone holds it; expired entries are dropped on the next lookup
+    template <typename Table, typename Key, typename Build>
+    std::shared_ptr<const Table> findOrBuild(std::vector<std::pair<Key, std::weak_ptr<const Table>>>& cache,
+                                             std::mutex& mutex, const Key& key, Build&& build)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (auto it = cache.begin(); it != cache.end();)
+        {
+            if (auto table = it->second.lock())
+            {
+                if (it->first == key)
+                    return table;
+                ++it;
+            }
+            else
+            {
+                it = cache.erase(it);
+            }
+        }
+
+        std::shared_ptr<const Table> table = build();
+        cache.emplace_back(key, table);
+        return table;
+    }
+}
+
+bool MelFilterbank::Config::operator== (const Config& other) const noexcept
+{
+    return sampleRate == other.sampleRate && fftSize == other.fftSize && numFilters == other.numFilters
+        && minFrequency == other.minFrequency && maxFrequency == other.maxFrequency;
+}
+
+MelFilterbank::MelFilterbank(const Config& config)
+    : config_(config)
+{
+    config_.maxFrequency = juce::jmin(config_.maxFrequency, static_cast<float>(config_.sampleRate / 2.0));
+
+    const int numFilters = config_.numFilters;
+    const int numBins = getNumBins();
+
+    // numFilters + 2 points equally spaced in mel: filter m rises from point m to m + 1 and falls to m + 2
+    std::vector<double> edges(static_cast<size_t>(numFilters) + 2);
+    const double minMel = hzToMel(config_.minFrequency);
+    const double maxMel = hzToMel(config_.maxFrequency);
+    for (size_t i = 0; i < edges.size(); ++i)
+        edges[i] = melToHz(minMel + (maxMel - minMel) * static_cast<double>(i) / static_cast<double>(numFilters + 1));
+
+    rowOffsets_.assign(static_cast<size_t>(numFilters) + 1, 0);
+
+    for (int m = 0; m < numFilters; ++m)
+    {
+        const double left = edges[static_cast<size_t>(m)];
+        const double center = edges[static_cast<size_t>(m) + 1];
+        const double right = edges[static_cast<size_t>(m) + 2];
+
+        // Slaney normalisation - every filter has the same area
+        const double norm = 2.0 / (right - left);
+
+        rowOffsets_[static_cast<size_t>(m)] = static_cast<int>(values_.size());
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const double frequency = bin * config_.sampleRate / config_.fftSize;
+            const double lower = (frequency - left) / (center - left);
+            const double upper = (right - frequency) / (right - center);
+            const double weight = juce::jmax(0.0, juce::jmin(lower, upper));
+
+            if (weight > 0.0)
+            {
+                columnIndices_.push_back(bin);
+                values_.push_back(static_cast<float>(weight * norm));
+            }
+        }
+    }
+
+    rowOffsets_[static_cast<size_t>(numFilters)] = static_cast<int>(values_.size());
+}
+
+std::shared_ptr<const MelFilterbank> MelFilterbank::getShared(const Config& config)
+{
+    static std::mutex mutex;
+    static std::vector<std::pair<Config, std::weak_ptr<const MelFilterbank>>> cache;
+
+    return findOrBuild(cache, mutex, config, [&config] { return std::make_shared<const MelFilterbank>(config); });
+}
+
+void MelFilterbank::apply(const float* powerSpectrum, float* melEnergies) const noexcept
+{
+    for (int m = 0; m < config_.numFilters; ++m)
+    {
+        float energy = 0.0f;
+        for (int i = rowOffsets_[static_cast<size_t>(m)]; i < rowOffsets_[static_cast<size_t>(m) + 1]; ++i)
+            energy += values_[static_cast<size_t>(i)] * powerSpectrum[columnIndices_[static_cast<size_t>(i)]];
+
+        melEnergies[m] = energy;
+    }
+}
+
+void MelFilterbank::applyBatch(const float* powerFrames, float* melFrames, int numFrames, int stride) const noexcept
+{
+    // Each nonzero weight scales one contiguous row of frames - vectorised across the batch
+    for (int m = 0; m < config_.numFilters; ++m)
+    {
+        float* melRow = melFrames + static_cast<size_t>(m) * static_cast<size_t>(stride);
+        juce::FloatVectorOperations::clear(melRow, numFrames);
+
+        for (int i = rowOffsets_[static_cast<size_t>(m)]; i < rowOffsets_[static_cast<size_t>(m) + 1]; ++i)
+        {
+            const float* powerRow = powerFrames + static_cast<size_t>(columnIndices_[static_cast<size_t>(i)]) * static_cast<size_t>(stride);
+            juce::FloatVectorOperations::addWithMultiply(melRow, powerRow, values_[static_cast<size_t>(i)], numFrames);
+        }
+    }
+}
+
+double MelFilterbank::hzToMel(double frequency) noexcept
+{
+    if (frequency < MIN_LOG_HZ)
+        return frequency / LINEAR_HZ_PER_MEL;
+
+    return MIN_LOG_MEL + std::log(frequency / MIN_LOG_HZ) / LOG_STEP;
+}
+
+double MelFilterbank::melToHz(double mel) noexcept
+{
+    if (mel < MIN_LOG_MEL)
+        return mel * LINEAR_HZ_PER_MEL;
+
+    return MIN_LOG_HZ * std::exp(LOG_STEP * (mel - MIN_LOG_MEL));
+}
+
+//==============================================================================
+DctMatrix::DctMatrix(int numCoefficients, int numInputs)
+    : numCoefficients_(numCoefficients)
+    , numInputs_(numInputs)
+{
+    matrix_.resize(static_cast<size_t>(numCoefficients) * static_cast<size_t>(numInputs));
+
+    for (int k = 0; k < numCoefficients; ++k)
+    {
+        const double norm = std::sqrt((k == 0 ? 1.0 : 2.0) / numInputs);
+        for (int n = 0; n < numInputs; ++n)
+        {
+            const double angle = juce::MathConstants<double>::pi * k * (n + 0.5) / numInputs;
+            matrix_[static_cast<size_t>(k * numInputs + n)] = static_cast<float>(norm * std::cos(angle));
+        }
+    }
+}
+
+std::shared_ptr<const DctMatrix> DctMatrix::getShared(int numCoefficients, int numInputs)
+{
+    static std::mutex mutex;
+    static std::vector<std::pair<std::pair<int, int>, std::weak_ptr<const DctMatrix>>> cache;
+
+    return findOrBuild(cache, mutex, std::make_pair(numCoefficients, numInputs),
+                       [=] { return std::make_shared<const DctMatrix>(numCoefficients, numInputs); });
+}
+
+void DctMatrix::apply(const float* input, float* output) const noexcept
+{
+    for (int k = 0; k < numCoefficients_; ++k)
+    {
+        const float* row = matrix_.data() + static_cast<size_t>(k) * static_cast<size_t>(numInputs_);
+        double sum = 0.0;
+        for (int n = 0; n < numInputs_; ++n)
+            sum += row[n] * input[n];
+
+        output[k] = static_cast<float>(sum);
+    }
+}
+
+void DctMatrix::applyBatch(const float* inputFrames, float* outputFrames, int numFrames, int stride) const noexcept
+{
+    for (int k = 0; k < numCoefficients_; ++k)
+    {
+        const float* row = matrix_.data() + static_cast<size_t>(k) * static_cast<size_t>(numInputs_);
+        float* outputRow = outputFrames + static_cast<size_t>(k) * static_cast<size_t>(stride);
+        juce::FloatVectorOperations::clear(outputRow, numFrames);
+
+        for (int n = 0; n < numInputs_; ++n)
+            juce::FloatVectorOperations::addWithMultiply(outputRow, inputFrames + static_cast<size_t>(n) * static_cast<size_t>(stride),
+                                                         row[n], numFrames);
+    }
+}
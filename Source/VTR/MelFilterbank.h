@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <memory>
+#include <vector>
+
+/**
+ * Mel filterbank as a sparse CSR matrix (filters x FFT bins), built like librosa.filters.mel's
+ * defaults: Slaney mel scale and Slaney area normalisation
+ * Immutable once built - getShared hands out one instance per configuration
+ */
+class MelFilterbank
+{
+public:
+    struct Config
+    {
+        double sampleRate = 44100.0;
+        int fftSize = 2048;
+        int numFilters = 128;
+        float minFrequency = 0.0f;
+        float maxFrequency = 22050.0f; // clamped to Nyquist
+
+        bool operator== (const Config& other) const noexcept;
+    };
+
+    explicit MelFilterbank(const Config& config);
+
+    // Builds the filterbank on first request, then returns the cached instance while anyone holds it
+    static std::shared_ptr<const MelFilterbank> getShared(const Config& config);
+
+    const Config& getConfig() const noexcept { return config_; }
+    int getNumFilters() const noexcept { return config_.numFilters; }
+    int getNumBins() const noexcept { return config_.fftSize / 2 + 1; }
+
+    // melEnergies[m] = sum over bins of weight(m, bin) * powerSpectrum[bin]
+    void apply(const float* powerSpectrum, float* melEnergies) const noexcept;
+
+    // Same over a batch stored bin-major: powerFrames[bin * stride + frame], melFrames[filter * stride + frame]
+    void applyBatch(const float* powerFrames, float* melFrames, int numFrames, int stride) const noexcept;
+
+    // Slaney mel scale - linear below 1 kHz, logarithmic above
+    static double hzToMel(double frequency) noexcept;
+    static double melToHz(double mel) noexcept;
+
+private:
+    Config config_;
+
+    // CSR storage - row m holds values_[rowOffsets_[m] .. rowOffsets_[m + 1]) at columnIndices_
+    std::vector<int> rowOffsets_;
+    std::vector<int> columnIndices_;
+    std::vector<float> values_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MelFilterbank)
+};
+
+/**
+ * Orthonormal DCT-II matrix (scipy's dct(type=2, norm='ortho')), truncated to the first coefficients
+ * Immutable once built - getShared hands out one instance per size
+ */
+class DctMatrix
+{
+public:
+    DctMatrix(int numCoefficients, int numInputs);
+
+    static std::shared_ptr<const DctMatrix> getShared(int numCoefficients, int numInputs);
+
+    int getNumCoefficients() const noexcept { return numCoefficients_; }
+    int getNumInputs() const noexcept { return numInputs_; }
+
+    void apply(const float* input, float* output) const noexcept;
+
+    // Batch stored input-major: inputFrames[input * stride + frame], outputFrames[coefficient * stride + frame]
+    void applyBatch(const float* inputFrames, float* outputFrames, int numFrames, int stride) const noexcept;
+
+private:
+    int numCoefficients_;
+    int numInputs_;
+    std::vector<float> matrix_; // row-major, numCoefficients_ x numInputs_
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DctMatrix)
+};
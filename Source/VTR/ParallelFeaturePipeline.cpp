@@ -0,0 +1,141 @@
+#include "ParallelFeaturePipeline.h"
+
+class ParallelFeaturePipeline::WorkerJob : public juce::ThreadPoolJob
+{
+public:
+    WorkerJob(ParallelFeaturePipeline& owner, FeaturePipeline& worker)
+        : ThreadPoolJob("VTR Feature Worker"), owner_(owner), worker_(worker)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        owner_.runWorker(worker_);
+        return jobHasFinished;
+    }
+
+private:
+    ParallelFeaturePipeline& owner_;
+    FeaturePipeline& worker_;
+};
+
+//==============================================================================
+ParallelFeaturePipeline::ParallelFeaturePipeline(int numWorkers)
+    : numWorkers_(numWorkers > 0 ? numWorkers : juce::jmax(1, juce::SystemStats::getNumCpus()))
+{
+}
+
+ParallelFeaturePipeline::~ParallelFeaturePipeline() = default;
+
+std::shared_ptr<juce::ThreadPool> ParallelFeaturePipeline::getSharedPool(int numThreads)
+{
+    static std::mutex mutex;
+    static std::weak_ptr<juce::ThreadPool> sharedPool;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (auto pool = sharedPool.lock())
+        return pool;
+
+    auto pool = std::make_shared<juce::ThreadPool>(juce::ThreadPoolOptions{}
+                                                       .withThreadName("VTR Feature Worker")
+                                                       .withNumberOfThreads(numThreads)
+                                                       .withDesiredThreadPriority(juce::Thread::Priority::low));
+    sharedPool = pool;
+    return pool;
+}
+
+void ParallelFeaturePipeline::prepare(const FeaturePipeline::Settings& newSettings)
+{
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    settings_ = newSettings;
+    ++settingsVersion_;
+}
+
+FeaturePipeline::Settings ParallelFeaturePipeline::getSettings() const
+{
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    return settings_;
+}
+
+void ParallelFeaturePipeline::updateWorkers()
+{
+    FeaturePipeline::Settings settings;
+    {
+        std::lock_guard<std::mutex> lock(settingsMutex_);
+        if (workersVersion_ == settingsVersion_.load())
+            return;
+
+        settings = settings_;
+        workersVersion_ = settingsVersion_.load();
+    }
+
+    // The tables behind each worker are shared, only the FFT and frame buffers are per worker
+    workers_.clear();
+    for (int i = 0; i < numWorkers_; ++i)
+    {
+        workers_.push_back(std::make_unique<FeaturePipeline>());
+        workers_.back()->prepare(settings);
+    }
+
+    // The calling thread is the first worker
+    if (numWorkers_ > 1 && pool_ == nullptr)
+        pool_ = getSharedPool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1));
+}
+
+std::vector<float> ParallelFeaturePipeline::extractFeatures(const float* samples, size_t numSamples)
+{
+    jassert(isPrepared());
+
+    std::lock_guard<std::mutex> lock(extractionMutex_);
+    updateWorkers();
+
+    if (workers_.empty())
+        return std::vector<float>(FeaturePipeline::FEATURE_VECTOR_SIZE, 0.0f);
+
+    auto& firstWorker = *workers_.front();
+
+    samples_ = samples;
+    numSamples_ = numSamples;
+    numFrames_ = firstWorker.countFrames(numSamples);
+
+    // Chunk layout and accumulator memory are fixed before any worker starts, so the workers never allocate
+    const int numChunks = (numFrames_ + FRAMES_PER_CHUNK - 1) / FRAMES_PER_CHUNK;
+    partials_.resize(static_cast<size_t>(numChunks));
+    for (auto& partial : partials_)
+    {
+        partial.clear();
+        firstWorker.reserve(partial, FRAMES_PER_CHUNK);
+    }
+
+    nextChunk_.store(0);
+
+    std::vector<std::unique_ptr<WorkerJob>> jobs;
+    const int numHelpers = juce::jmin(numWorkers_ - 1, numChunks - 1);
+    for (int i = 1; i <= numHelpers; ++i)
+    {
+        jobs.push_back(std::make_unique<WorkerJob>(*this, *workers_[static_cast<size_t>(i)]));
+        pool_->addJob(jobs.back().get(), false);
+    }
+
+    runWorker(firstWorker);
+
+    // Helpers that never got a thread are dropped from the queue, running ones are waited for
+    for (auto& job : jobs)
+        pool_->removeJob(job.get(), false, -1);
+
+    samples_ = nullptr;
+    return firstWorker.getFeatures(partials_);
+}
+
+void ParallelFeaturePipeline::runWorker(FeaturePipeline& worker)
+{
+    const int numChunks = static_cast<int>(partials_.size());
+
+    for (int chunk = nextChunk_.fetch_add(1); chunk < numChunks; chunk = nextChunk_.fetch_add(1))
+    {
+        const int firstFrame = chunk * FRAMES_PER_CHUNK;
+        const int count = juce::jmin(FRAMES_PER_CHUNK, numFrames_ - firstFrame);
+        worker.processFrames(samples_, numSamples_, firstFrame, count, partials_[static_cast<size_t>(chunk)]);
+    }
+}
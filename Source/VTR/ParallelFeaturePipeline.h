@@ -0,0 +1,71 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "FeaturePipeline.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * FeaturePipeline spread over worker threads. The frames are cut into fixed chunks that the workers
+ * take in turn, each into its own accumulator, and the partials are reduced in chunk order - the chunks
+ * only depend on the signal length, so the features are bit-identical for any number of workers
+ *
+ * The calling thread works as well; the other workers come from a thread pool shared by every instance
+ * in the process. prepare only records the settings - the workers are (re)built by the next extraction,
+ * on its own thread, so preparing never allocates on the caller or frees pipelines a running extraction
+ * still uses. Extractions from several threads take turns
+ */
+class ParallelFeaturePipeline
+{
+public:
+    // Defaults to one worker per core
+    explicit ParallelFeaturePipeline(int numWorkers = 0);
+    ~ParallelFeaturePipeline();
+
+    // Cheap and safe while an extraction runs on another thread - it picks the settings up next time
+    void prepare(const FeaturePipeline::Settings& newSettings);
+    bool isPrepared() const noexcept { return settingsVersion_.load() > 0; }
+    FeaturePipeline::Settings getSettings() const;
+    int getNumWorkers() const noexcept { return numWorkers_; }
+
+    // processSignal followed by getFeatures, over all workers
+    std::vector<float> extractFeatures(const float* samples, size_t numSamples);
+
+    // A multiple of the mel batch, so chunks only produce full batches except at the very end
+    static constexpr int FRAMES_PER_CHUNK = 4 * FeaturePipeline::BATCH_FRAMES;
+
+private:
+    class WorkerJob;
+
+    // Pool threads shared by all instances; created on first request and kept while anyone holds it
+    static std::shared_ptr<juce::ThreadPool> getSharedPool(int numThreads);
+
+    // Rebuilds the workers if prepare was called since the last extraction (extraction lock held)
+    void updateWorkers();
+
+    // Takes chunks until there are none left
+    void runWorker(FeaturePipeline& worker);
+
+    // Requested settings, bumped by prepare
+    mutable std::mutex settingsMutex_;
+    FeaturePipeline::Settings settings_;
+    std::atomic<int> settingsVersion_ { 0 };
+
+    // Everything below belongs to the extraction holding extractionMutex_
+    std::mutex extractionMutex_;
+    int workersVersion_ = 0;
+    int numWorkers_ = 1;
+    std::vector<std::unique_ptr<FeaturePipeline>> workers_; // per-worker FFT and frame buffers
+    std::shared_ptr<juce::ThreadPool> pool_;
+
+    // Current extraction
+    const float* samples_ = nullptr;
+    size_t numSamples_ = 0;
+    int numFrames_ = 0;
+    std::atomic<int> nextChunk_ { 0 };
+    std::vector<FeaturePipeline::Accumulator> partials_; // one per chunk, kept for their capacity
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelFeaturePipeline)
+};
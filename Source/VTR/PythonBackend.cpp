@@ -0,0 +1,139 @@
+#include "PythonBackend.h"
+#include "../DSP/RealtimeGuard.h"
+
+PythonBackend::~PythonBackend()
+{
+    if (handle_ != nullptr)
+        getModule().destroy(handle_);
+}
+
+juce::String PythonBackend::getModuleFileName()
+{
+#if JUCE_WINDOWS
+    return "VTRPythonBackend.dll";
+#else
+    return "VTRPythonBackend.so";
+#endif
+}
+
+const PythonBackend::Module& PythonBackend::getModule()
+{
+    // Never closed - see the class comment. Leaked rather than static, so no exit-time destructor
+    // unloads the interpreter under threads that are still running
+    static auto* library = new juce::DynamicLibrary();
+
+    static const Module module = []
+    {
+        Module result;
+
+        juce::StringArray candidates;
+        const auto overridePath = juce::SystemStats::getEnvironmentVariable("VTR_PYTHON_BACKEND", {});
+        if (overridePath.isNotEmpty())
+            candidates.add(overridePath);
+        // Staged in the bundle's Contents/Resources, next to the platform folder holding the plugin binary
+        const auto binary = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+        candidates.add(binary.getParentDirectory().getSiblingFile("Resources").getChildFile(getModuleFileName()).getFullPathName());
+        candidates.add(binary.getSiblingFile(getModuleFileName()).getFullPathName());
+        candidates.add(getModuleFileName());
+
+        for (const auto& candidate : candidates)
+        {
+            if (library->open(candidate))
+            {
+                juce::Logger::writeToLog("PythonBackend: loaded " + candidate);
+                break;
+            }
+        }
+
+        if (library->getNativeHandle() == nullptr)
+        {
+            result.error = "module not found (" + candidates.joinIntoString(", ") + ")";
+            return result;
+        }
+
+        auto abiVersion = reinterpret_cast<VTRPythonBackendAbiVersionFn>(library->getFunction(VTR_PYTHON_BACKEND_ABI_VERSION_SYMBOL));
+        if (abiVersion == nullptr || abiVersion() != VTR_PYTHON_BACKEND_ABI_VERSION)
+        {
+            result.error = "module ABI version does not match the plugin";
+            return result;
+        }
+
+        result.create = reinterpret_cast<VTRPythonBackendCreateFn>(library->getFunction(VTR_PYTHON_BACKEND_CREATE_SYMBOL));
+        result.destroy = reinterpret_cast<VTRPythonBackendDestroyFn>(library->getFunction(VTR_PYTHON_BACKEND_DESTROY_SYMBOL));
+        result.extract = reinterpret_cast<VTRPythonBackendExtractFn>(library->getFunction(VTR_PYTHON_BACKEND_EXTRACT_SYMBOL));
+        result.tryExtract = reinterpret_cast<VTRPythonBackendTryExtractFn>(library->getFunction(VTR_PYTHON_BACKEND_TRY_EXTRACT_SYMBOL));
+
+        result.loaded = result.create != nullptr && result.destroy != nullptr && result.extract != nullptr
+                     && result.tryExtract != nullptr;
+        if (!result.loaded)
+            result.error = "module is missing entry points";
+
+        return result;
+    }();
+
+    return module;
+}
+
+bool PythonBackend::open()
+{
+    VTR_ASSERT_NOT_REALTIME("PythonBackend::open");
+
+    if (isOpen())
+        return true;
+
+    const auto& module = getModule();
+    if (!module.loaded)
+    {
+        lastError_ = module.error;
+        juce::Logger::writeToLog("PythonBackend: " + lastError_);
+        return false;
+    }
+
+    handle_ = module.create();
+    if (handle_ == nullptr)
+    {
+        lastError_ = "Python interpreter or librosa failed to initialise";
+        juce::Logger::writeToLog("PythonBackend: " + lastError_);
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<float> PythonBackend::extractFeatures(const std::vector<float>& audioData, double sampleRate)
+{
+    VTR_ASSERT_NOT_REALTIME("Python feature extraction");
+
+    if (!isOpen())
+        return {};
+
+    std::vector<float> features(MAX_FEATURES);
+    const int count = getModule().extract(handle_, audioData.data(), audioData.size(), sampleRate,
+                                          features.data(), MAX_FEATURES);
+    if (count < 0)
+        return {};
+
+    features.resize(static_cast<size_t>(count));
+    return features;
+}
+
+bool PythonBackend::tryExtractFeatures(const std::vector<float>& audioData, double sampleRate, std::vector<float>& features)
+{
+    VTR_ASSERT_NOT_REALTIME("Python feature extraction");
+
+    features.clear();
+    if (!isOpen())
+        return true;
+
+    features.resize(MAX_FEATURES);
+    const int count = getModule().tryExtract(handle_, audioData.data(), audioData.size(), sampleRate,
+                                             features.data(), MAX_FEATURES);
+    if (count == VTR_PYTHON_BACKEND_BUSY)
+    {
+        features.clear();
+        return false;
+    }
+
+    features.resize(count < 0 ? 0 : static_cast<size_t>(count));
+    return true;
+}
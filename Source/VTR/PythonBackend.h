@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "PythonBackendABI.h"
+#include <vector>
+
+/**
+ * Plugin-side handle to the VTRPythonBackend module. The module - and with it libpython - is only
+ * loaded by the first open(), so plugin scans and instances that never use the Python backend do
+ * not pay for it. Once loaded the module stays for the life of the process, as an initialised
+ * interpreter cannot be unloaded
+ */
+class PythonBackend
+{
+public:
+    PythonBackend() = default;
+    ~PythonBackend();
+
+    // Loads the module if needed and creates the interpreter-side extractor. Slow (interpreter
+    // start-up and librosa import), call from a background thread
+    bool open();
+    bool isOpen() const noexcept { return handle_ != nullptr; }
+    const juce::String& getLastError() const noexcept { return lastError_; }
+
+    // Empty on failure
+    std::vector<float> extractFeatures(const std::vector<float>& audioData, double sampleRate);
+
+    // Like extractFeatures, but false without waiting when another extraction already holds the
+    // interpreter. features is empty after a failed extraction
+    bool tryExtractFeatures(const std::vector<float>& audioData, double sampleRate, std::vector<float>& features);
+
+    // VTR_PYTHON_BACKEND overrides the location; otherwise the module is looked for in the bundle's
+    // Contents/Resources, next to the plugin binary, then on the library search path
+    static juce::String getModuleFileName();
+
+private:
+    struct Module
+    {
+        bool loaded = false;
+        juce::String error;
+        VTRPythonBackendCreateFn create = nullptr;
+        VTRPythonBackendDestroyFn destroy = nullptr;
+        VTRPythonBackendExtractFn extract = nullptr;
+        VTRPythonBackendTryExtractFn tryExtract = nullptr;
+    };
+
+    // Loaded once per process, on first use
+    static const Module& getModule();
+
+    VTRPythonBackend* handle_ = nullptr;
+    juce::String lastError_;
+
+    static constexpr int MAX_FEATURES = 17;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PythonBackend)
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * C interface of the VTRPythonBackend module - the only part of the plugin that links libpython.
+ * The plugin opens the module at run time (PythonBackend), so hosts that never use the Python
+ * backend never load Python. Plain C types only; bump the version on any change
+ */
+
+#include <stddef.h>
+
+#define VTR_PYTHON_BACKEND_ABI_VERSION 2
+
+#if defined(_WIN32)
+ #define VTR_PYTHON_BACKEND_EXPORT __declspec(dllexport)
+#else
+ #define VTR_PYTHON_BACKEND_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct VTRPythonBackend VTRPythonBackend;
+
+// Returns VTR_PYTHON_BACKEND_ABI_VERSION of the module build
+typedef int (*VTRPythonBackendAbiVersionFn)(void);
+
+// Starts the interpreter (once per process) and loads the librosa functions; null on failure
+typedef VTRPythonBackend* (*VTRPythonBackendCreateFn)(void);
+typedef void (*VTRPythonBackendDestroyFn)(VTRPythonBackend* backend);
+
+// Writes up to maxFeatures values of the 17-dimensional feature vector and returns how many were
+// written, or -1 on failure. samples are only read during the call
+typedef int (*VTRPythonBackendExtractFn)(VTRPythonBackend* backend, const float* samples, size_t numSamples,
+                                          double sampleRate, float* features, int maxFeatures);
+
+// Same, but returns VTR_PYTHON_BACKEND_BUSY at once when another extraction through this module holds the
+// interpreter, instead of queueing on its GIL
+typedef int (*VTRPythonBackendTryExtractFn)(VTRPythonBackend* backend, const float* samples, size_t numSamples,
+                                             double sampleRate, float* features, int maxFeatures);
+
+#define VTR_PYTHON_BACKEND_BUSY (-2)
+
+#define VTR_PYTHON_BACKEND_ABI_VERSION_SYMBOL "vtr_python_backend_abi_version"
+#define VTR_PYTHON_BACKEND_CREATE_SYMBOL "vtr_python_backend_create"
+#define VTR_PYTHON_BACKEND_DESTROY_SYMBOL "vtr_python_backend_destroy"
+#define VTR_PYTHON_BACKEND_EXTRACT_SYMBOL "vtr_python_backend_extract"
+#define VTR_PYTHON_BACKEND_TRY_EXTRACT_SYMBOL "vtr_python_backend_try_extract"
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+// Entry points of the VTRPythonBackend module (see PythonBackendABI.h). Built as its own shared
+// module together with PythonFeatureExtractor - never compiled into the plugin
+
+#include "PythonBackendABI.h"
+#include "PythonFeatureExtractor.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <new>
+
+struct VTRPythonBackend
+{
+    PythonFeatureExtractor extractor;
+};
+
+namespace
+{
+    // Extractions running through this module. numpy cannot be imported into sub-interpreters with their
+    // own GIL, so they all share the main interpreter's
+    std::atomic<int> extractionsInFlight { 0 };
+
+    int extract(VTRPythonBackend* backend, const float* samples, size_t numSamples,
+                double sampleRate, float* features, int maxFeatures)
+    {
+        if (backend == nullptr || features == nullptr || maxFeatures <= 0 || (samples == nullptr && numSamples > 0))
+            return -1;
+
+        // No C++ exception may cross the C boundary
+        try
+        {
+            const auto result = backend->extractor.extractFeatures(samples, numSamples, sampleRate);
+            const int count = std::min(static_cast<int>(result.size()), maxFeatures);
+            std::copy(result.begin(), result.begin() + count, features);
+            return count;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "VTRPythonBackend: extraction failed: " << e.what() << std::endl;
+            return -1;
+        }
+    }
+}
+
+extern "C"
+{
+
+VTR_PYTHON_BACKEND_EXPORT int vtr_python_backend_abi_version(void)
+{
+    return VTR_PYTHON_BACKEND_ABI_VERSION;
+}
+
+VTR_PYTHON_BACKEND_EXPORT VTRPythonBackend* vtr_python_backend_create(void)
+{
+    auto* backend = new (std::nothrow) VTRPythonBackend();
+    if (backend == nullptr)
+        return nullptr;
+
+    if (!backend->extractor.initialize())
+    {
+        delete backend;
+        return nullptr;
+    }
+
+    return backend;
+}
+
+VTR_PYTHON_BACKEND_EXPORT void vtr_python_backend_destroy(VTRPythonBackend* backend)
+{
+    delete backend;
+}
+
+VTR_PYTHON_BACKEND_EXPORT int vtr_python_backend_extract(VTRPythonBackend* backend, const float* samples, size_t numSamples,
+                                                         double sampleRate, float* features, int maxFeatures)
+{
+    extractionsInFlight.fetch_add(1);
+    const int count = extract(backend, samples, numSamples, sampleRate, features, maxFeatures);
+    extractionsInFlight.fetch_sub(1);
+    return count;
+}
+
+VTR_PYTHON_BACKEND_EXPORT int vtr_python_backend_try_extract(VTRPythonBackend* backend, const float* samples, size_t numSamples,
+                                                             double sampleRate, float* features, int maxFeatures)
+{
+    int idle = 0;
+    if (!extractionsInFlight.compare_exchange_strong(idle, 1))
+        return VTR_PYTHON_BACKEND_BUSY;
+
+    const int count = extract(backend, samples, numSamples, sampleRate, features, maxFeatures);
+    extractionsInFlight.fetch_sub(1);
+    return count;
+}
+
+}
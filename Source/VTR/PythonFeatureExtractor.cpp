@@ -3,6 +3,10 @@
 #include <iostream>
 #include <sstream>
 
+#if defined(__linux__)
+ #include <dlfcn.h>
+#endif
+
 PythonFeatureExtractor::PythonFeatureExtractor()
     : pythonInitialized_(false)
     , pModule_(nullptr)
@@ -39,6 +43,18 @@ bool PythonFeatureExtractor::initializePython()
     {
         std::cout << "PythonFeatureExtractor: Initializing Python interpreter..." << std::endl;
         
+       #if defined(__linux__)
+        // The plugin opens this module with RTLD_LOCAL (juce::DynamicLibrary), and libpython comes in with
+        // it, so extension modules such as numpy's could not resolve the C API. Reopen libpython with
+        // RTLD_GLOBAL before the interpreter imports anything; the handle is never closed
+        Dl_info libpython {};
+        if (dladdr(reinterpret_cast<void*>(&Py_Initialize), &libpython) == 0 || libpython.dli_fname == nullptr
+            || dlopen(libpython.dli_fname, RTLD_NOW | RTLD_GLOBAL) == nullptr)
+        {
+            std::cerr << "PythonFeatureExtractor: could not make libpython global, extension modules may fail to load" << std::endl;
+        }
+       #endif
+        
         // Enable thread support for Python
         PyEval_InitThreads();
         Py_Initialize();
@@ -76,21 +92,24 @@ import sys
 import numpy as np
 import librosa
 
+# audio_data is a read-only memoryview of the plugin's float32 buffer - np.frombuffer wraps it without
+# copying, and results go back as float32 arrays the same way
+
 def extract_features_vector(audio_data, sr=44100):
     """Extract feature vector matching original VTR model"""
     try:
-        y = np.array(audio_data, dtype=np.float32)
+        y = np.frombuffer(audio_data, dtype=np.float32)
         
         # Safety check for audio data size
         if len(y) > 44100 * 60:  # More than 60 seconds at 44.1kHz
             sys.stderr.write(f"ERROR: Audio data too large: {len(y)} samples. Skipping.\n")
             sys.stderr.flush()
-            return [0.0] * 17
+            return np.zeros(17, dtype=np.float32)
         
         if len(y) == 0:
             sys.stderr.write("ERROR: Empty audio data\n")
             sys.stderr.flush()
-            return [0.0] * 17
+            return np.zeros(17, dtype=np.float32)
         
         # Extract features using librosa (exactly matching extract_features.py)
         
@@ -109,32 +128,32 @@ def extract_features_vector(audio_data, sr=44100):
         # Return in the order expected by VTR model: spectral_centroid, spectral_bandwidth,
         # spectral_rolloff, mfcc_1...mfcc_13, rms_energy (total 17 features)
         features = [spectral_centroid, spectral_bandwidth, spectral_rolloff] + mfcc_means + [rms_energy]
-        return features
+        return np.array(features, dtype=np.float32)
         
     except Exception as e:
         sys.stderr.write(f"ERROR in extract_features_vector: {e}\n")
         sys.stderr.flush()
-        return [0.0] * 17
+        return np.zeros(17, dtype=np.float32)
 
 def extract_spectral_centroid(audio_data, sr=44100):
-    y = np.array(audio_data, dtype=np.float32)
+    y = np.frombuffer(audio_data, dtype=np.float32)
     return float(np.mean(librosa.feature.spectral_centroid(y=y, sr=sr)))
 
 def extract_spectral_bandwidth(audio_data, sr=44100):
-    y = np.array(audio_data, dtype=np.float32)
+    y = np.frombuffer(audio_data, dtype=np.float32)
     return float(np.mean(librosa.feature.spectral_bandwidth(y=y, sr=sr)))
 
 def extract_spectral_rolloff(audio_data, sr=44100):
-    y = np.array(audio_data, dtype=np.float32)
+    y = np.frombuffer(audio_data, dtype=np.float32)
     return float(np.mean(librosa.feature.spectral_rolloff(y=y, sr=sr)))
 
 def extract_mfcc(audio_data, n_mfcc=13, sr=44100):
-    y = np.array(audio_data, dtype=np.float32)
+    y = np.frombuffer(audio_data, dtype=np.float32)
     mfccs = librosa.feature.mfcc(y=y, sr=sr, n_mfcc=n_mfcc)
-    return [float(np.mean(mfccs[i])) for i in range(n_mfcc)]
+    return np.mean(mfccs, axis=1).astype(np.float32)
 
 def extract_rms(audio_data, sr=44100):
-    y = np.array(audio_data, dtype=np.float32)
+    y = np.frombuffer(audio_data, dtype=np.float32)
     return float(np.mean(librosa.feature.rms(y=y)))
 )";
     
@@ -143,6 +162,7 @@ def extract_rms(audio_data, sr=44100):
     {
         std::cerr << "Failed to execute Python feature extraction script" << std::endl;
         PyErr_Print();
+        PyGILState_Release(gstate);
         return false;
     }
     
@@ -151,6 +171,7 @@ def extract_rms(audio_data, sr=44100):
     if (!pModule_)
     {
         std::cerr << "Failed to get Python main module" << std::endl;
+        PyGILState_Release(gstate);
         return false;
     }
     
@@ -165,6 +186,7 @@ def extract_rms(audio_data, sr=44100):
     if (!pExtractFeatures_ || !PyCallable_Check(pExtractFeatures_))
     {
         std::cerr << "Failed to get extract_features_vector function" << std::endl;
+        PyGILState_Release(gstate);
         return false;
     }
     
@@ -193,6 +215,11 @@ void PythonFeatureExtractor::cleanup()
 }
 
 std::vector<float> PythonFeatureExtractor::extractFeatures(const std::vector<float>& audioData, double sampleRate)
+{
+    return extractFeatures(audioData.data(), audioData.size(), sampleRate);
+}
+
+std::vector<float> PythonFeatureExtractor::extractFeatures(const float* samples, size_t numSamples, double sampleRate)
 {
     if (!pythonInitialized_ || !pExtractFeatures_)
     {
@@ -200,38 +227,13 @@ std::vector<float> PythonFeatureExtractor::extractFeatures(const std::vector<flo
         return std::vector<float>(17, 0.0f);
     }
     
-    // Acquire GIL for thread safety
-    PyGILState_STATE gstate = PyGILState_Ensure();
-    
-    // Convert audio data to Python list
-    PyObject* pyAudioData = convertAudioDataToPython(audioData);
-    if (!pyAudioData)
-    {
-        PyGILState_Release(gstate);
-        return std::vector<float>(17, 0.0f);
-    }
-    
-    // Prepare arguments
-    PyObject* pArgs = PyTuple_New(2);
-    PyTuple_SetItem(pArgs, 0, pyAudioData);  // audio_data
-    PyTuple_SetItem(pArgs, 1, PyFloat_FromDouble(sampleRate));  // sr
-    
-    // Call Python function
-    PyObject* pResult = PyObject_CallObject(pExtractFeatures_, pArgs);
-    Py_DECREF(pArgs);
-    
-    if (!pResult)
+    std::vector<float> features = callWithAudio(pExtractFeatures_, samples, numSamples, sampleRate);
+    if (features.size() != 17)
     {
         std::cerr << "Python feature extraction failed!" << std::endl;
-        PyErr_Print();
-        PyGILState_Release(gstate);
         return std::vector<float>(17, 0.0f);
     }
     
-    // Convert result to C++ vector
-    std::vector<float> features = convertPythonToVector(pResult);
-    Py_DECREF(pResult);
-    
     // Debug: print the extracted features
     std::cout << "DEBUG: Extracted features (" << features.size() << "): ";
     for (size_t i = 0; i < features.size() && i < 5; ++i) {
@@ -239,9 +241,6 @@ std::vector<float> PythonFeatureExtractor::extractFeatures(const std::vector<flo
     }
     std::cout << "..." << std::endl;
     
-    // Release GIL
-    PyGILState_Release(gstate);
-    
     return features;
 }
 
@@ -250,20 +249,8 @@ float PythonFeatureExtractor::extractSpectralCentroid(const std::vector<float>&
     if (!pythonInitialized_ || !pExtractCentroid_)
         return 0.0f;
     
-    PyObject* pyAudioData = convertAudioDataToPython(audioData);
-    PyObject* pArgs = PyTuple_New(2);
-    PyTuple_SetItem(pArgs, 0, pyAudioData);
-    PyTuple_SetItem(pArgs, 1, PyFloat_FromDouble(sampleRate));
-    
-    PyObject* pResult = PyObject_CallObject(pExtractCentroid_, pArgs);
-    Py_DECREF(pArgs);
-    
-    if (!pResult)
-        return 0.0f;
-    
-    float result = convertPythonToFloat(pResult);
-    Py_DECREF(pResult);
-    return result;
+    auto result = callWithAudio(pExtractCentroid_, audioData.data(), audioData.size(), sampleRate);
+    return result.empty() ? 0.0f : result[0];
 }
 
 float PythonFeatureExtractor::extractSpectralBandwidth(const std::vector<float>& audioData, double sampleRate)
@@ -271,20 +258,8 @@ float PythonFeatureExtractor::extractSpectralBandwidth(const std::vector<float>&
     if (!pythonInitialized_ || !pExtractBandwidth_)
         return 0.0f;
     
-    PyObject* pyAudioData = convertAudioDataToPython(audioData);
-    PyObject* pArgs = PyTuple_New(2);
-    PyTuple_SetItem(pArgs, 0, pyAudioData);
-    PyTuple_SetItem(pArgs, 1, PyFloat_FromDouble(sampleRate));
-    
-    PyObject* pResult = PyObject_CallObject(pExtractBandwidth_, pArgs);
-    Py_DECREF(pArgs);
-    
-    if (!pResult)
-        return 0.0f;
-    
-    float result = convertPythonToFloat(pResult);
-    Py_DECREF(pResult);
-    return result;
+    auto result = callWithAudio(pExtractBandwidth_, audioData.data(), audioData.size(), sampleRate);
+    return result.empty() ? 0.0f : result[0];
 }
 
 float PythonFeatureExtractor::extractSpectralRolloff(const std::vector<float>& audioData, double sampleRate)
@@ -292,20 +267,8 @@ float PythonFeatureExtractor::extractSpectralRolloff(const std::vector<float>& a
     if (!pythonInitialized_ || !pExtractRolloff_)
         return 0.0f;
     
-    PyObject* pyAudioData = convertAudioDataToPython(audioData);
-    PyObject* pArgs = PyTuple_New(2);
-    PyTuple_SetItem(pArgs, 0, pyAudioData);
-    PyTuple_SetItem(pArgs, 1, PyFloat_FromDouble(sampleRate));
-    
-    PyObject* pResult = PyObject_CallObject(pExtractRolloff_, pArgs);
-    Py_DECREF(pArgs);
-    
-    if (!pResult)
-        return 0.0f;
-    
-    float result = convertPythonToFloat(pResult);
-    Py_DECREF(pResult);
-    return result;
+    auto result = callWithAudio(pExtractRolloff_, audioData.data(), audioData.size(), sampleRate);
+    return result.empty() ? 0.0f : result[0];
 }
 
 std::vector<float> PythonFeatureExtractor::extractMFCC(const std::vector<float>& audioData, int numCoeffs, double sampleRate)
@@ -313,20 +276,10 @@ std::vector<float> PythonFeatureExtractor::extractMFCC(const std::vector<float>&
     if (!pythonInitialized_ || !pExtractMFCC_)
         return std::vector<float>(numCoeffs, 0.0f);
     
-    PyObject* pyAudioData = convertAudioDataToPython(audioData);
-    PyObject* pArgs = PyTuple_New(3);
-    PyTuple_SetItem(pArgs, 0, pyAudioData);
-    PyTuple_SetItem(pArgs, 1, PyLong_FromLong(numCoeffs));
-    PyTuple_SetItem(pArgs, 2, PyFloat_FromDouble(sampleRate));
-    
-    PyObject* pResult = PyObject_CallObject(pExtractMFCC_, pArgs);
-    Py_DECREF(pArgs);
-    
-    if (!pResult)
+    auto result = callWithAudio(pExtractMFCC_, audioData.data(), audioData.size(), sampleRate, numCoeffs);
+    if (result.empty())
         return std::vector<float>(numCoeffs, 0.0f);
     
-    std::vector<float> result = convertPythonToVector(pResult);
-    Py_DECREF(pResult);
     return result;
 }
 
@@ -335,81 +288,119 @@ float PythonFeatureExtractor::extractRMSEnergy(const std::vector<float>& audioDa
     if (!pythonInitialized_ || !pExtractRMS_)
         return 0.0f;
     
-    PyObject* pyAudioData = convertAudioDataToPython(audioData);
-    PyObject* pArgs = PyTuple_New(2);
-    PyTuple_SetItem(pArgs, 0, pyAudioData);
-    PyTuple_SetItem(pArgs, 1, PyFloat_FromDouble(sampleRate));
-    
-    PyObject* pResult = PyObject_CallObject(pExtractRMS_, pArgs);
-    Py_DECREF(pArgs);
-    
-    if (!pResult)
-        return 0.0f;
-    
-    float result = convertPythonToFloat(pResult);
-    Py_DECREF(pResult);
-    return result;
+    auto result = callWithAudio(pExtractRMS_, audioData.data(), audioData.size(), sampleRate);
+    return result.empty() ? 0.0f : result[0];
 }
 
 // Helper methods
-PyObject* PythonFeatureExtractor::convertAudioDataToPython(const std::vector<float>& audioData)
+std::vector<float> PythonFeatureExtractor::callWithAudio(PyObject* function, const float* samples, size_t numSamples,
+                                                         double sampleRate, int numCoeffs)
 {
-    PyObject* pyList = PyList_New(audioData.size());
-    if (!pyList)
-        return nullptr;
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    
+    std::vector<float> result;
+    PyObject* pyAudioData = wrapAudioData(samples, numSamples);
     
-    for (size_t i = 0; i < audioData.size(); ++i)
+    if (pyAudioData)
     {
-        PyObject* pyFloat = PyFloat_FromDouble(static_cast<double>(audioData[i]));
-        PyList_SetItem(pyList, i, pyFloat);
+        // Arguments: (audio_data, sr) or (audio_data, n_mfcc, sr)
+        PyObject* pArgs = numCoeffs > 0
+            ? Py_BuildValue("(Oid)", pyAudioData, numCoeffs, sampleRate)
+            : Py_BuildValue("(Od)", pyAudioData, sampleRate);
+        
+        PyObject* pResult = pArgs ? PyObject_CallObject(function, pArgs) : nullptr;
+        Py_XDECREF(pArgs);
+        
+        if (pResult)
+        {
+            result = convertPythonToVector(pResult);
+            Py_DECREF(pResult);
+        }
+        else
+        {
+            PyErr_Print();
+        }
+        
+        // The view points into the caller's samples, which the caller may free as soon as we return. release() fails
+        // if Python still holds an export of it, so that shows up here rather than as a dangling read later
+        PyObject* released = PyObject_CallMethod(pyAudioData, "release", nullptr);
+        if (!released)
+        {
+            std::cerr << "PythonFeatureExtractor: audio buffer still referenced after the call" << std::endl;
+            PyErr_Print();
+        }
+        Py_XDECREF(released);
+        Py_DECREF(pyAudioData);
     }
     
-    return pyList;
+    PyGILState_Release(gstate);
+    return result;
+}
+
+PyObject* PythonFeatureExtractor::wrapAudioData(const float* samples, size_t numSamples)
+{
+    // Read-only view of the samples themselves - no per-sample objects, no copy
+    static float empty = 0.0f;
+    char* data = reinterpret_cast<char*>(const_cast<float*>(numSamples == 0 ? &empty : samples));
+    return PyMemoryView_FromMemory(data, static_cast<Py_ssize_t>(numSamples * sizeof(float)), PyBUF_READ);
 }
 
-std::vector<float> PythonFeatureExtractor::convertPythonToVector(PyObject* pyList)
+std::vector<float> PythonFeatureExtractor::convertPythonToVector(PyObject* pyResult)
 {
-    if (!PyList_Check(pyList))
+    // float32 arrays (and anything else exporting contiguous floats) are copied straight out of their buffer
+    if (PyObject_CheckBuffer(pyResult))
     {
-        std::cerr << "ERROR: convertPythonToVector - not a list!" << std::endl;
+        Py_buffer view;
+        if (PyObject_GetBuffer(pyResult, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0)
+        {
+            std::vector<float> result;
+            const bool isEmpty = view.len == 0;
+            if (view.itemsize == sizeof(float) && view.format != nullptr && std::string(view.format) == "f")
+            {
+                const auto* samples = static_cast<const float*>(view.buf);
+                result.assign(samples, samples + view.len / static_cast<Py_ssize_t>(sizeof(float)));
+            }
+            PyBuffer_Release(&view);
+            
+            if (!result.empty() || isEmpty)
+                return result;
+        }
+        PyErr_Clear();
+    }
+    
+    // Scalars from the single-feature functions
+    if (PyFloat_Check(pyResult) || PyLong_Check(pyResult))
+        return { convertPythonToFloat(pyResult) };
+    
+    // Anything else iterable, element by element (handles lists and other numpy dtypes)
+    PyObject* sequence = PySequence_Fast(pyResult, "expected a sequence of floats");
+    if (!sequence)
+    {
+        std::cerr << "ERROR: convertPythonToVector - unsupported result type" << std::endl;
+        PyErr_Clear();
         return {};
     }
     
-    Py_ssize_t size = PyList_Size(pyList);
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
     std::vector<float> result;
     result.reserve(size);
     
     for (Py_ssize_t i = 0; i < size; ++i)
     {
-        PyObject* item = PyList_GetItem(pyList, i);
-        if (PyFloat_Check(item))
-        {
-            float val = static_cast<float>(PyFloat_AsDouble(item));
-            result.push_back(val);
-        }
-        else if (PyLong_Check(item))
+        PyObject* floatObj = PyNumber_Float(PySequence_Fast_GET_ITEM(sequence, i));
+        if (floatObj)
         {
-            float val = static_cast<float>(PyLong_AsLong(item));
-            result.push_back(val);
+            result.push_back(static_cast<float>(PyFloat_AsDouble(floatObj)));
+            Py_DECREF(floatObj);
         }
         else
         {
-            // Try to convert to float using PyFloat_AsDouble (handles numpy types)
-            PyObject* floatObj = PyNumber_Float(item);
-            if (floatObj)
-            {
-                float val = static_cast<float>(PyFloat_AsDouble(floatObj));
-                result.push_back(val);
-                Py_DECREF(floatObj);
-            }
-            else
-            {
-                result.push_back(0.0f);
-                PyErr_Clear(); // Clear any Python errors
-            }
+            result.push_back(0.0f);
+            PyErr_Clear(); // Clear any Python errors
         }
     }
     
+    Py_DECREF(sequence);
     return result;
 }
 
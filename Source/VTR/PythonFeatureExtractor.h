@@ -3,11 +3,19 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstddef>
 
 // Forward declaration to avoid Python.h in header
 struct _object;
 typedef _object PyObject;
 
+/**
+ * Embedded-interpreter librosa backend. Lives in the VTRPythonBackend module (PythonBackendModule.cpp)
+ * and is reached from the plugin through PythonBackend
+ *
+ * Every call runs on the main interpreter, so concurrent extractions queue on its GIL. Sub-interpreters
+ * with their own GIL would not help: numpy refuses to import into them
+ */
 class PythonFeatureExtractor
 {
 public:
@@ -19,6 +27,7 @@ public:
     
     // Extract features using Python librosa (matches original VTR model)
     std::vector<float> extractFeatures(const std::vector<float>& audioData, double sampleRate = 44100.0);
+    std::vector<float> extractFeatures(const float* samples, size_t numSamples, double sampleRate = 44100.0);
     
     // Individual feature extraction (for compatibility)
     float extractSpectralCentroid(const std::vector<float>& audioData, double sampleRate = 44100.0);
@@ -31,8 +40,14 @@ public:
     
 private:
     bool initializePython();
-    PyObject* convertAudioDataToPython(const std::vector<float>& audioData);
-    std::vector<float> convertPythonToVector(PyObject* pyList);
+    
+    // Calls function(audio_data, [n_mfcc,] sr) under the GIL and converts whatever it returns.
+    // Empty on failure
+    std::vector<float> callWithAudio(PyObject* function, const float* samples, size_t numSamples, double sampleRate, int numCoeffs = 0);
+    
+    // Read-only memoryview over the samples (no copy) - only valid while they are
+    PyObject* wrapAudioData(const float* samples, size_t numSamples);
+    std::vector<float> convertPythonToVector(PyObject* pyResult);
     float convertPythonToFloat(PyObject* pyFloat);
     
     bool pythonInitialized_;
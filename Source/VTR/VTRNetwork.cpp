@@ -1,4 +1,5 @@
 #include "VTRNetwork.h"
+#include "../DSP/RealtimeGuard.h"
 #include <juce_core/juce_core.h>
 #include <fstream>
 #include <cmath>
@@ -17,6 +18,8 @@ VTRNetwork::~VTRNetwork() = default;
 
 bool VTRNetwork::loadModel(const std::string& modelWeightsPath, const std::string& scalerParamsPath)
 {
+    VTR_ASSERT_NOT_REALTIME("model file I/O");
+    
     // Load scaler parameters
     if (!scaler_->loadParameters(scalerParamsPath))
     {
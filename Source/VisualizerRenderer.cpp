@@ -0,0 +1,186 @@
+#include "VisualizerRenderer.h"
+
+VisualizerRenderer::VisualizerRenderer()
+    : juce::Thread("Visualizer Renderer")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+VisualizerRenderer::~VisualizerRenderer()
+{
+    signalThreadShouldExit();
+    workAvailable.signal();
+    stopThread(1000);
+}
+
+void VisualizerRenderer::schedule(Layer& layer)
+{
+    {
+        const std::lock_guard<std::mutex> lock(queueMutex);
+        queuedLayers.addIfNotAlreadyThere(&layer);
+    }
+
+    workAvailable.signal();
+}
+
+void VisualizerRenderer::cancel(Layer& layer)
+{
+    const std::lock_guard<std::mutex> lock(queueMutex);
+    queuedLayers.removeFirstMatchingValue(&layer);
+}
+
+void VisualizerRenderer::run()
+{
+    while (!threadShouldExit())
+    {
+        Layer* layer = nullptr;
+
+        {
+            const std::lock_guard<std::mutex> lock(queueMutex);
+            if (!queuedLayers.isEmpty())
+            {
+                layer = queuedLayers.removeAndReturn(0);
+
+                // Taken before the queue lock is released, so a Layer removed by cancel() is never touched again
+                layer->renderLock.enter();
+            }
+        }
+
+        if (layer == nullptr)
+        {
+            workAvailable.wait(100);
+            continue;
+        }
+
+        layer->renderPendingJob();
+        layer->renderLock.exit();
+    }
+}
+
+//==============================================================================
+VisualizerRenderer::Layer::Layer(juce::Component& ownerToRepaint)
+    : owner(ownerToRepaint)
+{
+}
+
+VisualizerRenderer::Layer::~Layer()
+{
+    renderer->cancel(*this);
+
+    // Wait for a render that was already in flight
+    const juce::ScopedLock lock(renderLock);
+    cancelPendingUpdate();
+}
+
+void VisualizerRenderer::Layer::render(Painter painter)
+{
+    auto job = createJob(std::move(painter));
+    if (job.width <= 0 || job.height <= 0)
+        return;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(jobLock);
+        pendingJob = std::move(job);
+    }
+
+    renderer->schedule(*this);
+}
+
+void VisualizerRenderer::Layer::renderNow(const Painter& painter)
+{
+    const auto job = createJob(painter);
+
+    juce::Image image;
+    if (job.width > 0 && job.height > 0)
+        rasterize(job, image);
+
+    {
+        const juce::SpinLock::ScopedLockType lock(imageLock);
+        frontImage = std::move(image);
+    }
+
+    owner.repaint();
+}
+
+void VisualizerRenderer::Layer::draw(juce::Graphics& g, juce::Rectangle<float> area) const
+{
+    juce::Image image;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(imageLock);
+        image = frontImage;
+    }
+
+    if (image.isValid())
+        g.drawImage(image, area);
+}
+
+void VisualizerRenderer::Layer::clear()
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(jobLock);
+        pendingJob = {};
+    }
+
+    const juce::SpinLock::ScopedLockType lock(imageLock);
+    frontImage = {};
+}
+
+VisualizerRenderer::Layer::Job VisualizerRenderer::Layer::createJob(Painter painter) const
+{
+    Job job;
+    job.width = owner.getWidth();
+    job.height = owner.getHeight();
+    job.scale = juce::Component::getApproximateScaleFactorForComponent(&owner);
+    job.painter = std::move(painter);
+    return job;
+}
+
+void VisualizerRenderer::Layer::rasterize(const Job& job, juce::Image& target)
+{
+    const int pixelWidth = juce::roundToInt(static_cast<float>(job.width) * job.scale);
+    const int pixelHeight = juce::roundToInt(static_cast<float>(job.height) * job.scale);
+
+    // Reuse the previous image unless paint() still holds a reference to it
+    if (target.isValid() && target.getWidth() == pixelWidth && target.getHeight() == pixelHeight
+        && target.getReferenceCount() == 1)
+    {
+        target.clear(target.getBounds());
+    }
+    else
+    {
+        target = juce::Image(juce::Image::ARGB, pixelWidth, pixelHeight, true, juce::SoftwareImageType());
+    }
+
+    juce::Graphics g(target);
+    g.addTransform(juce::AffineTransform::scale(job.scale));
+    job.painter(g);
+}
+
+void VisualizerRenderer::Layer::renderPendingJob()
+{
+    Job job;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(jobLock);
+        job = std::move(pendingJob);
+        pendingJob = {};
+    }
+
+    if (!job.painter)
+        return;
+
+    rasterize(job, backImage);
+
+    {
+        const juce::SpinLock::ScopedLockType lock(imageLock);
+        std::swap(frontImage, backImage);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void VisualizerRenderer::Layer::handleAsyncUpdate()
+{
+    owner.repaint();
+}
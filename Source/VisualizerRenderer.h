@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <functional>
+#include <mutex>
+
+/**
+ * Shared background rasterizer for the analyzer displays
+ * Each display owns Layers: static ones (grid, labels) are drawn once per resize, dynamic ones
+ * (spectrum, EQ curve) are stroked on this thread so paint() only has to blit images
+ */
+class VisualizerRenderer : private juce::Thread
+{
+public:
+    // Draws in component coordinates - runs off the message thread, so capture data by value
+    using Painter = std::function<void(juce::Graphics&)>;
+
+    VisualizerRenderer();
+    ~VisualizerRenderer() override;
+
+    /** A cached image owned by one component, sized to the component at its display scale */
+    class Layer : private juce::AsyncUpdater
+    {
+    public:
+        explicit Layer(juce::Component& ownerToRepaint);
+        ~Layer() override;
+
+        // Queues a background render - a newer request replaces one that has not started yet
+        void render(Painter painter);
+
+        // Draws synchronously on the message thread - for layers that only change on resize
+        void renderNow(const Painter& painter);
+
+        // Blits the latest finished image (message thread)
+        void draw(juce::Graphics& g, juce::Rectangle<float> area) const;
+
+        void clear();
+
+    private:
+        friend class VisualizerRenderer;
+
+        struct Job
+        {
+            int width = 0;
+            int height = 0;
+            float scale = 1.0f;
+            Painter painter;
+        };
+
+        Job createJob(Painter painter) const;
+        static void rasterize(const Job& job, juce::Image& target);
+        void renderPendingJob();
+        void handleAsyncUpdate() override;
+
+        juce::SharedResourcePointer<VisualizerRenderer> renderer;
+        juce::Component& owner;
+
+        // Held by the render thread for the whole job so the destructor can wait it out
+        juce::CriticalSection renderLock;
+
+        juce::SpinLock jobLock;
+        Job pendingJob;
+
+        mutable juce::SpinLock imageLock;
+        juce::Image frontImage;
+        juce::Image backImage; // render thread only
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Layer)
+    };
+
+private:
+    void run() override;
+    void schedule(Layer& layer);
+    void cancel(Layer& layer);
+
+    std::mutex queueMutex;
+    juce::Array<Layer*> queuedLayers;
+    juce::WaitableEvent workAvailable;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VisualizerRenderer)
+};
@@ -0,0 +1,142 @@
+/**
+ * Two extractions at once on the PYTHON_LIBROSA backend: one runs in the embedded interpreter, the one that
+ * finds it busy goes to standalone_extractor/feature_extractor.py in a child process, and both agree
+ *
+ *     VTRConcurrentExtractionTest <python> <feature_extractor.py>
+ *
+ * VTR_PYTHON_BACKEND must point at the VTRPythonBackend module. Exits with SKIP_EXIT_CODE when the embedded
+ * interpreter cannot import librosa, or on Windows, where the child wrapper below is a shell script
+ */
+
+#include <juce_core/juce_core.h>
+#include "../Source/VTR/FeatureExtractor.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int SKIP_EXIT_CODE = 77;
+
+    // Both paths run librosa; only float32 round-off between the interpreters may differ
+    constexpr double RELATIVE_TOLERANCE = 1.0e-3;
+    constexpr double MFCC_ABSOLUTE_TOLERANCE = 0.05;
+
+    constexpr double SAMPLE_RATE = 44100.0;
+    constexpr double SIGNAL_SECONDS = 20.0; // long enough for the two extractions to overlap
+    constexpr int WARM_UP_TIMEOUT_MS = 180000;
+
+    std::vector<float> testSignal()
+    {
+        juce::Random random(1234);
+        std::vector<float> samples(static_cast<size_t>(SAMPLE_RATE * SIGNAL_SECONDS));
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            const double phase = juce::MathConstants<double>::twoPi * 440.0 * static_cast<double>(i) / SAMPLE_RATE;
+            samples[i] = 0.4f * static_cast<float>(std::sin(phase)) + 0.05f * (random.nextFloat() - 0.5f);
+        }
+        return samples;
+    }
+
+    bool featuresMatch(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        if (a.size() != 17 || b.size() != 17)
+            return false;
+
+        for (size_t index = 0; index < a.size(); ++index)
+        {
+            const bool isMfcc = index >= 3 && index < 16;
+            const double error = isMfcc ? std::abs(a[index] - b[index])
+                                        : std::abs(a[index] - b[index]) / juce::jmax(std::abs(static_cast<double>(b[index])), 1.0e-9);
+            if (!std::isfinite(a[index]) || error > (isMfcc ? MFCC_ABSOLUTE_TOLERANCE : RELATIVE_TOLERANCE))
+            {
+                std::cout << "feature " << index << ": " << a[index] << " vs " << b[index] << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+   #if JUCE_WINDOWS
+    juce::ignoreUnused(argc, argv);
+    std::cout << "The child wrapper is a shell script, skipping" << std::endl;
+    return SKIP_EXIT_CODE;
+   #else
+    if (argc < 3)
+    {
+        std::cerr << "usage: VTRConcurrentExtractionTest <python> <feature_extractor.py>" << std::endl;
+        return 1;
+    }
+
+    // The child the busy caller gets - found through VTR_EXTRACTOR_PATH like an installed extractor
+    juce::TemporaryFile wrapper(".sh");
+    wrapper.getFile().replaceWithText("#!/bin/sh\nexec '" + juce::String(argv[1]) + "' '" + juce::String(argv[2]) + "' \"$@\"\n");
+    wrapper.getFile().setExecutePermission(true);
+    setenv("VTR_EXTRACTOR_PATH", wrapper.getFile().getFullPathName().toRawUTF8(), 1);
+
+    FeatureExtractor extractor;
+    extractor.initialize(SAMPLE_RATE, 2048, FeatureExtractor::Backend::PYTHON_LIBROSA);
+
+    const auto warmUpStart = juce::Time::getMillisecondCounter();
+    while (extractor.getPythonWarmUpState() == FeatureExtractor::WarmUpState::WarmingUp
+           && juce::Time::getMillisecondCounter() - warmUpStart < static_cast<juce::uint32>(WARM_UP_TIMEOUT_MS))
+        juce::Thread::sleep(50);
+
+    if (extractor.getPythonWarmUpState() != FeatureExtractor::WarmUpState::Ready)
+    {
+        std::cout << "The embedded interpreter did not warm up (is VTR_PYTHON_BACKEND set?), skipping" << std::endl;
+        return SKIP_EXIT_CODE;
+    }
+
+    const auto signal = testSignal();
+    std::array<std::vector<float>, 2> results;
+    std::atomic<int> waiting { static_cast<int>(results.size()) };
+
+    std::vector<std::thread> threads;
+    for (auto& result : results)
+    {
+        threads.emplace_back([&extractor, &signal, &result, &waiting]
+        {
+            // Start both extractions together
+            waiting.fetch_sub(1);
+            while (waiting.load() > 0)
+                std::this_thread::yield();
+
+            result = extractor.extractFeatures(signal);
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto counts = extractor.getExtractionCounts();
+    std::cout << "python " << counts.python << ", external " << counts.external << ", native " << counts.native << std::endl;
+
+    int failures = 0;
+    if (counts.python != 1 || counts.external != 1)
+    {
+        std::cout << "FAIL expected one extraction in the embedded interpreter and one in the child" << std::endl;
+        ++failures;
+    }
+
+    if (!featuresMatch(results[0], results[1]))
+    {
+        std::cout << "FAIL the two extractions disagree" << std::endl;
+        ++failures;
+    }
+
+    if (failures > 0)
+        return 1;
+
+    std::cout << "Both extractions ran concurrently and agree" << std::endl;
+    return 0;
+   #endif
+}
@@ -0,0 +1,166 @@
+/**
+ * Checks ExternalFeatureExtractor against children that hang or break the protocol, and - given a Python
+ * with librosa - round-trips requests through standalone_extractor/feature_extractor.py
+ *
+ *     VTRExternalExtractorTest [<python> <feature_extractor.py>]
+ *
+ * Without the Python arguments only the failure cases run. Exits with SKIP_EXIT_CODE on Windows, where the
+ * fake children below cannot be written as shell scripts
+ */
+
+#include <juce_core/juce_core.h>
+#include "../Source/VTR/ExternalFeatureExtractor.h"
+#include "../Source/VTR/FeaturePipeline.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    constexpr int SKIP_EXIT_CODE = 77;
+
+    // The Python features against the native pipeline with the plugin's settings. Looser than the parity
+    // test - the pipeline pads centred frames the way librosa 0.9 does, whichever librosa is installed
+    constexpr double RELATIVE_TOLERANCE = 1.0e-2;
+    constexpr double MFCC_ABSOLUTE_TOLERANCE = 0.5;
+
+    // What a timed-out request may take on top of its timeout (the kill and reap)
+    constexpr int SLACK_MS = 2000;
+
+    int failures = 0;
+
+    void check(bool condition, const juce::String& description)
+    {
+        std::cout << (condition ? "PASS " : "FAIL ") << description << std::endl;
+        if (!condition)
+            ++failures;
+    }
+
+    int millisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    }
+
+    // An executable shell script, deleted with the returned file
+    std::unique_ptr<juce::TemporaryFile> writeScript(const juce::String& body)
+    {
+        auto script = std::make_unique<juce::TemporaryFile>(".sh");
+        script->getFile().replaceWithText("#!/bin/sh\n" + body + "\n");
+        script->getFile().setExecutePermission(true);
+        return script;
+    }
+
+    std::vector<float> sine(double sampleRate, double frequency, double seconds)
+    {
+        std::vector<float> samples(static_cast<size_t>(sampleRate * seconds));
+        for (size_t i = 0; i < samples.size(); ++i)
+            samples[i] = 0.5f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * static_cast<double>(i) / sampleRate));
+        return samples;
+    }
+
+    void testUnresponsiveChild()
+    {
+        // Never reports ready
+        auto script = writeScript("exec sleep 60");
+        VTR::ExternalFeatureExtractor extractor(script->getFile().getFullPathName().toStdString());
+        extractor.setTimeouts({ 500, 500, 200 });
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool started = extractor.startProcess();
+        const int elapsed = millisecondsSince(start);
+
+        check(!started, "a child that never reports ready is not started");
+        check(elapsed < 500 + SLACK_MS, "start-up gives up after its timeout (" + juce::String(elapsed) + " ms)");
+        check(!extractor.isProcessRunning(), "the silent child is not left running");
+        check(!extractor.getLastError().empty(), "the start-up failure is reported");
+    }
+
+    void testHungRequest()
+    {
+        // A version 2 ready response, then nothing
+        auto script = writeScript("printf 'VTRX\\002\\000\\002\\000\\000\\000\\000\\000\\000\\000\\000\\000'\nexec sleep 60");
+        VTR::ExternalFeatureExtractor extractor(script->getFile().getFullPathName().toStdString());
+        extractor.setTimeouts({ 2000, 500, 200 });
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto features = extractor.extractFeatures(sine(44100.0, 440.0, 0.5), 44100.0);
+        const int elapsed = millisecondsSince(start);
+
+        check(features.empty(), "a request the child never answers returns nothing");
+        check(elapsed < 2000 + 500 + SLACK_MS, "the request gives up after its timeout (" + juce::String(elapsed) + " ms)");
+        check(!extractor.isProcessRunning(), "the hung child is killed");
+    }
+
+    void testPythonRoundTrip(const juce::String& python, const juce::String& scriptPath)
+    {
+        auto script = writeScript("exec '" + python + "' '" + scriptPath + "' \"$@\"");
+        VTR::ExternalFeatureExtractor extractor(script->getFile().getFullPathName().toStdString());
+
+        constexpr double sampleRate = 44100.0;
+        const auto signal = sine(sampleRate, 440.0, 3.0);
+
+        const auto features = extractor.extractFeatures(signal, sampleRate);
+        check(features.size() == FeaturePipeline::FEATURE_VECTOR_SIZE,
+              "the daemon returns " + juce::String(FeaturePipeline::FEATURE_VECTOR_SIZE) + " features (" + extractor.getLastError() + ")");
+        if (features.size() != FeaturePipeline::FEATURE_VECTOR_SIZE)
+            return;
+
+        FeaturePipeline::Settings settings;
+        settings.sampleRate = sampleRate;
+        settings.maxFrequency = static_cast<float>(sampleRate / 2.0);
+
+        FeaturePipeline pipeline;
+        pipeline.prepare(settings);
+        pipeline.processSignal(signal.data(), signal.size());
+        const auto native = pipeline.getFeatures();
+
+        for (int index = 0; index < FeaturePipeline::FEATURE_VECTOR_SIZE; ++index)
+        {
+            const double want = native[static_cast<size_t>(index)];
+            const double got = features[static_cast<size_t>(index)];
+            const bool isMfcc = index >= FeaturePipeline::MFCC_INDEX && index < FeaturePipeline::RMS_INDEX;
+            const double error = isMfcc ? std::abs(got - want) : std::abs(got - want) / juce::jmax(std::abs(want), 1.0e-9);
+
+            if (!std::isfinite(got) || error > (isMfcc ? MFCC_ABSOLUTE_TOLERANCE : RELATIVE_TOLERANCE))
+                check(false, "feature " + juce::String(index) + ": native " + juce::String(want) + ", daemon " + juce::String(got));
+        }
+
+        // The daemon rejects an empty signal; its error response must leave the stream in step
+        const auto rejected = extractor.extractFeatures({}, sampleRate);
+        check(rejected.empty() && !extractor.getLastError().empty(), "an error response is reported (" + extractor.getLastError() + ")");
+        check(extractor.isProcessRunning(), "the daemon stays up after an error response");
+        check(extractor.extractFeatures(signal, sampleRate) == features, "the request after the error gets the same features");
+
+        // A stopped daemon is started again by the next request
+        extractor.stopProcess();
+        check(!extractor.isProcessRunning(), "stopProcess ends the daemon");
+        check(extractor.extractFeatures(signal, sampleRate) == features, "a restarted daemon gets the same features");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+   #if JUCE_WINDOWS
+    juce::ignoreUnused(argc, argv);
+    std::cout << "The fake extractors are shell scripts, skipping" << std::endl;
+    return SKIP_EXIT_CODE;
+   #else
+    testUnresponsiveChild();
+    testHungRequest();
+
+    if (argc >= 3)
+        testPythonRoundTrip(argv[1], argv[2]);
+    else
+        std::cout << "No Python with librosa given, skipping the round trip" << std::endl;
+
+    if (failures > 0)
+    {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+   #endif
+}
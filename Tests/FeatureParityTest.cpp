@@ -0,0 +1,183 @@
+/**
+ * Checks the native FeaturePipeline against librosa. Reads the WAV files and golden.json written by
+ * vtr-model/export_feature_vectors.py and fails when any feature is outside the tolerance that script uses
+ *
+ *     VTRFeatureParityTest <feature_vectors dir> [--write native.json]
+ *
+ * --write also stores the native vectors in the format export_feature_vectors.py --check reads.
+ * Each file also goes through a FeatureExtractor initialised at a 48 kHz host rate, which must extract it
+ * at the file's own rate. Exits with SKIP_EXIT_CODE when the golden vectors have not been exported
+ */
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "../Source/VTR/FeatureExtractor.h"
+#include "../Source/VTR/FeaturePipeline.h"
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    constexpr int SKIP_EXIT_CODE = 77;
+
+    // Same limits as export_feature_vectors.py
+    constexpr double RELATIVE_TOLERANCE = 1.0e-3;      // spectral centroid/bandwidth/rolloff and RMS
+    constexpr double MFCC_ABSOLUTE_TOLERANCE = 0.05;
+
+    // A host rate other than the 44.1k the golden files are written at
+    constexpr double HOST_SAMPLE_RATE = 48000.0;
+
+    bool withinTolerance(int index, double got, double want)
+    {
+        const bool isMfcc = index >= FeaturePipeline::MFCC_INDEX && index < FeaturePipeline::RMS_INDEX;
+        const double error = isMfcc ? std::abs(got - want) : std::abs(got - want) / juce::jmax(std::abs(want), 1.0e-9);
+        return error <= (isMfcc ? MFCC_ABSOLUTE_TOLERANCE : RELATIVE_TOLERANCE);
+    }
+
+    // librosa pads centred frames with reflect up to 0.9 and with zeros from 0.10
+    FeaturePipeline::PadMode padModeFor(const juce::String& librosaVersion)
+    {
+        const auto parts = juce::StringArray::fromTokens(librosaVersion, ".", {});
+        const int major = parts[0].getIntValue();
+        const int minor = parts[1].getIntValue();
+        return (major == 0 && minor < 10) ? FeaturePipeline::PadMode::Reflect : FeaturePipeline::PadMode::Constant;
+    }
+
+    bool readMono(const juce::File& file, juce::AudioFormatManager& formats, juce::AudioBuffer<float>& samples, double& sampleRate)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+        if (reader == nullptr || reader->numChannels != 1)
+            return false;
+
+        samples.setSize(1, static_cast<int>(reader->lengthInSamples));
+        sampleRate = reader->sampleRate;
+        return reader->read(&samples, 0, samples.getNumSamples(), 0, true, false);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: VTRFeatureParityTest <feature_vectors dir> [--write native.json]" << std::endl;
+        return 1;
+    }
+
+    const juce::File directory(juce::File::getCurrentWorkingDirectory().getChildFile(argv[1]));
+    const juce::File goldenFile = directory.getChildFile("golden.json");
+    const juce::File nativeFile = (argc >= 4 && juce::String(argv[2]) == "--write")
+                                      ? juce::File::getCurrentWorkingDirectory().getChildFile(argv[3])
+                                      : juce::File();
+
+    if (!goldenFile.existsAsFile())
+    {
+        std::cout << "No golden vectors in " << directory.getFullPathName()
+                  << " - run vtr-model/export_feature_vectors.py first, skipping" << std::endl;
+        return SKIP_EXIT_CODE;
+    }
+
+    const juce::var golden = juce::JSON::parse(goldenFile);
+    const auto* vectors = golden["vectors"].getDynamicObject();
+    const auto* featureNames = golden["feature_names"].getArray();
+    if (vectors == nullptr || featureNames == nullptr || featureNames->size() != FeaturePipeline::FEATURE_VECTOR_SIZE)
+    {
+        std::cerr << "Malformed " << goldenFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    FeaturePipeline::Settings settings;
+    settings.padMode = padModeFor(golden["librosa_version"].toString());
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    FeaturePipeline pipeline;
+    FeaturePipeline extractorPipeline; // FeatureExtractor's own settings, which pad the way librosa 0.9 does
+    FeatureExtractor hostRateExtractor;
+    hostRateExtractor.initialize(HOST_SAMPLE_RATE, 2048, FeatureExtractor::Backend::JUCE_BASED);
+    juce::DynamicObject::Ptr native = new juce::DynamicObject();
+    int failures = 0;
+
+    for (const auto& entry : vectors->getProperties())
+    {
+        const juce::String name = entry.name.toString();
+        const auto* expected = entry.value.getArray();
+
+        juce::AudioBuffer<float> samples;
+        double sampleRate = 0.0;
+        if (!readMono(directory.getChildFile(name + ".wav"), formats, samples, sampleRate)
+            || expected == nullptr || expected->size() != FeaturePipeline::FEATURE_VECTOR_SIZE)
+        {
+            std::cout << "FAIL " << name << ": missing or unreadable" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        if (!pipeline.isPrepared() || pipeline.getSettings().sampleRate != sampleRate)
+        {
+            settings.sampleRate = sampleRate;
+            settings.maxFrequency = static_cast<float>(sampleRate / 2.0);
+            pipeline.prepare(settings);
+        }
+
+        pipeline.reset();
+        pipeline.processSignal(samples.getReadPointer(0), static_cast<size_t>(samples.getNumSamples()));
+        const auto features = pipeline.getFeatures();
+
+        juce::Array<juce::var> nativeValues;
+        for (int index = 0; index < FeaturePipeline::FEATURE_VECTOR_SIZE; ++index)
+        {
+            const double want = static_cast<double>((*expected)[index]);
+            const double got = features[static_cast<size_t>(index)];
+            nativeValues.add(got);
+
+            if (!withinTolerance(index, got, want))
+            {
+                std::cout << "FAIL " << name << " " << (*featureNames)[index].toString()
+                          << ": expected " << want << ", got " << got << std::endl;
+                ++failures;
+            }
+        }
+
+        // The same file through the extractor the plugin uses, whose host runs at another rate
+        if (!extractorPipeline.isPrepared() || extractorPipeline.getSettings().sampleRate != sampleRate)
+        {
+            FeaturePipeline::Settings extractorSettings;
+            extractorSettings.sampleRate = sampleRate;
+            extractorSettings.maxFrequency = static_cast<float>(sampleRate / 2.0);
+            extractorPipeline.prepare(extractorSettings);
+        }
+
+        extractorPipeline.reset();
+        extractorPipeline.processSignal(samples.getReadPointer(0), static_cast<size_t>(samples.getNumSamples()));
+        const auto expectedAtFileRate = extractorPipeline.getFeatures();
+
+        const std::vector<float> signal(samples.getReadPointer(0), samples.getReadPointer(0) + samples.getNumSamples());
+        const auto atHostRate = hostRateExtractor.extractFeatures(signal, sampleRate);
+
+        for (int index = 0; index < FeaturePipeline::FEATURE_VECTOR_SIZE; ++index)
+        {
+            const double want = expectedAtFileRate[static_cast<size_t>(index)];
+            const double got = index < static_cast<int>(atHostRate.size()) ? atHostRate[static_cast<size_t>(index)] : 0.0;
+            if (!withinTolerance(index, got, want))
+            {
+                std::cout << "FAIL " << name << " " << (*featureNames)[index].toString() << " at a "
+                          << HOST_SAMPLE_RATE << " Hz host rate: expected " << want << ", got " << got << std::endl;
+                ++failures;
+            }
+        }
+
+        native->setProperty(entry.name, nativeValues);
+    }
+
+    if (nativeFile != juce::File())
+        nativeFile.replaceWithText(juce::JSON::toString(juce::var(native.get())));
+
+    if (failures > 0)
+    {
+        std::cout << failures << " values outside tolerance" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All " << vectors->getProperties().size() << " vectors within tolerance" << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * Drives the processor's audio callback with the real-time guard active while parameters move, so any
+ * allocation, lock, logging or file access reachable from processBlock aborts the run
+ *
+ *     VTRRealtimeSafetyTest
+ *
+ * Only built with VTR_REALTIME_SANITIZER=ON. Violations abort unless VTR_RT_GUARD_REPORT_ONLY is set
+ */
+
+#include "../Source/PluginProcessor.h"
+#include <iostream>
+
+#if ! VTR_REALTIME_GUARD
+ #error "VTRRealtimeSafetyTest needs the real-time guard (configure with -DVTR_REALTIME_SANITIZER=ON)"
+#endif
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int BLOCK_SIZE = 512;
+    constexpr int NUM_BLOCKS = 2000;            // about 20 s, long enough for smoothers, crossfades and feature updates
+    constexpr int BLOCKS_PER_PARAMETER_CHANGE = 4;
+    constexpr int SPECTRUM_COLUMNS = 800;
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    VaclisDynamicEQAudioProcessor processor;
+    processor.enableAllBuses(); // sidechain on, so the key-input path runs too
+    processor.setRateAndBufferSizeDetails(SAMPLE_RATE, BLOCK_SIZE);
+    processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+
+    // Every analysis consumer, as if the editor and live VTR extraction were running
+    auto& analyzer = processor.getSpectrumAnalyzer();
+    auto spectrum = analyzer.subscribe(SpectrumAnalyzer::Consumer::Spectrum);
+    auto features = analyzer.subscribe(SpectrumAnalyzer::Consumer::Features);
+    auto meters = analyzer.subscribe(SpectrumAnalyzer::Consumer::Meters);
+
+    SpectrumAnalyzer::ColumnLayout layout;
+    layout.numColumns = SPECTRUM_COLUMNS;
+    spectrum.setColumnLayout(layout);
+
+    const int numChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+    juce::AudioBuffer<float> buffer(numChannels, BLOCK_SIZE);
+    juce::MidiBuffer midi;
+    juce::Random random(1234);
+    const auto& parameters = processor.getParameters();
+
+    for (int block = 0; block < NUM_BLOCKS; ++block)
+    {
+        // Parameter changes arrive from the host between callbacks
+        if (block % BLOCKS_PER_PARAMETER_CHANGE == 0 && !parameters.isEmpty())
+            parameters[random.nextInt(parameters.size())]->setValueNotifyingHost(random.nextFloat());
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* samples = buffer.getWritePointer(channel);
+            for (int i = 0; i < BLOCK_SIZE; ++i)
+                samples[i] = random.nextFloat() * 0.5f - 0.25f;
+        }
+
+        processor.processBlock(buffer, midi);
+    }
+
+    processor.releaseResources();
+
+    std::cout << NUM_BLOCKS << " blocks processed without a real-time violation" << std::endl;
+    return 0;
+}
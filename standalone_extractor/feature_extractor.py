@@ -1,18 +1,36 @@
 #!/usr/bin/env python3
 """
 VTR Feature Extractor - Standalone executable for audio feature extraction
-Communicates with C++ plugin via JSON over stdin/stdout
+Communicates with C++ plugin via a binary protocol over stdin/stdout, with the
+audio passed in a shared-memory segment (see ExternalFeatureExtractor.h)
 """
 
 import sys
-import json
-import base64
 import numpy as np
 import librosa
 import argparse
 import struct
 import time
 
+try:
+    from multiprocessing import shared_memory, resource_tracker
+except ImportError:  # shared memory unavailable - the plugin then sends samples inline
+    shared_memory = None
+
+# Wire format, mirroring RequestHeader/ResponseHeader in ExternalFeatureExtractor.h
+PROTOCOL_MAGIC = 0x58525456  # "VTRX"
+PROTOCOL_VERSION = 2
+COMMAND_EXTRACT = 1
+COMMAND_EXIT = 2
+STATUS_SUCCESS = 0
+STATUS_ERROR = 1
+STATUS_READY = 2
+STATUS_EXIT = 3
+FLAG_SHARED_MEMORY = 1
+
+REQUEST_HEADER = struct.Struct('<IHHIIQ32s')
+RESPONSE_HEADER = struct.Struct('<IHHII')
+
 def extract_features_vector(audio_data, sr=44100):
     """Extract feature vector matching original VTR model"""
     try:
@@ -56,60 +74,122 @@ def extract_features_vector(audio_data, sr=44100):
     except Exception as e:
         return {"status": "error", "message": str(e)}
 
-def send_message(message):
-    """Send JSON message with 4-byte length prefix"""
-    msg_bytes = json.dumps(message).encode('utf-8')
-    length = struct.pack('<I', len(msg_bytes))
-    sys.stdout.buffer.write(length + msg_bytes)
+def send_response(status, features=(), message=""):
+    """Send a response header followed by float32 features and UTF-8 message text"""
+    msg_bytes = message.encode('utf-8')
+    header = RESPONSE_HEADER.pack(PROTOCOL_MAGIC, PROTOCOL_VERSION, status, len(features), len(msg_bytes))
+    payload = np.asarray(features, dtype='<f4').tobytes()
+    sys.stdout.buffer.write(header + payload + msg_bytes)
     sys.stdout.buffer.flush()
 
-def receive_message():
-    """Receive JSON message with 4-byte length prefix"""
-    # Read 4-byte length
-    length_bytes = sys.stdin.buffer.read(4)
-    if len(length_bytes) < 4:
+def receive_exactly(size):
+    """Read size bytes from stdin, None on EOF"""
+    data = sys.stdin.buffer.read(size)
+    if len(data) < size:
         return None
-    
-    length = struct.unpack('<I', length_bytes)[0]
-    
-    # Read message
-    msg_bytes = sys.stdin.buffer.read(length)
-    if len(msg_bytes) < length:
+    return data
+
+def receive_request():
+    """Receive a request header and any inline samples, None on EOF or a protocol mismatch"""
+    header_bytes = receive_exactly(REQUEST_HEADER.size)
+    if header_bytes is None:
         return None
-    
-    return json.loads(msg_bytes.decode('utf-8'))
+
+    magic, version, command, sr, flags, num_samples, shm_name = REQUEST_HEADER.unpack(header_bytes)
+    if magic != PROTOCOL_MAGIC or version != PROTOCOL_VERSION:
+        return None
+
+    # Inline samples are consumed here, whatever the command, so a rejected request cannot leave
+    # them behind to be read as the next header
+    inline_bytes = None
+    if not flags & FLAG_SHARED_MEMORY and num_samples > 0:
+        inline_bytes = receive_exactly(num_samples * 4)
+        if inline_bytes is None:
+            return None
+
+    return {
+        "command": command,
+        "sr": sr,
+        "flags": flags,
+        "num_samples": num_samples,
+        "shm_name": shm_name.split(b'\0', 1)[0].decode('ascii'),
+        "inline_bytes": inline_bytes,
+    }
+
+class SharedAudio:
+    """Attachment to the plugin's shared audio segment, reopened when the plugin replaces it"""
+
+    def __init__(self):
+        self.segment = None
+
+    def read(self, name, num_samples):
+        if shared_memory is None:
+            raise RuntimeError("Shared memory is not supported by this Python")
+
+        if self.segment is None or self.segment.name.lstrip('/') != name:
+            self.close()
+            self.segment = shared_memory.SharedMemory(name=name)
+            # The plugin owns the segment; stop the tracker unlinking it when this process exits
+            try:
+                resource_tracker.unregister(self.segment._name, "shared_memory")
+            except Exception:
+                pass
+
+        if num_samples * 4 > self.segment.size:
+            raise ValueError(f"Shared segment too small for {num_samples} samples")
+
+        # Copied out so the segment can be replaced while librosa still holds the array
+        return np.frombuffer(self.segment.buf, dtype='<f4', count=num_samples).copy()
+
+    def close(self):
+        if self.segment is not None:
+            self.segment.close()
+            self.segment = None
 
 def daemon_mode():
     """Run in daemon mode, processing requests until exit signal"""
+    shared_audio = SharedAudio()
+
     # Send ready signal
-    send_message({"status": "ready", "version": "1.0"})
-    
+    send_response(STATUS_READY)
+
     while True:
         try:
             # Receive request
-            request = receive_message()
+            request = receive_request()
             if request is None:
                 break
-            
+
             # Handle exit command
-            if request.get("command") == "exit":
-                send_message({"status": "exit"})
+            if request["command"] == COMMAND_EXIT:
+                # The plugin may close its end without waiting for the acknowledgement
+                try:
+                    send_response(STATUS_EXIT)
+                except BrokenPipeError:
+                    pass
                 break
-            
-            # Extract features
-            if "audio_data" in request:
-                # Decode base64 audio data
-                audio_bytes = base64.b64decode(request["audio_data"])
-                audio_data = np.frombuffer(audio_bytes, dtype=np.float32)
-                
-                sr = request.get("sr", 44100)
-                result = extract_features_vector(audio_data, sr)
-                send_message(result)
+
+            if request["command"] != COMMAND_EXTRACT:
+                send_response(STATUS_ERROR, message=f"Unknown command {request['command']}")
+                continue
+
+            # Audio is either in the shared segment or follows the header as raw float32
+            num_samples = request["num_samples"]
+            if request["flags"] & FLAG_SHARED_MEMORY:
+                audio_data = shared_audio.read(request["shm_name"], num_samples)
             else:
-                send_message({"status": "error", "message": "No audio_data in request"})
-                
+                audio_data = np.frombuffer(request["inline_bytes"] or b"", dtype='<f4')
+
+            result = extract_features_vector(audio_data, request["sr"] or 44100)
+            if result["status"] == "success":
+                send_response(STATUS_SUCCESS, result["features"])
+            else:
+                send_response(STATUS_ERROR, message=result["message"])
+
         except Exception as e:
-            send_message({"status": "error", "message": str(e)})
+            send_response(STATUS_ERROR, message=str(e))
+
+    shared_audio.close()
 
 def test_mode():
     """Test mode with synthetic audio"""
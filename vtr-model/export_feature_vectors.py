@@ -0,0 +1,129 @@
+"""
+Golden feature vectors for the plugin's native (librosa-compatible) feature extractor.
+
+    python export_feature_vectors.py                    # writes exported_model/feature_vectors/
+    python export_feature_vectors.py --check native.json
+
+The first form renders a set of deterministic test signals to 32-bit WAV files and stores the
+features extract_features.py computes for them. The second compares features produced by the
+plugin for the same WAV files ({"name": [17 floats], ...}) and exits non-zero when any value is
+outside the tolerance below. Tests/FeatureParityTest.cpp applies the same check in C++ (ctest
+runs it) and writes native.json with --write.
+"""
+import argparse
+import json
+import os
+import sys
+
+import librosa
+import numpy as np
+import soundfile as sf
+
+# === Settings ===
+sr = 44100
+default_output_dir = "exported_model/feature_vectors"
+
+feature_names = ["spectral_centroid", "spectral_bandwidth", "spectral_rolloff"] + \
+                [f"mfcc_{i+1}" for i in range(13)] + ["rms_energy"]
+
+# Tolerance the native extractor is held to (see Source/VTR/FeaturePipeline.h and Tests/FeatureParityTest.cpp)
+relative_tolerance = 1e-3   # spectral centroid/bandwidth/rolloff and RMS
+mfcc_absolute_tolerance = 0.05
+
+
+def extract_features(y):
+    # Same calls as extract_features.py, in training order
+    features = [
+        np.mean(librosa.feature.spectral_centroid(y=y, sr=sr)),
+        np.mean(librosa.feature.spectral_bandwidth(y=y, sr=sr)),
+        np.mean(librosa.feature.spectral_rolloff(y=y, sr=sr)),
+    ]
+    mfccs = librosa.feature.mfcc(y=y, sr=sr, n_mfcc=13)
+    features += [np.mean(mfccs[i]) for i in range(mfccs.shape[0])]
+    features.append(np.mean(librosa.feature.rms(y=y)))
+    return [float(v) for v in features]
+
+
+def test_signals():
+    rng = np.random.default_rng(2024)
+    t = np.arange(2 * sr) / sr
+    signals = {
+        "sine_440": 0.5 * np.sin(2 * np.pi * 440 * t),
+        "two_tone": 0.3 * np.sin(2 * np.pi * 120 * t) + 0.2 * np.sin(2 * np.pi * 5000 * t),
+        "chirp": 0.4 * np.sin(2 * np.pi * (50 * t + (8000 - 50) / 4 * t ** 2)),
+        "white_noise": 0.25 * rng.standard_normal(len(t)),
+        "pink_noise": pink_noise(rng, len(t)),
+        # Long silence around a quiet tone exercises power_to_db's top_db floor
+        "gated_tone": np.where((t > 0.5) & (t < 1.0), 0.01 * np.sin(2 * np.pi * 1000 * t), 0.0),
+        # Shorter than the padding, so centred framing reflects more than once
+        "short_click": np.concatenate([[1.0], np.zeros(699)]),
+    }
+    return {name: y.astype(np.float32) for name, y in signals.items()}
+
+
+def pink_noise(rng, length):
+    spectrum = np.fft.rfft(rng.standard_normal(length))
+    spectrum /= np.sqrt(np.maximum(np.arange(len(spectrum)), 1))
+    y = np.fft.irfft(spectrum, length)
+    return 0.25 * y / np.max(np.abs(y))
+
+
+def export(output_dir):
+    golden_file = os.path.join(output_dir, "golden.json")
+    os.makedirs(output_dir, exist_ok=True)
+    golden = {
+        "librosa_version": librosa.__version__,
+        "sample_rate": sr,
+        "feature_names": feature_names,
+        "vectors": {},
+    }
+    for name, y in test_signals().items():
+        sf.write(os.path.join(output_dir, f"{name}.wav"), y, sr, subtype="FLOAT")
+        golden["vectors"][name] = extract_features(y)
+
+    with open(golden_file, "w") as f:
+        json.dump(golden, f, indent=2)
+
+    print(f"✅ {len(golden['vectors'])} golden vectors saved to {golden_file} (librosa {librosa.__version__})")
+    print("   librosa < 0.10 pads centred frames with reflect, later versions with zeros - "
+          "FeaturePipeline::Settings::padMode has to match")
+
+
+def check(output_dir, native_file):
+    with open(os.path.join(output_dir, "golden.json")) as f:
+        golden = json.load(f)["vectors"]
+    with open(native_file) as f:
+        native = json.load(f)
+
+    failures = 0
+    for name, expected in golden.items():
+        if name not in native:
+            print(f"❌ {name}: missing from {native_file}")
+            failures += 1
+            continue
+
+        for index, (want, got) in enumerate(zip(expected, native[name])):
+            is_mfcc = feature_names[index].startswith("mfcc")
+            error = abs(got - want) if is_mfcc else abs(got - want) / max(abs(want), 1e-9)
+            limit = mfcc_absolute_tolerance if is_mfcc else relative_tolerance
+            if error > limit:
+                print(f"❌ {name} {feature_names[index]}: expected {want:.6f}, got {got:.6f}")
+                failures += 1
+
+    if failures:
+        print(f"{failures} values outside tolerance")
+        return 1
+
+    print(f"✅ All {len(golden)} vectors within tolerance")
+    return 0
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--check", metavar="NATIVE_JSON", help="compare native features against the golden vectors")
+    parser.add_argument("--output-dir", default=default_output_dir, help="where the WAV files and golden.json live")
+    args = parser.parse_args()
+
+    if args.check:
+        sys.exit(check(args.output_dir, args.check))
+    export(args.output_dir)